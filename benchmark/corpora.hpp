@@ -0,0 +1,183 @@
+#pragma once
+
+#include <telnetpp/core.hpp>
+#include <telnetpp/options/msdp/variable.hpp>
+
+#include <random>
+#include <string>
+
+namespace telnetpp_benchmarks {
+
+//* =========================================================================
+/// \brief The size of the corpora used by most benchmarks.
+//* =========================================================================
+inline constexpr std::size_t corpus_size = 64 * 1024;
+
+//* =========================================================================
+/// \brief Returns approximately the given number of bytes of printable
+/// text, broken into lines, with no Telnet sequences.
+//* =========================================================================
+inline telnetpp::byte_storage plain_text_corpus(std::size_t size)
+{
+    static constexpr char const text[] =
+        "The quick brown fox jumps over the lazy dog.  A dark corridor "
+        "stretches away to the north, and a faint breeze blows from the "
+        "south.\r\n";
+
+    telnetpp::byte_storage result;
+    result.reserve(size);
+
+    while (result.size() < size)
+    {
+        result.append(std::begin(text), std::end(text) - 1);
+    }
+
+    result.resize(size);
+    return result;
+}
+
+//* =========================================================================
+/// \brief Returns approximately the given number of bytes of binary data
+/// in which roughly one byte in eight is an escaped IAC IAC.
+//* =========================================================================
+inline telnetpp::byte_storage iac_dense_corpus(std::size_t size)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> distribution{0, 255};
+
+    telnetpp::byte_storage result;
+    result.reserve(size);
+
+    while (result.size() < size)
+    {
+        if (distribution(generator) < 32)
+        {
+            result.append({telnetpp::iac, telnetpp::iac});
+        }
+        else
+        {
+            result.push_back(
+                static_cast<telnetpp::byte>(distribution(generator) % 255));
+        }
+    }
+
+    return result;
+}
+
+//* =========================================================================
+/// \brief Returns approximately the given number of bytes of option
+/// negotiations and commands, such as might be received when a client
+/// connects and negotiates every option it knows.
+//* =========================================================================
+inline telnetpp::byte_storage negotiation_corpus(std::size_t size)
+{
+    static constexpr telnetpp::byte const requests[] = {
+        telnetpp::will, telnetpp::wont, telnetpp::do_, telnetpp::dont};
+
+    telnetpp::byte_storage result;
+    result.reserve(size + 3);
+
+    for (telnetpp::byte index = 0; result.size() < size; ++index)
+    {
+        result.append(
+            {telnetpp::iac, requests[index % std::size(requests)], index});
+
+        if (index % 16 == 0)
+        {
+            result.append({telnetpp::iac, telnetpp::nop});
+        }
+    }
+
+    return result;
+}
+
+//* =========================================================================
+/// \brief Returns a single subnegotiation for the given option whose content
+/// is approximately the given number of bytes, in the form of an MSDP table.
+//* =========================================================================
+inline telnetpp::byte_storage subnegotiation_corpus(
+    telnetpp::option_type option, std::size_t content_size)
+{
+    using namespace telnetpp::literals;  // NOLINT
+
+    telnetpp::byte_storage result = {telnetpp::iac, telnetpp::sb, option};
+    result.reserve(content_size + 32);
+
+    // VAR "ROOM" VAL TABLE_OPEN ... TABLE_CLOSE
+    result.append("\x01ROOM\x02\x03"_tb);
+
+    for (int index = 0; result.size() < content_size; ++index)
+    {
+        result.append("\x01NAME\x02"_tb);
+        result.append("A dark corridor"_tb);
+        result.append("\x01VNUM\x02"_tb);
+        auto const vnum = std::to_string(index);
+        result.append(vnum.begin(), vnum.end());
+    }
+
+    result.append({0x04, telnetpp::iac, telnetpp::se});
+    return result;
+}
+
+//* =========================================================================
+/// \brief Returns approximately the given number of bytes of small MSDP
+/// subnegotiations interleaved with plain text.
+//* =========================================================================
+inline telnetpp::byte_storage msdp_stream_corpus(std::size_t size)
+{
+    using namespace telnetpp::literals;  // NOLINT
+
+    static auto const update =
+        "\xFF\xFA\x45\x01HEALTH\x02" "100\x01MANA\x02" "87\xFF\xF0"_tb;
+    static auto const text = "You hit the goblin.\r\n"_tb;
+
+    telnetpp::byte_storage result;
+    result.reserve(size + update.size() + text.size());
+
+    while (result.size() < size)
+    {
+        result += update;
+        result += text;
+    }
+
+    return result;
+}
+
+//* =========================================================================
+/// \brief Returns an MSDP variable describing a room with the given number
+/// of exits, as a server might send whenever a player moves.
+//* =========================================================================
+inline telnetpp::options::msdp::variable msdp_room_variable(std::size_t exits)
+{
+    using namespace telnetpp::literals;  // NOLINT
+    namespace msdp = telnetpp::options::msdp;
+
+    static constexpr char const *directions[] = {
+        "n", "ne", "e", "se", "s", "sw", "w", "nw", "u", "d"};
+
+    msdp::table_value exit_table;
+
+    for (std::size_t index = 0; index < exits; ++index)
+    {
+        auto const direction = std::string{
+            directions[index % std::size(directions)]}
+                             + std::to_string(index);
+        auto const vnum = std::to_string(1000 + index);
+
+        exit_table.emplace_back(
+            telnetpp::byte_storage{direction.begin(), direction.end()},
+            msdp::string_value{vnum.begin(), vnum.end()});
+    }
+
+    return msdp::variable{
+        "ROOM"_tb,
+        msdp::table_value{
+            {"VNUM"_tb, "6008"_tb},
+            {"NAME"_tb, "The Forest Clearing"_tb},
+            {"AREA"_tb, "Haon Dor"_tb},
+            {"TERRAIN"_tb,
+             msdp::array_value{"forest"_tb, "outdoors"_tb, "lit"_tb}},
+            {"EXITS"_tb, std::move(exit_table)}}};
+}
+
+}  // namespace telnetpp_benchmarks
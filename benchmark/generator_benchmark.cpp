@@ -0,0 +1,103 @@
+#include "corpora.hpp"
+
+#include <benchmark/benchmark.h>
+#include <telnetpp/generator.hpp>
+
+namespace {
+
+using namespace telnetpp_benchmarks;  // NOLINT
+
+void generate_elements(
+    benchmark::State &state,
+    std::vector<telnetpp::element> const &elements,
+    std::size_t bytes_per_iteration)
+{
+    std::size_t bytes_generated = 0;
+
+    for (auto _ : state)
+    {
+        for (auto const &elem : elements)
+        {
+            telnetpp::generate(elem, [&bytes_generated](telnetpp::bytes data) {
+                benchmark::DoNotOptimize(data.data());
+                bytes_generated += data.size();
+            });
+        }
+    }
+
+    benchmark::DoNotOptimize(bytes_generated);
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * bytes_per_iteration));
+}
+
+void generate_plain_text(benchmark::State &state)
+{
+    auto const corpus = plain_text_corpus(corpus_size);
+    generate_elements(state, {telnetpp::bytes{corpus}}, corpus.size());
+}
+
+void generate_iac_dense_text(benchmark::State &state)
+{
+    auto const corpus = iac_dense_corpus(corpus_size);
+    generate_elements(state, {telnetpp::bytes{corpus}}, corpus.size());
+}
+
+void generate_negotiations(benchmark::State &state)
+{
+    static constexpr telnetpp::negotiation_type requests[] = {
+        telnetpp::will, telnetpp::wont, telnetpp::do_, telnetpp::dont};
+
+    std::vector<telnetpp::element> elements;
+
+    for (std::size_t index = 0; index < corpus_size / 3; ++index)
+    {
+        elements.emplace_back(telnetpp::negotiation{
+            requests[index % std::size(requests)],
+            static_cast<telnetpp::option_type>(index)});
+    }
+
+    generate_elements(state, elements, elements.size() * 3);
+}
+
+void generate_large_subnegotiation(benchmark::State &state)
+{
+    auto const corpus = subnegotiation_corpus(69, corpus_size);
+
+    // Strip the IAC SB <option> and IAC SE that surround the content.
+    auto const content =
+        telnetpp::bytes{corpus}.subspan(3, corpus.size() - 5);
+
+    generate_elements(
+        state, {telnetpp::subnegotiation{69, content}}, corpus.size());
+}
+
+void generate_negotiation_batch_into_segments(benchmark::State &state)
+{
+    std::vector<telnetpp::element> const elements = {
+        telnetpp::negotiation{telnetpp::will, 1},
+        telnetpp::negotiation{telnetpp::will, 3},
+        telnetpp::negotiation{telnetpp::do_, 24},
+        telnetpp::negotiation{telnetpp::do_, 31},
+        telnetpp::negotiation{telnetpp::will, 69},
+        telnetpp::negotiation{telnetpp::will, 86}};
+
+    telnetpp::output_segments segments;
+
+    for (auto _ : state)
+    {
+        segments.clear();
+        telnetpp::generate(elements, segments);
+        benchmark::DoNotOptimize(segments.segments().data());
+    }
+
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(state.iterations() * elements.size()));
+}
+
+}  // namespace
+
+BENCHMARK(generate_plain_text);
+BENCHMARK(generate_iac_dense_text);
+BENCHMARK(generate_negotiations);
+BENCHMARK(generate_large_subnegotiation);
+BENCHMARK(generate_negotiation_batch_into_segments);
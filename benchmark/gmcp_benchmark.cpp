@@ -0,0 +1,143 @@
+#include "null_channel.hpp"
+
+#include <benchmark/benchmark.h>
+#include <telnetpp/options/gmcp/server.hpp>
+#include <telnetpp/session.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace telnetpp_benchmarks;  // NOLINT
+namespace gmcp = telnetpp::options::gmcp;
+
+// A session with an active GMCP server.
+class gmcp_session
+{
+public:
+    gmcp_session()
+    {
+        session_.install(server_);
+
+        static constexpr telnetpp::byte const activation[] = {
+            telnetpp::iac, telnetpp::do_, 201,  // DO GMCP
+        };
+
+        channel_.receive(activation);
+    }
+
+    void receive(telnetpp::bytes data)
+    {
+        session_.async_read([](telnetpp::bytes) {});
+        channel_.receive(data);
+    }
+
+    gmcp::server &server()
+    {
+        return server_;
+    }
+
+    [[nodiscard]] std::size_t bytes_written() const
+    {
+        return channel_.bytes_written_;
+    }
+
+private:
+    null_channel channel_;
+    telnetpp::session session_{channel_};
+    gmcp::server server_{session_};
+};
+
+// A JSON payload of roughly the given size, as a game would have encoded
+// it before sending.
+std::string json_payload(std::size_t size)
+{
+    std::string result = "{\"items\":[";
+
+    for (int index = 0; result.size() < size; ++index)
+    {
+        result += R"({"id":)" + std::to_string(index)
+                + R"(,"name":"a rusty sword"},)";
+    }
+
+    result.back() = ']';
+    result += '}';
+    return result;
+}
+
+void gmcp_send(benchmark::State &state)
+{
+    gmcp_session session;
+    auto const payload = json_payload(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        session.server().send("Char.Items.List", payload);
+    }
+
+    benchmark::DoNotOptimize(session.bytes_written());
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * payload.size()));
+}
+
+// Receives a message for one of a typical set of packages, each of which
+// has a handler of its own.
+void gmcp_receive(benchmark::State &state)
+{
+    static char const *const packages[] = {
+        "Core.Hello",
+        "Core.Supports.Set",
+        "Core.Supports.Add",
+        "Core.Supports.Remove",
+        "Core.KeepAlive",
+        "Core.Ping",
+        "Char.Login",
+        "Char.Vitals",
+        "Char.Stats",
+        "Char.StatusVars",
+        "Char.Status",
+        "Char.Items.Inv",
+        "Char.Items.Contents",
+        "Char.Items.Add",
+        "Char.Items.Remove",
+        "Char.Items.Update",
+        "Char.Skills.Get",
+        "Comm.Channel.Text",
+        "Comm.Channel.List",
+        "Room.Info",
+        "Room.Players",
+        "Room.AddPlayer",
+        "Room.RemovePlayer",
+        "External.Discord.Get",
+    };
+
+    gmcp_session session;
+    std::size_t handled = 0;
+
+    for (auto const *package : packages)
+    {
+        session.server().set_handler(
+            package, [&handled](gmcp::message_view const &msg) {
+                handled += msg.payload_.size();
+            });
+    }
+
+    std::string const message = R"(Char.Vitals {"hp":"100","maxhp":"120"})";
+    telnetpp::byte_storage frame = {telnetpp::iac, telnetpp::sb, 201};
+    frame.append(message.begin(), message.end());
+    frame += {telnetpp::iac, telnetpp::se};
+
+    for (auto _ : state)
+    {
+        session.receive(frame);
+    }
+
+    benchmark::DoNotOptimize(handled);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+}  // namespace
+
+BENCHMARK(gmcp_send)->Arg(64)->Arg(4096);
+BENCHMARK(gmcp_receive);
@@ -0,0 +1,210 @@
+#include "corpora.hpp"
+#include "null_channel.hpp"
+
+#include <benchmark/benchmark.h>
+#include <telnetpp/options/mccp/zlib/compressor.hpp>
+#include <telnetpp/options/mccp/zlib/decompressor.hpp>
+#include <telnetpp/options/mccp/zlib/stream_pool.hpp>
+#include <telnetpp/session.hpp>
+
+#include <algorithm>
+
+namespace {
+
+using namespace telnetpp_benchmarks;  // NOLINT
+namespace zlib = telnetpp::options::mccp::zlib;
+
+// Servers usually write output in small pieces, each of which is flushed
+// through the compression stream individually.
+void compress_in_chunks(
+    telnetpp::options::mccp::codec &compressor,
+    telnetpp::bytes data,
+    std::size_t chunk_size,
+    telnetpp::options::mccp::codec::continuation const &cont)
+{
+    while (!data.empty())
+    {
+        auto const chunk = data.first(std::min(chunk_size, data.size()));
+        compressor(chunk, cont);
+        data = data.subspan(chunk.size());
+    }
+}
+
+void mccp_compress(benchmark::State &state, telnetpp::byte_storage corpus)
+{
+    auto const chunk_size = static_cast<std::size_t>(state.range(0));
+    zlib::compressor compressor;
+    std::size_t bytes_compressed = 0;
+
+    auto const cont = [&bytes_compressed](telnetpp::bytes data, bool) {
+        bytes_compressed += data.size();
+    };
+
+    compressor.start();
+
+    for (auto _ : state)
+    {
+        compress_in_chunks(compressor, corpus, chunk_size, cont);
+    }
+
+    compressor.finish(cont);
+
+    benchmark::DoNotOptimize(bytes_compressed);
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * corpus.size()));
+}
+
+void mccp_compress_plain_text(benchmark::State &state)
+{
+    mccp_compress(state, plain_text_corpus(corpus_size));
+}
+
+void mccp_compress_iac_dense_text(benchmark::State &state)
+{
+    mccp_compress(state, iac_dense_corpus(corpus_size));
+}
+
+void mccp_decompress(benchmark::State &state, telnetpp::byte_storage corpus)
+{
+    auto const chunk_size = static_cast<std::size_t>(state.range(0));
+
+    telnetpp::byte_storage compressed;
+    zlib::compressor compressor;
+    auto const append = [&compressed](telnetpp::bytes data, bool) {
+        compressed.append(data.begin(), data.end());
+    };
+
+    compressor.start();
+    compress_in_chunks(compressor, corpus, chunk_size, append);
+    compressor.finish(append);
+
+    zlib::decompressor decompressor;
+    std::size_t bytes_decompressed = 0;
+
+    for (auto _ : state)
+    {
+        decompressor.start();
+        decompressor(
+            compressed, [&bytes_decompressed](telnetpp::bytes data, bool) {
+                bytes_decompressed += data.size();
+            });
+    }
+
+    benchmark::DoNotOptimize(bytes_decompressed);
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * corpus.size()));
+}
+
+void mccp_decompress_plain_text(benchmark::State &state)
+{
+    mccp_decompress(state, plain_text_corpus(corpus_size));
+}
+
+void mccp_decompress_iac_dense_text(benchmark::State &state)
+{
+    mccp_decompress(state, iac_dense_corpus(corpus_size));
+}
+
+// Before compression has started, a decompressor passes all of its input
+// through to the session, which must be given the chance to start
+// compression at the end of any subnegotiation.
+void mccp_passthrough(benchmark::State &state, telnetpp::byte_storage corpus)
+{
+    null_channel channel;
+    telnetpp::session session{channel};
+    zlib::decompressor decompressor;
+    std::size_t bytes_received = 0;
+
+    for (auto _ : state)
+    {
+        decompressor(corpus, [&](telnetpp::bytes data, bool) {
+            session.async_read([&bytes_received](telnetpp::bytes content) {
+                bytes_received += content.size();
+            });
+            channel.receive(data);
+        });
+    }
+
+    benchmark::DoNotOptimize(bytes_received);
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * corpus.size()));
+}
+
+void mccp_passthrough_plain_text(benchmark::State &state)
+{
+    mccp_passthrough(state, plain_text_corpus(corpus_size));
+}
+
+void mccp_passthrough_msdp_stream(benchmark::State &state)
+{
+    mccp_passthrough(state, msdp_stream_corpus(corpus_size));
+}
+
+// Clients that toggle compression, or reconnect in numbers, cause a stream
+// to be created for only a short burst of output.  With an argument of 1,
+// the streams are borrowed from a pool.
+void mccp_compression_churn(benchmark::State &state)
+{
+    auto const corpus = plain_text_corpus(256);
+    zlib::compression_stream_pool pool{1};
+    auto compressor = state.range(0) == 0 ? zlib::compressor{}
+                                          : zlib::compressor{pool};
+    std::size_t bytes_compressed = 0;
+
+    auto const cont = [&bytes_compressed](telnetpp::bytes data, bool) {
+        bytes_compressed += data.size();
+    };
+
+    for (auto _ : state)
+    {
+        compressor.start();
+        compressor(corpus, cont);
+        compressor.finish(cont);
+    }
+
+    benchmark::DoNotOptimize(bytes_compressed);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+// Games often write many tiny fragments per tick, ending with a prompt at
+// which the output is flushed.  The argument selects the flush policy.
+void mccp_compress_small_writes(benchmark::State &state)
+{
+    constexpr std::size_t fragment_size = 16;
+    auto const corpus = plain_text_corpus(4096);
+    zlib::compressor compressor;
+    compressor.set_flush_policy(
+        static_cast<zlib::flush_policy>(state.range(0)));
+    std::size_t bytes_compressed = 0;
+
+    auto const cont = [&bytes_compressed](telnetpp::bytes data, bool) {
+        bytes_compressed += data.size();
+    };
+
+    compressor.start();
+
+    for (auto _ : state)
+    {
+        compress_in_chunks(compressor, corpus, fragment_size, cont);
+        compressor.flush(cont);
+    }
+
+    compressor.finish(cont);
+
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * corpus.size()));
+    state.counters["ratio"] = static_cast<double>(bytes_compressed)
+                            / static_cast<double>(
+                                  state.iterations() * corpus.size());
+}
+
+}  // namespace
+
+BENCHMARK(mccp_compress_plain_text)->Arg(256)->Arg(4096);
+BENCHMARK(mccp_compress_iac_dense_text)->Arg(256)->Arg(4096);
+BENCHMARK(mccp_decompress_plain_text)->Arg(256)->Arg(4096);
+BENCHMARK(mccp_decompress_iac_dense_text)->Arg(256)->Arg(4096);
+BENCHMARK(mccp_passthrough_plain_text);
+BENCHMARK(mccp_passthrough_msdp_stream);
+BENCHMARK(mccp_compression_churn)->Arg(0)->Arg(1);
+BENCHMARK(mccp_compress_small_writes)->Arg(0)->Arg(1)->Arg(2);
@@ -0,0 +1,97 @@
+#include "corpora.hpp"
+
+#include <benchmark/benchmark.h>
+#include <telnetpp/options/mccp/zstd/compressor.hpp>
+#include <telnetpp/options/mccp/zstd/decompressor.hpp>
+
+#include <algorithm>
+
+namespace {
+
+using namespace telnetpp_benchmarks;  // NOLINT
+namespace zstd = telnetpp::options::mccp::zstd;
+
+// As with the zlib benchmarks, output is written in small pieces, each of
+// which is flushed individually, so that the results can be compared.
+void compress_in_chunks(
+    telnetpp::options::mccp::codec &compressor,
+    telnetpp::bytes data,
+    std::size_t chunk_size,
+    telnetpp::options::mccp::codec::continuation const &cont)
+{
+    while (!data.empty())
+    {
+        auto const chunk = data.first(std::min(chunk_size, data.size()));
+        compressor(chunk, cont);
+        data = data.subspan(chunk.size());
+    }
+}
+
+void mccp_zstd_compress_plain_text(benchmark::State &state)
+{
+    auto const chunk_size = static_cast<std::size_t>(state.range(0));
+    auto const corpus = plain_text_corpus(corpus_size);
+    zstd::compressor compressor{static_cast<int>(state.range(1))};
+    std::size_t bytes_compressed = 0;
+
+    auto const cont = [&bytes_compressed](telnetpp::bytes data, bool) {
+        bytes_compressed += data.size();
+    };
+
+    compressor.start();
+
+    for (auto _ : state)
+    {
+        compress_in_chunks(compressor, corpus, chunk_size, cont);
+    }
+
+    compressor.finish(cont);
+
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * corpus.size()));
+    state.counters["ratio"] = static_cast<double>(bytes_compressed)
+                            / static_cast<double>(
+                                  state.iterations() * corpus.size());
+}
+
+void mccp_zstd_decompress_plain_text(benchmark::State &state)
+{
+    auto const chunk_size = static_cast<std::size_t>(state.range(0));
+    auto const corpus = plain_text_corpus(corpus_size);
+
+    telnetpp::byte_storage compressed;
+    zstd::compressor compressor{static_cast<int>(state.range(1))};
+    auto const append = [&compressed](telnetpp::bytes data, bool) {
+        compressed.append(data.begin(), data.end());
+    };
+
+    compressor.start();
+    compress_in_chunks(compressor, corpus, chunk_size, append);
+    compressor.finish(append);
+
+    zstd::decompressor decompressor;
+    std::size_t bytes_decompressed = 0;
+
+    for (auto _ : state)
+    {
+        decompressor.start();
+        decompressor(
+            compressed, [&bytes_decompressed](telnetpp::bytes data, bool) {
+                bytes_decompressed += data.size();
+            });
+    }
+
+    benchmark::DoNotOptimize(bytes_decompressed);
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * corpus.size()));
+}
+
+}  // namespace
+
+// Arguments are the size of each write and the compression level.
+BENCHMARK(mccp_zstd_compress_plain_text)
+    ->Args({256, 1})
+    ->Args({256, 3})
+    ->Args({4096, 1})
+    ->Args({4096, 3});
+BENCHMARK(mccp_zstd_decompress_plain_text)->Args({256, 3})->Args({4096, 3});
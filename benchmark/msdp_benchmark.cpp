@@ -0,0 +1,261 @@
+#include "corpora.hpp"
+
+#include <benchmark/benchmark.h>
+#include <telnetpp/options/msdp/detail/decoder.hpp>
+#include <telnetpp/options/msdp/detail/encoder.hpp>
+#include <telnetpp/options/msdp/detail/view_decoder.hpp>
+#include <telnetpp/options/msdp/name_table.hpp>
+
+#include <array>
+#include <string_view>
+
+namespace {
+
+using namespace telnetpp_benchmarks;  // NOLINT
+namespace msdp = telnetpp::options::msdp;
+
+void msdp_encode_room(benchmark::State &state)
+{
+    auto const room =
+        msdp_room_variable(static_cast<std::size_t>(state.range(0)));
+    std::size_t bytes_encoded = 0;
+
+    for (auto _ : state)
+    {
+        msdp::detail::encode(room, [&bytes_encoded](telnetpp::bytes data) {
+            benchmark::DoNotOptimize(data.data());
+            bytes_encoded += data.size();
+        });
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes_encoded));
+}
+
+void msdp_decode_room(benchmark::State &state)
+{
+    telnetpp::byte_storage encoded;
+    msdp::detail::encode_variable(
+        msdp_room_variable(static_cast<std::size_t>(state.range(0))),
+        encoded);
+
+    std::size_t variables = 0;
+
+    for (auto _ : state)
+    {
+        msdp::detail::decode(encoded, [&variables](msdp::variable const &var) {
+            benchmark::DoNotOptimize(var.name_.data());
+            ++variables;
+        });
+    }
+
+    benchmark::DoNotOptimize(variables);
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * encoded.size()));
+}
+
+void msdp_decode_large_table(benchmark::State &state)
+{
+    auto const corpus = subnegotiation_corpus(69, corpus_size);
+
+    // Strip the IAC SB <option> and IAC SE that surround the content.
+    auto const content =
+        telnetpp::bytes{corpus}.subspan(3, corpus.size() - 5);
+
+    std::size_t variables = 0;
+
+    for (auto _ : state)
+    {
+        msdp::detail::decode(content, [&variables](msdp::variable const &var) {
+            benchmark::DoNotOptimize(var.name_.data());
+            ++variables;
+        });
+    }
+
+    benchmark::DoNotOptimize(variables);
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * content.size()));
+}
+
+void msdp_view_decode_room(benchmark::State &state)
+{
+    telnetpp::byte_storage encoded;
+    msdp::detail::encode_variable(
+        msdp_room_variable(static_cast<std::size_t>(state.range(0))),
+        encoded);
+
+    msdp::detail::view_decoder decoder;
+    std::size_t variables = 0;
+    msdp::detail::view_decoder::continuation const count =
+        [&variables](msdp::variable_view const &view) {
+            benchmark::DoNotOptimize(view.name_.data());
+            ++variables;
+        };
+
+    for (auto _ : state)
+    {
+        decoder(encoded, count);
+    }
+
+    benchmark::DoNotOptimize(variables);
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * encoded.size()));
+}
+
+void msdp_view_decode_large_table(benchmark::State &state)
+{
+    auto const corpus = subnegotiation_corpus(69, corpus_size);
+
+    // Strip the IAC SB <option> and IAC SE that surround the content.
+    auto const content =
+        telnetpp::bytes{corpus}.subspan(3, corpus.size() - 5);
+
+    msdp::detail::view_decoder decoder;
+    std::size_t variables = 0;
+    msdp::detail::view_decoder::continuation const count =
+        [&variables](msdp::variable_view const &view) {
+            benchmark::DoNotOptimize(view.name_.data());
+            ++variables;
+        };
+
+    for (auto _ : state)
+    {
+        decoder(content, count);
+    }
+
+    benchmark::DoNotOptimize(variables);
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * content.size()));
+}
+
+// Finds a single value in each variable, as a client that only needs a few
+// fields from a large table would, without building any variable.
+void msdp_event_decode_large_table(benchmark::State &state)
+{
+    auto const corpus = subnegotiation_corpus(69, corpus_size);
+
+    // Strip the IAC SB <option> and IAC SE that surround the content.
+    auto const content =
+        telnetpp::bytes{corpus}.subspan(3, corpus.size() - 5);
+
+    struct first_value_finder : msdp::detail::decode_handler
+    {
+        void on_string_value(telnetpp::bytes value) override
+        {
+            if (value_.empty())
+            {
+                value_ = value;
+            }
+        }
+
+        telnetpp::bytes value_;
+    };
+
+    first_value_finder finder;
+
+    for (auto _ : state)
+    {
+        finder.value_ = {};
+        msdp::detail::decode(content, finder);
+        benchmark::DoNotOptimize(finder.value_.data());
+    }
+
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * content.size()));
+}
+
+// The names of a character's status, as a client might receive them every
+// tick.
+constexpr std::array<std::string_view, 16> status_names = {
+    "HEALTH",
+    "HEALTH_MAX",
+    "MANA",
+    "MANA_MAX",
+    "MOVEMENT",
+    "MOVEMENT_MAX",
+    "EXPERIENCE",
+    "EXPERIENCE_MAX",
+    "EXPERIENCE_TNL",
+    "LEVEL",
+    "MONEY",
+    "OPPONENT_HEALTH",
+    "OPPONENT_HEALTH_MAX",
+    "OPPONENT_LEVEL",
+    "OPPONENT_NAME",
+    "ROOM_NAME"};
+
+constexpr msdp::static_name_table<status_names.size()> status_name_table{
+    status_names};
+
+telnetpp::byte_storage status_content()
+{
+    telnetpp::byte_storage result;
+
+    for (auto const name : status_names)
+    {
+        msdp::detail::encode_variable(
+            {telnetpp::byte_storage{name.begin(), name.end()},
+             telnetpp::byte_storage{'4', '2'}},
+            result);
+    }
+
+    return result;
+}
+
+// Decodes a status update, and finds the position of each variable's name
+// in the list of names either by comparing it with each in turn or from
+// its identifier.
+void msdp_dispatch_status(benchmark::State &state)
+{
+    bool const by_id = state.range(0) != 0;
+    auto const content = status_content();
+
+    msdp::detail::view_decoder decoder;
+
+    if (by_id)
+    {
+        decoder.set_name_table(status_name_table);
+    }
+
+    std::size_t dispatched = 0;
+    msdp::detail::view_decoder::continuation const dispatch =
+        [&](msdp::variable_view const &view) {
+            if (by_id)
+            {
+                dispatched += view.id_;
+                return;
+            }
+
+            for (std::size_t index = 0; index < status_names.size(); ++index)
+            {
+                auto const name = status_names[index];
+
+                if (std::ranges::equal(
+                        view.name_, name, [](auto lhs, auto rhs) {
+                            return lhs == static_cast<telnetpp::byte>(rhs);
+                        }))
+                {
+                    dispatched += index;
+                    return;
+                }
+            }
+        };
+
+    for (auto _ : state)
+    {
+        decoder(content, dispatch);
+    }
+
+    benchmark::DoNotOptimize(dispatched);
+    state.SetItemsProcessed(static_cast<std::int64_t>(
+        state.iterations() * status_names.size()));
+}
+
+}  // namespace
+
+BENCHMARK(msdp_encode_room)->Arg(4)->Arg(64);
+BENCHMARK(msdp_decode_room)->Arg(4)->Arg(64);
+BENCHMARK(msdp_decode_large_table);
+BENCHMARK(msdp_view_decode_room)->Arg(4)->Arg(64);
+BENCHMARK(msdp_view_decode_large_table);
+BENCHMARK(msdp_event_decode_large_table);
+BENCHMARK(msdp_dispatch_status)->Arg(0)->Arg(1);
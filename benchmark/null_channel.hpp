@@ -0,0 +1,65 @@
+#pragma once
+
+#include <telnetpp/core.hpp>
+
+#include <functional>
+#include <utility>
+
+namespace telnetpp_benchmarks {
+
+//* =========================================================================
+/// \brief A channel that discards everything written to it, counting only
+/// the number of bytes, so that sessions can be measured in isolation.
+//* =========================================================================
+struct null_channel
+{
+    //* =================================================================
+    /// \brief Asynchronously read from the channel and call the function
+    /// back when it's available.
+    //* =================================================================
+    void async_read(std::function<void(telnetpp::bytes)> const &callback)
+    {
+        read_callback_ = callback;
+    }
+
+    //* =================================================================
+    /// \brief Write the given data to the channel.
+    //* =================================================================
+    void write(telnetpp::bytes data)
+    {
+        bytes_written_ += data.size();
+    }
+
+    //* =================================================================
+    /// \brief Returns whether the channel is alive.
+    //* =================================================================
+    [[nodiscard]] bool is_alive() const
+    {
+        return true;
+    }
+
+    //* =================================================================
+    /// \brief Closes the channel.
+    //* =================================================================
+    void close()
+    {
+    }
+
+    //* =================================================================
+    /// \brief Fakes receiving the passed data.
+    //* =================================================================
+    void receive(telnetpp::bytes data)
+    {
+        auto const callback = std::exchange(read_callback_, {});
+
+        if (callback)
+        {
+            callback(data);
+        }
+    }
+
+    std::function<void(telnetpp::bytes)> read_callback_;
+    std::size_t bytes_written_{0};
+};
+
+}  // namespace telnetpp_benchmarks
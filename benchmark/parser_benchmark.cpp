@@ -0,0 +1,60 @@
+#include "corpora.hpp"
+
+#include <benchmark/benchmark.h>
+#include <telnetpp/element.hpp>
+#include <telnetpp/parser.hpp>
+
+namespace {
+
+using namespace telnetpp_benchmarks;  // NOLINT
+
+void parse_corpus(benchmark::State &state, telnetpp::byte_storage corpus)
+{
+    telnetpp::parser parser;
+    std::size_t elements = 0;
+
+    for (auto _ : state)
+    {
+        parser(corpus, [&elements](telnetpp::element const &elem) {
+            benchmark::DoNotOptimize(elem);
+            ++elements;
+        });
+    }
+
+    benchmark::DoNotOptimize(elements);
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * corpus.size()));
+}
+
+void parse_plain_text(benchmark::State &state)
+{
+    parse_corpus(state, plain_text_corpus(corpus_size));
+}
+
+void parse_iac_dense_text(benchmark::State &state)
+{
+    parse_corpus(state, iac_dense_corpus(corpus_size));
+}
+
+void parse_negotiations(benchmark::State &state)
+{
+    parse_corpus(state, negotiation_corpus(corpus_size));
+}
+
+void parse_msdp_stream(benchmark::State &state)
+{
+    parse_corpus(state, msdp_stream_corpus(corpus_size));
+}
+
+void parse_large_subnegotiation(benchmark::State &state)
+{
+    parse_corpus(state, subnegotiation_corpus(69, corpus_size));
+}
+
+}  // namespace
+
+BENCHMARK(parse_plain_text);
+BENCHMARK(parse_iac_dense_text);
+BENCHMARK(parse_negotiations);
+BENCHMARK(parse_msdp_stream);
+BENCHMARK(parse_large_subnegotiation);
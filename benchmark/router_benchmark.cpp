@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+#include <telnetpp/detail/command_router.hpp>
+#include <telnetpp/detail/negotiation_router.hpp>
+#include <telnetpp/detail/subnegotiation_router.hpp>
+
+#include <vector>
+
+namespace {
+
+// The options that a typical MUD server might support, and therefore
+// register routes for.
+constexpr telnetpp::option_type registered_options[] = {
+    0, 1, 3, 24, 31, 39, 42, 69, 70, 85, 86, 91, 93, 201};
+
+// A spread of options, around a third of which have no registered route.
+std::vector<telnetpp::option_type> received_options()
+{
+    std::vector<telnetpp::option_type> result;
+
+    for (int index = 0; index < 1024; ++index)
+    {
+        result.push_back(
+            index % 3 == 0 ? static_cast<telnetpp::option_type>(index % 256)
+                           : registered_options
+                               [static_cast<std::size_t>(index)
+                                % std::size(registered_options)]);
+    }
+
+    return result;
+}
+
+void route_negotiations(benchmark::State &state)
+{
+    static constexpr telnetpp::negotiation_type requests[] = {
+        telnetpp::will, telnetpp::wont, telnetpp::do_, telnetpp::dont};
+
+    telnetpp::detail::negotiation_router router;
+    std::size_t routed = 0;
+
+    for (auto const option : registered_options)
+    {
+        for (auto const request : requests)
+        {
+            router.register_route(
+                telnetpp::negotiation{request, option},
+                [&routed](telnetpp::negotiation const &) { ++routed; });
+        }
+    }
+
+    router.set_unregistered_route(
+        [&routed](telnetpp::negotiation const &) { ++routed; });
+
+    std::vector<telnetpp::negotiation> negotiations;
+
+    for (auto const option : received_options())
+    {
+        negotiations.emplace_back(
+            requests[negotiations.size() % std::size(requests)], option);
+    }
+
+    for (auto _ : state)
+    {
+        for (auto const &neg : negotiations)
+        {
+            router(neg);
+        }
+    }
+
+    benchmark::DoNotOptimize(routed);
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(state.iterations() * negotiations.size()));
+}
+
+void route_subnegotiations(benchmark::State &state)
+{
+    telnetpp::detail::subnegotiation_router router;
+    std::size_t routed = 0;
+
+    for (auto const option : registered_options)
+    {
+        router.register_route(
+            option, [&routed](telnetpp::subnegotiation const &) { ++routed; });
+    }
+
+    router.set_unregistered_route(
+        [&routed](telnetpp::subnegotiation const &) { ++routed; });
+
+    std::vector<telnetpp::subnegotiation> subnegotiations;
+
+    for (auto const option : received_options())
+    {
+        subnegotiations.emplace_back(option, telnetpp::bytes{});
+    }
+
+    for (auto _ : state)
+    {
+        for (auto const &sub : subnegotiations)
+        {
+            router(sub);
+        }
+    }
+
+    benchmark::DoNotOptimize(routed);
+    state.SetItemsProcessed(static_cast<std::int64_t>(
+        state.iterations() * subnegotiations.size()));
+}
+
+void route_commands(benchmark::State &state)
+{
+    static constexpr telnetpp::command_type commands[] = {
+        telnetpp::nop, telnetpp::ayt, telnetpp::ga, telnetpp::brk};
+
+    telnetpp::detail::command_router router;
+    std::size_t routed = 0;
+
+    router.register_route(
+        telnetpp::ayt, [&routed](telnetpp::command const &) { ++routed; });
+    router.register_route(
+        telnetpp::nop, [&routed](telnetpp::command const &) { ++routed; });
+
+    std::vector<telnetpp::command> received;
+
+    for (std::size_t index = 0; index < 1024; ++index)
+    {
+        received.emplace_back(commands[index % std::size(commands)]);
+    }
+
+    for (auto _ : state)
+    {
+        for (auto const &cmd : received)
+        {
+            router(cmd);
+        }
+    }
+
+    benchmark::DoNotOptimize(routed);
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(state.iterations() * received.size()));
+}
+
+}  // namespace
+
+BENCHMARK(route_negotiations);
+BENCHMARK(route_subnegotiations);
+BENCHMARK(route_commands);
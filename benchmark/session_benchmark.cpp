@@ -0,0 +1,270 @@
+#include "corpora.hpp"
+#include "null_channel.hpp"
+
+#include <benchmark/benchmark.h>
+#include <telnetpp/basic_session.hpp>
+#include <telnetpp/options/echo/client.hpp>
+#include <telnetpp/options/msdp/detail/encoder.hpp>
+#include <telnetpp/options/msdp/server.hpp>
+#include <telnetpp/options/naws/client.hpp>
+#include <telnetpp/session.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace telnetpp_benchmarks;  // NOLINT
+using namespace telnetpp::literals;    // NOLINT
+
+// A session with a handful of common options installed and active, so
+// that received data is routed as it would be in a real server.
+template <typename Session = telnetpp::session>
+class active_session
+{
+public:
+    active_session()
+    {
+        session_.install(echo_client_);
+        session_.install(naws_client_);
+        session_.install(msdp_server_);
+
+        static constexpr telnetpp::byte const activation[] = {
+            telnetpp::iac, telnetpp::will, 1,   // WILL ECHO
+            telnetpp::iac, telnetpp::will, 31,  // WILL NAWS
+            telnetpp::iac, telnetpp::do_,  69,  // DO MSDP
+        };
+
+        receive(activation);
+    }
+
+    void receive(telnetpp::bytes data)
+    {
+        session_.async_read([this](telnetpp::bytes content) {
+            bytes_received_ += content.size();
+        });
+
+        channel_.receive(data);
+    }
+
+    Session &session()
+    {
+        return session_;
+    }
+
+    telnetpp::options::msdp::server &msdp_server()
+    {
+        return msdp_server_;
+    }
+
+    [[nodiscard]] std::size_t bytes_written() const
+    {
+        return channel_.bytes_written_;
+    }
+
+private:
+    null_channel channel_;
+    Session session_{channel_};
+    telnetpp::options::echo::client echo_client_{session_};
+    telnetpp::options::naws::client naws_client_{session_};
+    telnetpp::options::msdp::server msdp_server_{session_};
+    std::size_t bytes_received_{0};
+};
+
+template <typename Session>
+void session_read(benchmark::State &state, telnetpp::byte_storage corpus)
+{
+    active_session<Session> session;
+
+    for (auto _ : state)
+    {
+        session.receive(corpus);
+    }
+
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * corpus.size()));
+}
+
+template <typename Session>
+void session_read_plain_text(benchmark::State &state)
+{
+    session_read<Session>(state, plain_text_corpus(corpus_size));
+}
+
+template <typename Session>
+void session_read_iac_dense_text(benchmark::State &state)
+{
+    session_read<Session>(state, iac_dense_corpus(corpus_size));
+}
+
+template <typename Session>
+void session_read_negotiations(benchmark::State &state)
+{
+    session_read<Session>(state, negotiation_corpus(corpus_size));
+}
+
+template <typename Session>
+void session_read_msdp_stream(benchmark::State &state)
+{
+    session_read<Session>(state, msdp_stream_corpus(corpus_size));
+}
+
+template <typename Session>
+void session_read_large_subnegotiation(benchmark::State &state)
+{
+    session_read<Session>(state, subnegotiation_corpus(69, corpus_size));
+}
+
+void session_write(benchmark::State &state, telnetpp::byte_storage corpus)
+{
+    active_session<> session;
+
+    for (auto _ : state)
+    {
+        session.session().write(telnetpp::bytes{corpus});
+    }
+
+    benchmark::DoNotOptimize(session.bytes_written());
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * corpus.size()));
+}
+
+void session_write_plain_text(benchmark::State &state)
+{
+    session_write(state, plain_text_corpus(corpus_size));
+}
+
+void session_write_iac_dense_text(benchmark::State &state)
+{
+    session_write(state, iac_dense_corpus(corpus_size));
+}
+
+void session_write_msdp_variable(benchmark::State &state)
+{
+    active_session<> session;
+    auto const room =
+        msdp_room_variable(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        session.msdp_server().send(room);
+    }
+
+    benchmark::DoNotOptimize(session.bytes_written());
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+void session_write_msdp_status(benchmark::State &state)
+{
+    // A character status of 32 variables, only two of which change each
+    // tick.  It is either sent whole every tick, or reported and flushed.
+    constexpr std::size_t variable_count = 32;
+    constexpr std::size_t changing_count = 2;
+
+    active_session<> session;
+    auto &server = session.msdp_server();
+    bool const reported = state.range(0) != 0;
+
+    std::vector<telnetpp::byte_storage> names;
+    telnetpp::options::msdp::array_value report;
+
+    for (std::size_t index = 0; index < variable_count; ++index)
+    {
+        auto const name = "STAT" + std::to_string(index);
+        names.emplace_back(name.begin(), name.end());
+        report.push_back(names.back());
+        server.set_variable({names.back(), "0"_tb});
+    }
+
+    telnetpp::byte_storage request;
+    telnetpp::options::msdp::detail::encode_variable(
+        {"REPORT"_tb, std::move(report)}, request);
+    server.subnegotiate(request);
+
+    std::size_t tick = 0;
+
+    for (auto _ : state)
+    {
+        ++tick;
+
+        for (std::size_t index = 0; index < variable_count; ++index)
+        {
+            auto const value =
+                std::to_string(index < changing_count ? tick : 0);
+            telnetpp::options::msdp::variable var{
+                names[index],
+                telnetpp::options::msdp::string_value{
+                    value.begin(), value.end()}};
+
+            if (reported)
+            {
+                server.set_variable(std::move(var));
+            }
+            else
+            {
+                server.send(var);
+            }
+        }
+
+        if (reported)
+        {
+            server.flush_updates();
+        }
+    }
+
+    benchmark::DoNotOptimize(session.bytes_written());
+    state.counters["bytes_per_tick"] = benchmark::Counter(
+        static_cast<double>(session.bytes_written()),
+        benchmark::Counter::kAvgIterations);
+}
+
+void session_write_negotiations(benchmark::State &state)
+{
+    active_session<> session;
+    bool const corked = state.range(0) != 0;
+
+    for (auto _ : state)
+    {
+        if (corked)
+        {
+            session.session().cork();
+        }
+
+        for (telnetpp::option_type option = 0; option < 32; ++option)
+        {
+            session.session().write(
+                telnetpp::negotiation{telnetpp::will, option});
+        }
+
+        if (corked)
+        {
+            session.session().uncork();
+        }
+    }
+
+    benchmark::DoNotOptimize(session.bytes_written());
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * 32));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(session_read_plain_text, telnetpp::session);
+BENCHMARK_TEMPLATE(
+    session_read_plain_text, telnetpp::basic_session<null_channel>);
+BENCHMARK_TEMPLATE(session_read_iac_dense_text, telnetpp::session);
+BENCHMARK_TEMPLATE(
+    session_read_iac_dense_text, telnetpp::basic_session<null_channel>);
+BENCHMARK_TEMPLATE(session_read_negotiations, telnetpp::session);
+BENCHMARK_TEMPLATE(
+    session_read_negotiations, telnetpp::basic_session<null_channel>);
+BENCHMARK_TEMPLATE(session_read_msdp_stream, telnetpp::session);
+BENCHMARK_TEMPLATE(
+    session_read_msdp_stream, telnetpp::basic_session<null_channel>);
+BENCHMARK_TEMPLATE(session_read_large_subnegotiation, telnetpp::session);
+BENCHMARK_TEMPLATE(
+    session_read_large_subnegotiation, telnetpp::basic_session<null_channel>);
+BENCHMARK(session_write_plain_text);
+BENCHMARK(session_write_iac_dense_text);
+BENCHMARK(session_write_msdp_variable)->Arg(8)->Arg(256);
+BENCHMARK(session_write_msdp_status)->Arg(0)->Arg(1);
+BENCHMARK(session_write_negotiations)->Arg(0)->Arg(1);
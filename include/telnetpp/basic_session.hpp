@@ -0,0 +1,111 @@
+#pragma once
+
+#include "telnetpp/session.hpp"
+
+#include <utility>
+
+namespace telnetpp {
+
+namespace detail {
+
+//* =========================================================================
+/// \brief Holds a member that must be constructed before the base classes
+/// that are listed after this one.
+//* =========================================================================
+template <typename Member>
+struct base_from_member
+{
+    template <typename... Args>
+    explicit base_from_member(Args &&...args)
+      : member_{std::forward<Args>(args)...}
+    {
+    }
+
+    Member member_;
+};
+
+}  // namespace detail
+
+//* =========================================================================
+/// \brief A Telnet session for a channel whose type is known at compile
+/// time.
+///
+/// This has the same functionality as telnetpp::session, from which it is
+/// derived, and options are installed into it in the same way.  However,
+/// reads and direct queries of the channel are made without any virtual
+/// calls, and async_read accepts any callable without wrapping it in a
+/// std::function.
+///
+/// Reading therefore performs no allocations of its own.  Whether it
+/// allocates at all depends on the channel: if its async_read is a
+/// template, then nothing is allocated, but if it takes a std::function,
+/// as in the example for telnetpp::session, then constructing that
+/// std::function from the callback may allocate on every read.
+///
+/// Writes that are made by installed options are passed to the channel
+/// through a single virtual call.
+///
+/// \code
+/// my_channel channel;
+/// telnetpp::basic_session<my_channel> session{channel};
+///
+/// session.async_read([&](telnetpp::bytes data) {
+///     my_application_receive(data);
+/// });
+/// \endcode
+//* =========================================================================
+template <typename Channel>
+class basic_session final
+  // The channel model is held in a base class that precedes the session,
+  // so that it exists before the session refers to it.
+  : private detail::base_from_member<session::channel_model<Channel>>,
+    public session
+{
+    using channel_model_holder =
+        detail::base_from_member<session::channel_model<Channel>>;
+
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    explicit basic_session(Channel &channel)
+      : channel_model_holder{channel},
+        // The cast selects the protected constructor rather than the one
+        // that would wrap the model in yet another channel model.
+        session{static_cast<session::channel_concept &>(
+            channel_model_holder::member_)},
+        channel_{channel}
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether the session is still alive
+    //* =====================================================================
+    [[nodiscard]] bool is_alive() const
+    {
+        return channel_.is_alive();
+    }
+
+    //* =====================================================================
+    /// \brief Requests data from the underlying channel, acting on any
+    /// Telnet primitives that are received.
+    ///
+    /// As with telnetpp::session::async_read, the callback is always called
+    /// with an empty parameter once the received data has been handled.
+    //* =====================================================================
+    template <typename Callback>
+    void async_read(Callback &&callback)
+    {
+        channel_.async_read(
+            [this, callback = std::forward<Callback>(callback)](
+                telnetpp::bytes content) mutable {
+                receive(content, callback);
+                callback(telnetpp::bytes{});
+            });
+    }
+
+private:
+    Channel &channel_;
+};
+
+}  // namespace telnetpp
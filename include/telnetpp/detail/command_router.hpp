@@ -3,21 +3,33 @@
 #include "telnetpp/command.hpp"
 #include "telnetpp/detail/router.hpp"
 
+#include <functional>
+
 namespace telnetpp::detail {
 
 struct command_router_key_from_message_policy
 {
+    static constexpr std::size_t key_count = 256;
+
     static constexpr command_type key_from_message(command const &cmd)
     {
         return cmd.value();
     }
+
+    static constexpr std::size_t index_from_key(command_type key)
+    {
+        return key;
+    }
 };
 
-class command_router : public router<
-                           command_type,
-                           command,
-                           void(command),
-                           detail::command_router_key_from_message_policy>
+// Command handlers are installed into a session as std::functions, so they
+// are held as they are rather than wrapped again.
+class command_router
+  : public router<
+        command_type,
+        command,
+        std::function<void(command)>,
+        detail::command_router_key_from_message_policy>
 {
 };
 
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <type_traits>
+
+// Vectorized scanning is selected at build time according to the
+// instruction sets that the compiler is targeting.  It may be disabled
+// entirely by defining TELNETPP_DISABLE_SIMD.
+#if !defined(TELNETPP_DISABLE_SIMD)
+#if defined(__AVX2__)
+#define TELNETPP_FIND_IAC_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TELNETPP_FIND_IAC_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define TELNETPP_FIND_IAC_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace telnetpp::detail {
+
+//* =========================================================================
+/// \brief Returns a pointer to the first IAC byte in the range [first, last),
+/// or last if there is no such byte.  This version examines each byte in
+/// turn and is used for the tail of a range and during constant evaluation.
+//* =========================================================================
+constexpr telnetpp::byte const *find_iac_scalar(
+    telnetpp::byte const *first, telnetpp::byte const *last) noexcept
+{
+    return std::find(first, last, telnetpp::iac);
+}
+
+#if defined(TELNETPP_FIND_IAC_AVX2)
+//* =========================================================================
+/// \exclude
+//* =========================================================================
+inline telnetpp::byte const *find_iac_vector(
+    telnetpp::byte const *first, telnetpp::byte const *last) noexcept
+{
+    __m256i const iacs = _mm256_set1_epi8(static_cast<char>(telnetpp::iac));
+
+    while (last - first >= 32)
+    {
+        auto const block =
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(first));
+        auto const mask = static_cast<unsigned int>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, iacs)));
+
+        if (mask != 0)
+        {
+            return first + std::countr_zero(mask);
+        }
+
+        first += 32;
+    }
+
+    return find_iac_scalar(first, last);
+}
+#elif defined(TELNETPP_FIND_IAC_SSE2)
+//* =========================================================================
+/// \exclude
+//* =========================================================================
+inline telnetpp::byte const *find_iac_vector(
+    telnetpp::byte const *first, telnetpp::byte const *last) noexcept
+{
+    __m128i const iacs = _mm_set1_epi8(static_cast<char>(telnetpp::iac));
+
+    while (last - first >= 16)
+    {
+        auto const block =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(first));
+        auto const mask = static_cast<unsigned int>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(block, iacs)));
+
+        if (mask != 0)
+        {
+            return first + std::countr_zero(mask);
+        }
+
+        first += 16;
+    }
+
+    return find_iac_scalar(first, last);
+}
+#elif defined(TELNETPP_FIND_IAC_NEON)
+//* =========================================================================
+/// \exclude
+//* =========================================================================
+inline telnetpp::byte const *find_iac_vector(
+    telnetpp::byte const *first, telnetpp::byte const *last) noexcept
+{
+    uint8x16_t const iacs = vdupq_n_u8(telnetpp::iac);
+
+    while (last - first >= 16)
+    {
+        auto const matches = vceqq_u8(vld1q_u8(first), iacs);
+
+        if (vmaxvq_u8(matches) != 0)
+        {
+            // Narrow each matching byte into a nibble of a 64-bit mask, so
+            // that the position of the first match can be counted.
+            auto const mask = vget_lane_u64(
+                vreinterpret_u64_u8(
+                    vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)),
+                0);
+
+            return first + (std::countr_zero(mask) / 4);
+        }
+
+        first += 16;
+    }
+
+    return find_iac_scalar(first, last);
+}
+#endif
+
+//* =========================================================================
+/// \brief Returns an iterator to the first IAC byte in the range
+/// [first, last), or last if there is no such byte.
+///
+/// Where available, this examines the range in blocks using vector
+/// instructions, so that long runs of plain data can be skipped over in a
+/// single step.
+//* =========================================================================
+constexpr telnetpp::bytes::iterator find_iac(
+    telnetpp::bytes::iterator first, telnetpp::bytes::iterator last) noexcept
+{
+#if defined(TELNETPP_FIND_IAC_AVX2) || defined(TELNETPP_FIND_IAC_SSE2) \
+    || defined(TELNETPP_FIND_IAC_NEON)
+    if (!std::is_constant_evaluated())
+    {
+        auto const *const begin = std::to_address(first);
+        return first
+             + (find_iac_vector(begin, begin + (last - first)) - begin);
+    }
+#endif
+
+    return std::find(first, last, telnetpp::iac);
+}
+
+}  // namespace telnetpp::detail
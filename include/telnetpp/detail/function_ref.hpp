@@ -0,0 +1,53 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace telnetpp::detail {
+
+template <typename Signature>
+class function_ref;
+
+//* =========================================================================
+/// \brief A non-owning reference to a callable object.  Unlike
+/// std::function, this never allocates, but the referenced object must
+/// outlive it.  It is intended to be used only for function parameters.
+//* =========================================================================
+template <typename Result, typename... Args>
+class function_ref<Result(Args...)>
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    template <typename Function>
+        requires(
+            !std::is_same_v<std::remove_cvref_t<Function>, function_ref>
+            && std::is_invocable_r_v<Result, Function &, Args...>)
+    constexpr function_ref(Function &&fn) noexcept  // NOLINT
+      : object_{const_cast<void *>(  // NOLINT
+            static_cast<void const *>(std::addressof(fn)))},
+        invoke_{[](void *object, Args... args) -> Result {
+            return std::invoke(
+                *static_cast<std::remove_reference_t<Function> *>(object),
+                std::forward<Args>(args)...);
+        }}
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Invokes the referenced object.
+    //* =====================================================================
+    constexpr Result operator()(Args... args) const
+    {
+        return invoke_(object_, std::forward<Args>(args)...);
+    }
+
+private:
+    void *object_;
+    Result (*invoke_)(void *, Args...);
+};
+
+}  // namespace telnetpp::detail
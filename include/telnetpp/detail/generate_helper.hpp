@@ -2,8 +2,71 @@
 
 #include "telnetpp/element.hpp"
 
+#include <array>
+
 namespace telnetpp::detail {
 
+// The framing bytes of every command, negotiation and subnegotiation are
+// held in static tables, so that the spans passed to a continuation remain
+// valid after it returns.  This allows output to be gathered up and
+// written later without copying.
+
+//* =========================================================================
+/// \exclude
+//* =========================================================================
+inline constexpr auto command_sequences = [] {
+    std::array<std::array<telnetpp::byte, 2>, 256> result{};
+
+    for (std::size_t index = 0; index < result.size(); ++index)
+    {
+        result[index] = {telnetpp::iac, static_cast<telnetpp::byte>(index)};
+    }
+
+    return result;
+}();
+
+//* =========================================================================
+/// \exclude
+//* =========================================================================
+inline constexpr auto negotiation_sequences = [] {
+    std::array<std::array<std::array<telnetpp::byte, 3>, 256>, 4> result{};
+
+    for (std::size_t request = 0; request < result.size(); ++request)
+    {
+        for (std::size_t option = 0; option < result[request].size();
+             ++option)
+        {
+            result[request][option] = {
+                telnetpp::iac,
+                static_cast<telnetpp::byte>(telnetpp::will + request),
+                static_cast<telnetpp::byte>(option)};
+        }
+    }
+
+    return result;
+}();
+
+//* =========================================================================
+/// \exclude
+//* =========================================================================
+inline constexpr auto subnegotiation_preambles = [] {
+    std::array<std::array<telnetpp::byte, 3>, 256> result{};
+
+    for (std::size_t option = 0; option < result.size(); ++option)
+    {
+        result[option] = {
+            telnetpp::iac, telnetpp::sb, static_cast<telnetpp::byte>(option)};
+    }
+
+    return result;
+}();
+
+//* =========================================================================
+/// \exclude
+//* =========================================================================
+inline constexpr telnetpp::byte const subnegotiation_postamble[] = {
+    telnetpp::iac, telnetpp::se};
+
 //* =========================================================================
 /// \exclude
 //* =========================================================================
@@ -41,9 +104,7 @@ constexpr void generate_escaped(telnetpp::bytes data, Continuation &&cont)
 template <class Continuation>
 constexpr void generate_command(telnetpp::command cmd, Continuation &&cont)
 {
-    telnetpp::byte const data[] = {telnetpp::iac, cmd.value()};
-
-    cont(data);
+    cont(command_sequences[cmd.value()]);
 }
 
 //* =========================================================================
@@ -53,10 +114,8 @@ template <class Continuation>
 constexpr void generate_negotiation(
     telnetpp::negotiation neg, Continuation &&cont)
 {
-    telnetpp::byte const data[] = {
-        telnetpp::iac, neg.request(), neg.option_code()};
-
-    cont(data);
+    cont(negotiation_sequences[neg.request() - telnetpp::will]
+                              [neg.option_code()]);
 }
 
 //* =========================================================================
@@ -66,14 +125,9 @@ template <class Continuation>
 constexpr void generate_subnegotiation(
     telnetpp::subnegotiation sub, Continuation &&cont)
 {
-    telnetpp::byte const preamble[] = {
-        telnetpp::iac, telnetpp::sb, sub.option()};
-
-    constexpr telnetpp::byte const postamble[] = {telnetpp::iac, telnetpp::se};
-
-    cont(preamble);
+    cont(subnegotiation_preambles[sub.option()]);
     generate_escaped(sub.content(), cont);
-    cont(postamble);
+    cont(subnegotiation_postamble);
 }
 
 }  // namespace telnetpp::detail
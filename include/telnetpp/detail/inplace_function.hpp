@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace telnetpp::detail {
+
+template <typename Signature, std::size_t Capacity = 4 * sizeof(void *)>
+class inplace_function;
+
+//* =========================================================================
+/// \brief Returns whether a callable object is one that holds nothing to
+/// call: a null pointer, or an empty std::function.
+//* =========================================================================
+template <typename Function>
+constexpr bool is_null_callable(Function const &fn) noexcept
+{
+    if constexpr (
+        std::is_pointer_v<Function> || std::is_member_pointer_v<Function>)
+    {
+        return fn == nullptr;
+    }
+    else if constexpr (requires { typename Function::result_type; }
+                       && std::is_constructible_v<bool, Function const &>)
+    {
+        return !static_cast<bool>(fn);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+//* =========================================================================
+/// \brief An owning, copyable wrapper for a callable object, similar to
+/// std::function, except that the object is always stored within the
+/// wrapper itself and so it never allocates.
+///
+/// A callable object that does not fit within Capacity bytes is rejected
+/// at compile time.  An empty inplace_function may not be invoked.
+//* =========================================================================
+template <typename Result, typename... Args, std::size_t Capacity>
+class inplace_function<Result(Args...), Capacity>
+{
+public:
+    using result_type = Result;
+
+    static constexpr std::size_t capacity = Capacity;
+
+    //* =====================================================================
+    /// \brief Constructs an empty function.
+    //* =====================================================================
+    constexpr inplace_function() noexcept  // NOLINT
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Constructs a function that holds a copy of the given callable
+    /// object.  As with std::function, a null pointer or an empty
+    /// std::function makes an empty function.
+    //* =====================================================================
+    template <typename Function>
+        requires(
+            !std::is_same_v<std::remove_cvref_t<Function>, inplace_function>
+            && std::is_invocable_r_v<
+                Result,
+                std::remove_cvref_t<Function> &,
+                Args...>)
+    inplace_function(Function &&fn)  // NOLINT
+    {
+        using function_type = std::remove_cvref_t<Function>;
+
+        static_assert(
+            sizeof(function_type) <= Capacity,
+            "callable object is too large for this inplace_function");
+        static_assert(
+            alignof(function_type) <= alignof(std::max_align_t),
+            "callable object is over-aligned for this inplace_function");
+        static_assert(
+            std::is_nothrow_move_constructible_v<function_type>,
+            "callable object must be nothrow move constructible");
+
+        if (is_null_callable(fn))
+        {
+            return;
+        }
+
+        ::new (static_cast<void *>(&storage_))
+            function_type(std::forward<Function>(fn));
+        operations_ = &operations_for<function_type>;
+    }
+
+    //* =====================================================================
+    /// \brief Copy constructor
+    //* =====================================================================
+    inplace_function(inplace_function const &other)
+      : operations_{other.operations_}
+    {
+        if (operations_ != nullptr)
+        {
+            operations_->copy(&storage_, &other.storage_);
+        }
+    }
+
+    //* =====================================================================
+    /// \brief Move constructor
+    //* =====================================================================
+    inplace_function(inplace_function &&other) noexcept
+      : operations_{other.operations_}
+    {
+        if (operations_ != nullptr)
+        {
+            operations_->move(&storage_, &other.storage_);
+            other.reset();
+        }
+    }
+
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    ~inplace_function()
+    {
+        reset();
+    }
+
+    //* =====================================================================
+    /// \brief Copy assignment
+    //* =====================================================================
+    inplace_function &operator=(inplace_function const &other)
+    {
+        if (this != &other)
+        {
+            reset();
+
+            if (other.operations_ != nullptr)
+            {
+                other.operations_->copy(&storage_, &other.storage_);
+                operations_ = other.operations_;
+            }
+        }
+
+        return *this;
+    }
+
+    //* =====================================================================
+    /// \brief Move assignment
+    //* =====================================================================
+    inplace_function &operator=(inplace_function &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+
+            if (other.operations_ != nullptr)
+            {
+                other.operations_->move(&storage_, &other.storage_);
+                operations_ = other.operations_;
+                other.reset();
+            }
+        }
+
+        return *this;
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether this function holds a callable object.
+    //* =====================================================================
+    [[nodiscard]] explicit operator bool() const noexcept
+    {
+        return operations_ != nullptr;
+    }
+
+    //* =====================================================================
+    /// \brief Invokes the held callable object.
+    //* =====================================================================
+    Result operator()(Args... args) const
+    {
+        return operations_->invoke(&storage_, std::forward<Args>(args)...);
+    }
+
+private:
+    struct operations
+    {
+        Result (*invoke)(void *, Args...);
+        void (*copy)(void *, void const *);
+        void (*move)(void *, void *) noexcept;
+        void (*destroy)(void *) noexcept;
+    };
+
+    template <typename Function>
+    static constexpr operations operations_for = {
+        [](void *object, Args... args) -> Result {
+            return std::invoke(
+                *static_cast<Function *>(object), std::forward<Args>(args)...);
+        },
+        [](void *destination, void const *source) {
+            ::new (destination)
+                Function(*static_cast<Function const *>(source));
+        },
+        [](void *destination, void *source) noexcept {
+            ::new (destination)
+                Function(std::move(*static_cast<Function *>(source)));
+        },
+        [](void *object) noexcept {
+            static_cast<Function *>(object)->~Function();
+        }};
+
+    void reset() noexcept
+    {
+        if (operations_ != nullptr)
+        {
+            operations_->destroy(&storage_);
+            operations_ = nullptr;
+        }
+    }
+
+    // The storage is mutable so that, as with std::function, a const
+    // inplace_function can invoke a callable with a non-const call operator.
+    alignas(std::max_align_t) mutable std::byte storage_[Capacity];
+    operations const *operations_{nullptr};
+};
+
+}  // namespace telnetpp::detail
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "telnetpp/detail/inplace_function.hpp"
 #include "telnetpp/detail/router.hpp"
 #include "telnetpp/element.hpp"
 #include "telnetpp/negotiation.hpp"
@@ -8,10 +9,19 @@ namespace telnetpp::detail {
 
 struct negotiation_router_key_from_message_policy
 {
+    // One key for each of WILL, WONT, DO and DONT for every option.
+    static constexpr std::size_t key_count = 4 * 256;
+
     static constexpr negotiation key_from_message(negotiation const &neg)
     {
         return neg;
     }
+
+    static constexpr std::size_t index_from_key(negotiation const &neg)
+    {
+        return (static_cast<std::size_t>(neg.request() - telnetpp::will) << 8U)
+             | neg.option_code();
+    }
 };
 
 //* =========================================================================
@@ -25,7 +35,7 @@ class negotiation_router
   : public router<
         negotiation,
         negotiation,
-        void(telnetpp::negotiation),
+        inplace_function<void(telnetpp::negotiation)>,
         detail::negotiation_router_key_from_message_policy>
 {
 };
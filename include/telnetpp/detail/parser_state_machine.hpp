@@ -0,0 +1,190 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace telnetpp::detail {
+
+//* =========================================================================
+/// \brief The states of the Telnet parser.
+//* =========================================================================
+enum class parsing_state : std::uint8_t
+{
+    idle,
+    iac,
+    negotiation,
+    subnegotiation,
+    subnegotiation_content,
+    subnegotiation_content_iac,
+};
+
+inline constexpr std::size_t parsing_state_count = 6;
+
+//* =========================================================================
+/// \brief The classes of byte that the parser distinguishes between.  All
+/// bytes within a class cause identical transitions in every state.
+//* =========================================================================
+enum class byte_class : std::uint8_t
+{
+    other,
+    negotiation,
+    sb,
+    se,
+    iac,
+};
+
+//* =========================================================================
+/// \brief The actions that the parser can take when it transitions between
+/// states.
+//* =========================================================================
+enum class parser_action : std::uint8_t
+{
+    none,
+    append_plain_data,
+    append_escaped_iac,
+    emit_command,
+    begin_negotiation,
+    emit_negotiation,
+    begin_subnegotiation,
+    set_subnegotiation_option,
+    append_subnegotiation_content,
+    end_subnegotiation,
+};
+
+//* =========================================================================
+/// \brief A transition in the parser's state machine.
+//* =========================================================================
+struct parser_transition
+{
+    parsing_state next_state;
+    parser_action action;
+};
+
+//* =========================================================================
+/// \brief Returns the class of the given byte.
+//* =========================================================================
+constexpr byte_class classify_byte(telnetpp::byte by) noexcept
+{
+    switch (by)
+    {
+        case telnetpp::iac:
+            return byte_class::iac;
+
+        case telnetpp::sb:
+            return byte_class::sb;
+
+        case telnetpp::se:
+            return byte_class::se;
+
+        case telnetpp::will:  // fall-through
+        case telnetpp::wont:  // fall-through
+        case telnetpp::do_:   // fall-through
+        case telnetpp::dont:
+            return byte_class::negotiation;
+
+        default:
+            return byte_class::other;
+    }
+}
+
+//* =========================================================================
+/// \brief Returns the transition that is taken from a given state when a
+/// byte of a given class is received.
+//* =========================================================================
+constexpr parser_transition transition_for(
+    parsing_state state, byte_class cls) noexcept
+{
+    switch (state)
+    {
+        case parsing_state::iac:
+            switch (cls)
+            {
+                case byte_class::iac:
+                    return {parsing_state::idle,
+                            parser_action::append_escaped_iac};
+
+                case byte_class::negotiation:
+                    return {parsing_state::negotiation,
+                            parser_action::begin_negotiation};
+
+                case byte_class::sb:
+                    return {parsing_state::subnegotiation,
+                            parser_action::begin_subnegotiation};
+
+                default:
+                    return {parsing_state::idle, parser_action::emit_command};
+            }
+
+        case parsing_state::negotiation:
+            return {parsing_state::idle, parser_action::emit_negotiation};
+
+        case parsing_state::subnegotiation:
+            return {parsing_state::subnegotiation_content,
+                    parser_action::set_subnegotiation_option};
+
+        case parsing_state::subnegotiation_content:
+            if (cls == byte_class::iac)
+            {
+                return {parsing_state::subnegotiation_content_iac,
+                        parser_action::none};
+            }
+
+            return {parsing_state::subnegotiation_content,
+                    parser_action::append_subnegotiation_content};
+
+        case parsing_state::subnegotiation_content_iac:
+            if (cls == byte_class::se)
+            {
+                return {parsing_state::idle,
+                        parser_action::end_subnegotiation};
+            }
+
+            return {parsing_state::subnegotiation_content,
+                    parser_action::append_subnegotiation_content};
+
+        default:
+            if (cls == byte_class::iac)
+            {
+                return {parsing_state::iac, parser_action::none};
+            }
+
+            return {parsing_state::idle, parser_action::append_plain_data};
+    }
+}
+
+//* =========================================================================
+/// \brief A table of the transitions of the parser's state machine, indexed
+/// by state and then by byte, generated at compile time.  Indexing by the
+/// byte itself rather than by its class saves a lookup for every byte that
+/// is parsed through the table.
+//* =========================================================================
+inline constexpr auto parser_transitions = [] {
+    std::array<std::array<parser_transition, 256>, parsing_state_count>
+        result{};
+
+    for (std::size_t state = 0; state < parsing_state_count; ++state)
+    {
+        for (std::size_t by = 0; by < 256; ++by)
+        {
+            result[state][by] = transition_for(
+                static_cast<parsing_state>(state),
+                classify_byte(static_cast<telnetpp::byte>(by)));
+        }
+    }
+
+    return result;
+}();
+
+//* =========================================================================
+/// \brief Returns the transition that is taken from the given state when
+/// the given byte is received.
+//* =========================================================================
+constexpr parser_transition const &next_transition(
+    parsing_state state, telnetpp::byte by) noexcept
+{
+    return parser_transitions[static_cast<std::size_t>(state)][by];
+}
+
+}  // namespace telnetpp::detail
@@ -2,6 +2,7 @@
 
 #include "telnetpp/client_option.hpp"
 #include "telnetpp/detail/negotiation_router.hpp"
+#include "telnetpp/detail/subnegotiation_event_router.hpp"
 #include "telnetpp/detail/subnegotiation_router.hpp"
 #include "telnetpp/element.hpp"
 #include "telnetpp/server_option.hpp"
@@ -14,7 +15,8 @@ namespace telnetpp::detail {
 void register_client_option(
     telnetpp::client_option &option,
     negotiation_router &neg_router,
-    subnegotiation_router &sub_router);
+    subnegotiation_router &sub_router,
+    subnegotiation_event_router &event_router);
 
 //* =========================================================================
 /// \brief Registers an option with negotiation and subnegotiation routers.
@@ -22,7 +24,8 @@ void register_client_option(
 void register_server_option(
     telnetpp::server_option &option,
     negotiation_router &neg_router,
-    subnegotiation_router &sub_router);
+    subnegotiation_router &sub_router,
+    subnegotiation_event_router &event_router);
 
 /// =========================================================================
 /// \brief Registers a negotiation with a router to route it to a client or
@@ -54,4 +57,19 @@ void register_route_from_subnegotiation_to_option(
         });
 }
 
+//* =========================================================================
+/// \brief Registers an option to receive events for subnegotiations for it
+/// that were too large to be delivered whole.
+//* =========================================================================
+template <class SubnegotiableOption>
+void register_route_from_subnegotiation_event_to_option(
+    subnegotiation_event_router &route, SubnegotiableOption &option)
+{
+    route.register_route(
+        option.option_code(),
+        [&option](telnetpp::subnegotiation_event const &event) {
+            return option.subnegotiate(event);
+        });
+}
+
 }  // namespace telnetpp::detail
@@ -2,9 +2,13 @@
 
 #include "telnetpp/detail/return_default.hpp"
 
-#include <functional>
-#include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
 #include <utility>
+#include <vector>
 
 namespace telnetpp::detail {
 
@@ -15,22 +19,42 @@ namespace telnetpp::detail {
 /// be derivable from a message in some way.
 /// \param Message A message that this router receives and must forward
 /// appropriately.
+/// \param Function The type in which each handler is held, such as
+/// inplace_function<void(Message)>.  It must be default-constructible to
+/// an empty state that converts to false.
 /// \param KeyFromMessagePolicy A template class that implements the
-/// following function: \code
-/// static void KeyFromMessagePolicy::key_from_message(Message const &message)
-/// \endcode This function should return a Key that is derived from the
-/// Message.
+/// following: \code
+/// static Key KeyFromMessagePolicy::key_from_message(Message const &message)
+/// static std::size_t KeyFromMessagePolicy::index_from_key(Key const &key)
+/// static constexpr std::size_t key_count
+/// \endcode key_from_message should return a Key that is derived from the
+/// Message, and index_from_key should map each Key onto a distinct index
+/// less than key_count.
 ///
 /// A class template that receives messages and forwards them on to
 /// appropriate handlers.
 ///
+/// \par Dispatch
+/// Every key that the router deals with maps onto a small, dense range of
+/// indices: a byte, or a request and option pair.  The router therefore
+/// holds a flat table of key_count small indices into a list of
+/// handlers, where the first handler is the unregistered route.  Routing a
+/// message is then a few loads and an indirect call, with no hashing
+/// and no searching.
+/// \par
+/// A handler may register routes while it is being called, so each handler
+/// is allocated on its own, where it stays however the list grows.
+///
 /// \par Usage
 /// Create an instance of the class, passing the necessary template parameters.
 /// For this demonstration, we will use a char as a Key, a string as a Message,
 /// and a hypothetical class first_element<> that returns the first
 /// element of the string as its key.
 /// \par
-/// \code router<char, std::string, void, first_element> route; \endcode
+/// \code
+/// router<char, std::string, std::function<void(std::string)>,
+///        first_element> route;
+/// \endcode
 /// \par
 /// We want to forward any strings beginning with the letter 'z' to a
 /// hypothetical function, "z_handler".
@@ -46,28 +70,69 @@ namespace telnetpp::detail {
 /// \par
 /// \code std::for_each(vec.begin(), vec.end(), route); \endcode
 //* =========================================================================
-template <class Key, class Message, class Function, class KeyFromMessagePolicy>
+template <
+    class Key,
+    class Message,
+    class Function,
+    class KeyFromMessagePolicy>
 class router
 {
 public:
     using key_type = Key;
     using message_type = Message;
-    using function_type = std::function<Function>;
+    using function_type = Function;
     using result_type = typename function_type::result_type;
-    using registered_functions_map_type =
-        std::unordered_map<key_type, function_type>;
+
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    router()
+    {
+        // The first handler is reserved for the unregistered route, so that
+        // an empty slot in the table refers to it.
+        handlers_.push_back(std::make_unique<function_type>());
+    }
 
     //* =====================================================================
     /// \brief Register a route for messages with a particular key.
     ///
     /// Register a route that will later on be taken by any message received
-    /// that contains the specified key.
+    /// that contains the specified key.  Registering an empty function
+    /// unregisters the route instead.
     //* =====================================================================
     template <typename KeyType, typename Continuation>
     void register_route(KeyType &&key, Continuation &&cont)
     {
-        registered_functions_[std::forward<KeyType>(key)] =
-            std::forward<Continuation>(cont);
+        function_type handler(std::forward<Continuation>(cont));
+
+        if (!handler)
+        {
+            unregister_route(key);
+            return;
+        }
+
+        auto &slot = slots_[index_from_key(key)];
+
+        if (slot == unregistered_slot)
+        {
+            // Reuse the space of a previously unregistered route if there
+            // is one.
+            auto const first_handler = std::next(handlers_.begin());
+            auto const free_handler = std::find_if(
+                first_handler,
+                handlers_.end(),
+                [](auto const &existing) { return !*existing; });
+
+            slot = static_cast<slot_type>(
+                std::distance(handlers_.begin(), free_handler));
+
+            if (free_handler == handlers_.end())
+            {
+                handlers_.push_back(std::make_unique<function_type>());
+            }
+        }
+
+        *handlers_[slot] = std::move(handler);
     }
 
     //* =====================================================================
@@ -79,7 +144,13 @@ public:
     template <typename KeyType>
     void unregister_route(KeyType &&key)
     {
-        registered_functions_.erase(std::forward<KeyType>(key));
+        auto &slot = slots_[index_from_key(key)];
+
+        if (slot != unregistered_slot)
+        {
+            *handlers_[slot] = function_type{};
+            slot = unregistered_slot;
+        }
     }
 
     //* =====================================================================
@@ -91,7 +162,7 @@ public:
     template <typename Continuation>
     void set_unregistered_route(Continuation &&cont)
     {
-        unregistered_route_ = std::forward<Continuation>(cont);
+        *handlers_[unregistered_slot] = std::forward<Continuation>(cont);
     }
 
     //* =====================================================================
@@ -105,17 +176,12 @@ public:
     template <typename MessageType, typename... Args>
     result_type operator()(MessageType &&message, Args &&...args) const
     {
-        if (auto iter = registered_functions_.find(
-                KeyFromMessagePolicy::key_from_message(message));
-            iter != registered_functions_.end())
-        {
-            return iter->second(
-                std::forward<MessageType>(message),
-                std::forward<Args>(args)...);
-        }
-        else if (unregistered_route_)
+        auto const &handler = *handlers_[slots_[index_from_key(
+            KeyFromMessagePolicy::key_from_message(message))]];
+
+        if (handler)
         {
-            return unregistered_route_(
+            return handler(
                 std::forward<MessageType>(message),
                 std::forward<Args>(args)...);
         }
@@ -126,8 +192,21 @@ public:
     }
 
 private:
-    registered_functions_map_type registered_functions_;
-    function_type unregistered_route_;
+    using slot_type = std::uint16_t;
+    static constexpr slot_type unregistered_slot = 0;
+    static constexpr std::size_t key_count = KeyFromMessagePolicy::key_count;
+
+    static_assert(key_count < 0xFFFF, "too many keys for the slot type");
+
+    static constexpr std::size_t index_from_key(key_type const &key)
+    {
+        auto const index = KeyFromMessagePolicy::index_from_key(key);
+        assert(index < key_count);
+        return index;
+    }
+
+    std::array<slot_type, key_count> slots_{};
+    std::vector<std::unique_ptr<function_type>> handlers_;
 };
 
 }  // namespace telnetpp::detail
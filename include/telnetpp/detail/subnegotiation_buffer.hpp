@@ -0,0 +1,43 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+
+#include <cstddef>
+#include <span>
+#include <utility>
+
+namespace telnetpp::detail {
+
+//* =========================================================================
+/// \brief Storage into which an option encodes a whole subnegotiation,
+/// from IAC SB to IAC SE, before writing it exactly as it is.
+///
+/// Encoding and escaping the subnegotiation in a single pass means that it
+/// is neither built up as content first nor escaped again by the session.
+/// The storage is kept between sends, so that once it has grown to the
+/// size of the largest subnegotiation, sending allocates nothing.  It is
+/// taken while it is in use, so that if the write leads to another send,
+/// that send is given fresh storage instead of overwriting this one.
+//* =========================================================================
+class subnegotiation_buffer
+{
+public:
+    //* =====================================================================
+    /// \brief Makes room for a subnegotiation of the given size, passes
+    /// that room to encode, and then passes the part of it that encode
+    /// returns to write.
+    //* =====================================================================
+    template <typename Encode, typename Write>
+    void operator()(std::size_t size, Encode &&encode, Write &&write)
+    {
+        auto buffer = std::exchange(storage_, {});
+        buffer.resize(size);
+        write(encode(std::span<telnetpp::byte>{buffer}));
+        storage_ = std::move(buffer);
+    }
+
+private:
+    telnetpp::byte_storage storage_;
+};
+
+}  // namespace telnetpp::detail
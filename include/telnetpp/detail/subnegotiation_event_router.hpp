@@ -0,0 +1,34 @@
+#pragma once
+
+#include "telnetpp/detail/inplace_function.hpp"
+#include "telnetpp/detail/router.hpp"
+#include "telnetpp/subnegotiation_event.hpp"
+
+namespace telnetpp::detail {
+
+struct subnegotiation_event_router_key_from_message_policy
+{
+    static constexpr std::size_t key_count = 256;
+
+    static constexpr option_type key_from_message(
+        subnegotiation_event const &event)
+    {
+        return event.option();
+    }
+
+    static constexpr std::size_t index_from_key(option_type key)
+    {
+        return key;
+    }
+};
+
+class subnegotiation_event_router
+  : public router<
+        option_type,
+        subnegotiation_event,
+        inplace_function<void(telnetpp::subnegotiation_event)>,
+        detail::subnegotiation_event_router_key_from_message_policy>
+{
+};
+
+}  // namespace telnetpp::detail
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "telnetpp/detail/inplace_function.hpp"
 #include "telnetpp/detail/router.hpp"
 #include "telnetpp/element.hpp"
 #include "telnetpp/subnegotiation.hpp"
@@ -8,17 +9,24 @@ namespace telnetpp::detail {
 
 struct subnegotiation_router_key_from_message_policy
 {
+    static constexpr std::size_t key_count = 256;
+
     static constexpr option_type key_from_message(subnegotiation const &sub)
     {
         return sub.option();
     }
+
+    static constexpr std::size_t index_from_key(option_type key)
+    {
+        return key;
+    }
 };
 
 class subnegotiation_router
   : public router<
         option_type,
         subnegotiation,
-        void(telnetpp::subnegotiation),
+        inplace_function<void(telnetpp::subnegotiation)>,
         detail::subnegotiation_router_key_from_message_policy>
 {
 };
@@ -3,6 +3,9 @@
 #include "telnetpp/detail/generate_helper.hpp"
 #include "telnetpp/detail/overloaded.hpp"
 #include "telnetpp/element.hpp"
+#include "telnetpp/output_segments.hpp"
+
+#include <span>
 
 namespace telnetpp {
 
@@ -33,4 +36,53 @@ constexpr void generate(telnetpp::element const &elem, Continuation &&cont)
         elem);
 }
 
+//* =========================================================================
+/// \brief Transform a Telnet element into streams of bytes, appending them
+/// to a sequence of segments so that they can be written with a single
+/// scatter-gather write.
+/// \param elem the element to transform.
+/// \param segments the segments to which the transformed data is appended.
+//* =========================================================================
+constexpr void generate(
+    telnetpp::element const &elem, telnetpp::output_segments &segments)
+{
+    telnetpp::generate(elem, [&segments](telnetpp::bytes data) {
+        segments.push_back(data);
+    });
+}
+
+//* =========================================================================
+/// \brief Transform a batch of Telnet elements into streams of bytes.
+/// \param elems the elements to transform.
+/// \param cont a continuation that will be called with a number
+///        of spans of bytes, which will represent the transformed
+///        data.
+//* =========================================================================
+template <class Continuation>
+constexpr void generate(
+    std::span<telnetpp::element const> elems, Continuation &&cont)
+{
+    for (auto const &elem : elems)
+    {
+        telnetpp::generate(elem, cont);
+    }
+}
+
+//* =========================================================================
+/// \brief Transform a batch of Telnet elements into streams of bytes,
+/// appending them to a sequence of segments so that they can be written with
+/// a single scatter-gather write.
+/// \param elems the elements to transform.
+/// \param segments the segments to which the transformed data is appended.
+//* =========================================================================
+constexpr void generate(
+    std::span<telnetpp::element const> elems,
+    telnetpp::output_segments &segments)
+{
+    for (auto const &elem : elems)
+    {
+        telnetpp::generate(elem, segments);
+    }
+}
+
 }  // namespace telnetpp
@@ -1,8 +1,8 @@
 #pragma once
 
 #include "telnetpp/session.hpp"
-
-#include <boost/signals2.hpp>
+#include "telnetpp/signal.hpp"
+#include "telnetpp/subnegotiation_event.hpp"
 
 namespace telnetpp {
 
@@ -207,6 +207,20 @@ public:
         }
     }
 
+    //* =====================================================================
+    /// \brief Subnegotiate with the option.
+    /// This should be called when a subnegotiation that was too large to be
+    /// delivered whole is being received from the remote.
+    /// \see telnetpp::session::set_subnegotiation_limit
+    //* =====================================================================
+    constexpr void subnegotiate(telnetpp::subnegotiation_event const &event)
+    {
+        if (state_ == internal_state::active)
+        {
+            handle_subnegotiation_event(event);
+        }
+    }
+
     //* =====================================================================
     /// \fn on_state_changed.connect
     /// \brief A signal that is emitted whenever there is a change in the
@@ -219,7 +233,7 @@ public:
     /// The parameter of the signal is a continuation that can be called to
     /// send any Telnet elements that are emitted by this process.
     //* =====================================================================
-    boost::signals2::signal<void()> on_state_changed;  // NOLINT
+    telnetpp::signal<void()> on_state_changed;  // NOLINT
 
 protected:
     //* =====================================================================
@@ -247,6 +261,16 @@ protected:
         session_.write(telnetpp::subnegotiation{code_, content});
     }
 
+    //* =====================================================================
+    /// \brief Write a subnegotiation that has already been encoded, from
+    /// IAC SB to IAC SE and with any IAC bytes in its content doubled, to
+    /// the session exactly as it is.
+    //* =====================================================================
+    void write_encoded_subnegotiation(telnetpp::bytes frame)
+    {
+        session_.write_encoded(frame);
+    }
+
 private:
     //* =====================================================================
     /// \brief Write a negotiation to the session
@@ -262,6 +286,17 @@ private:
     //* =====================================================================
     virtual void handle_subnegotiation(telnetpp::bytes data) = 0;
 
+    //* =====================================================================
+    /// \brief Called when an event for a subnegotiation that was too large to
+    /// be delivered whole is received while the option is active.  By
+    /// default, these are ignored.  Override for options that can process
+    /// their subnegotiations in pieces.
+    //* =====================================================================
+    virtual void handle_subnegotiation_event(
+        telnetpp::subnegotiation_event const & /*event*/)
+    {
+    }
+
     enum class internal_state : std::uint8_t
     {
         inactive,
@@ -2,8 +2,7 @@
 
 #include "telnetpp/options/charset/detail/protocol.hpp"
 #include "telnetpp/server_option.hpp"
-
-#include <boost/signals2.hpp>
+#include "telnetpp/signal.hpp"
 
 #include <vector>
 
@@ -30,11 +29,11 @@ public:
     //* =====================================================================
     void select_charset(telnetpp::bytes charset);
 
-    boost::signals2::signal<void(
+    telnetpp::signal<void(
         std::vector<telnetpp::byte_storage> const &)>
         on_charsets_advertised;  // NOLINT
 
-    boost::signals2::signal<void(telnetpp::bytes)>
+    telnetpp::signal<void(telnetpp::bytes)>
         on_charset_selected;  // NOLINT
 
 private:
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "telnetpp/options/gmcp/detail/handler_table.hpp"
+#include "telnetpp/options/gmcp/message_view.hpp"
+#include "telnetpp/client_option.hpp"
+#include "telnetpp/detail/subnegotiation_buffer.hpp"
+
+#include <string_view>
+
+namespace telnetpp::options::gmcp {
+
+//* =========================================================================
+/// \brief An implementation of the client side of a GMCP Telnet option.
+//* =========================================================================
+class TELNETPP_EXPORT client : public telnetpp::client_option
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    explicit client(telnetpp::session &sess) noexcept;
+
+    //* =====================================================================
+    /// \brief Send a message to the remote server.  The payload must already
+    /// be encoded as JSON, and is sent exactly as it is.  If it is empty,
+    /// the message has no payload.
+    //* =====================================================================
+    void send(std::string_view package, telnetpp::bytes payload = {});
+
+    //* =====================================================================
+    /// \brief Send a message to the remote server.  The payload must already
+    /// be encoded as JSON, and is sent exactly as it is.
+    //* =====================================================================
+    void send(std::string_view package, std::string_view payload);
+
+    //* =====================================================================
+    /// \brief Sets the handler for messages of the given package that are
+    /// received from the remote server, replacing any handler that it
+    /// already has.  Package names are not case-sensitive.  An empty
+    /// handler removes the package's handler instead.  This must not be
+    /// called from within a handler.
+    //* =====================================================================
+    void set_handler(std::string_view package, message_handler handler);
+
+    //* =====================================================================
+    /// \fn on_receive
+    /// \brief Register for a signal whenever a message is received from the
+    /// remote server, after it has been passed to any handler for its
+    /// package.  The message is valid only for the duration of the signal.
+    //* =====================================================================
+    telnetpp::signal<void(message_view const &)> on_receive;
+
+    //* =====================================================================
+    /// \fn on_oversized_message
+    /// \brief Register for a signal whenever a message from the
+    /// remote server is discarded because it exceeds the session's
+    /// subnegotiation limit.  This is only known under the error and stream
+    /// overflow policies; under the discard policy, such messages are
+    /// dropped silently.
+    //* =====================================================================
+    telnetpp::signal<void()> on_oversized_message;
+
+private:
+    //* =====================================================================
+    /// \brief Called when a subnegotiation is received while the option is
+    /// active.  Override for option-specific functionality.
+    //* =====================================================================
+    void handle_subnegotiation(telnetpp::bytes data) override;
+
+    //* =====================================================================
+    /// \brief Called when an event for a subnegotiation that was too large
+    /// to be delivered whole is received while the option is active.
+    //* =====================================================================
+    void handle_subnegotiation_event(
+        telnetpp::subnegotiation_event const &event) override;
+
+    detail::handler_table handlers_;
+    telnetpp::detail::subnegotiation_buffer send_buffer_;
+};
+
+}  // namespace telnetpp::options::gmcp
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace telnetpp::options::gmcp::detail {
+
+//* =========================================================================
+/// \brief Returns the size of the complete subnegotiation that carries a
+/// message, from IAC SB to IAC SE, with any IAC bytes doubled.
+//* =========================================================================
+TELNETPP_EXPORT
+std::size_t subnegotiation_size(
+    std::string_view package, telnetpp::bytes payload) noexcept;
+
+//* =========================================================================
+/// \brief Encodes the complete subnegotiation that carries a message into
+/// the buffer, which must have room for at least subnegotiation_size()
+/// bytes.  The payload is copied exactly as it is, except that any IAC
+/// bytes are doubled.  If the payload is empty, then so is the message's.
+/// \returns the part of the buffer that was written.
+//* =========================================================================
+TELNETPP_EXPORT
+telnetpp::bytes encode_subnegotiation(
+    std::string_view package,
+    telnetpp::bytes payload,
+    std::span<telnetpp::byte> buffer) noexcept;
+
+}  // namespace telnetpp::options::gmcp::detail
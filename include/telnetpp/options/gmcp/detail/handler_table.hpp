@@ -0,0 +1,44 @@
+#pragma once
+
+#include "telnetpp/options/gmcp/message_view.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace telnetpp::options::gmcp::detail {
+
+//* =========================================================================
+/// \brief A table of message handlers, keyed on package name.
+///
+/// GMCP package names are not case-sensitive, and so neither is the
+/// table.  Handlers are kept in a single vector, sorted by name, so that a
+/// handler is found by a binary search over contiguous storage.
+//* =========================================================================
+class TELNETPP_EXPORT handler_table
+{
+public:
+    //* =====================================================================
+    /// \brief Sets the handler for the given package, replacing any handler
+    /// that it already has.  An empty handler removes it instead.
+    //* =====================================================================
+    void set(std::string_view package, message_handler handler);
+
+    //* =====================================================================
+    /// \brief Returns the handler for the given package, or nullptr if it
+    /// has none.
+    //* =====================================================================
+    [[nodiscard]] message_handler const *find(
+        telnetpp::bytes package) const noexcept;
+
+private:
+    struct entry
+    {
+        std::string package_;
+        message_handler handler_;
+    };
+
+    std::vector<entry> entries_;
+};
+
+}  // namespace telnetpp::options::gmcp::detail
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+
+//* =========================================================================
+/// \namespace telnetpp::options::gmcp
+/// \brief An implementation of the Generic Mud Communication Protocol
+/// \par Overview
+/// GMCP is used to send messages between server and client.  Each message
+/// is a package name, such as "Char.Vitals", optionally followed by a space
+/// and a payload of JSON.
+/// \par
+/// As with MSDP, there is no difference between the server and client
+/// protocols: both can send and receive messages.  The library does not
+/// parse or build JSON; payloads are sent exactly as they are given, and
+/// received payloads are handed on exactly as they arrived.
+/// \par Usage
+/// Create a server or client as appropriate.  Install it in a session,
+/// activate as normal.
+/// \par
+/// Messages are sent using your option's send() function.  Received
+/// messages can be handled for a particular package by registering a
+/// handler with set_handler(), or for every package using the on_receive
+/// signal.
+/// \code
+///     gmcp_server.set_handler(
+///         "Core.Supports.Set",
+///         [](telnetpp::options::gmcp::message_view const &msg) {
+///             my_parse_json(msg.payload_);
+///         });
+///
+///     gmcp_server.send("Char.Vitals", R"({"hp":100,"maxhp":120})");
+/// \endcode
+/// \par
+/// Messages are only handled whole, so one that is larger than the
+/// session's subnegotiation limit is never received.  Under the error and
+/// stream overflow policies, the on_oversized_message signal is emitted
+/// once for each such message instead.
+/// \see https://www.gammon.com.au/gmcp
+//* =========================================================================
+namespace telnetpp::options::gmcp::detail {
+
+inline constexpr option_type const option = 201;
+
+// The package name and payload of a message are separated by a space.
+inline constexpr byte const separator = ' ';
+
+}  // namespace telnetpp::options::gmcp::detail
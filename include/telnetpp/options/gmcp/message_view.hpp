@@ -0,0 +1,35 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+
+#include <functional>
+
+namespace telnetpp::options::gmcp {
+
+//* =========================================================================
+/// \brief A GMCP message, as views of the subnegotiation content from which
+/// it was split.  It is therefore only valid for as long as that content.
+//* =========================================================================
+struct TELNETPP_EXPORT message_view
+{
+    /// The name of the message's package, e.g. "Char.Vitals".
+    telnetpp::bytes package_;
+
+    /// The JSON payload of the message, which is empty if there was none.
+    telnetpp::bytes payload_;
+};
+
+//* =========================================================================
+/// \brief A function that handles received messages.
+//* =========================================================================
+using message_handler = std::function<void(message_view const &)>;
+
+//* =========================================================================
+/// \brief Splits subnegotiation content into a package name and payload,
+/// which are separated by the first space.  Nothing is copied, and the
+/// payload is not examined.
+//* =========================================================================
+TELNETPP_EXPORT
+message_view split_message(telnetpp::bytes content) noexcept;
+
+}  // namespace telnetpp::options::gmcp
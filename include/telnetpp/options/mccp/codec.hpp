@@ -1,6 +1,7 @@
 #pragma once
 
 #include "telnetpp/core.hpp"
+#include "telnetpp/options/mccp/statistics.hpp"
 
 #include <boost/exception/exception.hpp>
 
@@ -37,15 +38,58 @@ public:
     //* =====================================================================
     void finish(continuation const &cont);
 
+    //* =====================================================================
+    /// \brief Sends on any transformed data that the codec is holding back,
+    /// so that the far end can act on everything transformed so far.  If
+    /// the stream is not started, this does nothing.
+    //* =====================================================================
+    void flush(continuation const &cont);
+
     //* =====================================================================
     /// \brief Transform data, if the stream is started, sending the result
     /// of the transformation to the continuation.  If the stream is not
     /// started, the data is passed on untransformed.
     ///
+    /// Untransformed data is passed on in as few pieces as possible.  Since
+    /// the stream may be started by any subnegotiation, each piece ends
+    /// either at the end of the data or just after an IAC SE.
+    ///
     /// \throws corrupted_stream_error if the data was malformed.
     //* =====================================================================
     void operator()(telnetpp::bytes data, continuation const &cont);
 
+    //* =====================================================================
+    /// \brief Returns the statistics of the work done by this codec since
+    /// it was constructed or its statistics were last reset.
+    //* =====================================================================
+    [[nodiscard]] codec_statistics const &statistics() const noexcept;
+
+    //* =====================================================================
+    /// \brief Sets the statistics of this codec to zero.  Any collector is
+    /// unaffected.
+    //* =====================================================================
+    void reset_statistics() noexcept;
+
+    //* =====================================================================
+    /// \brief Adds the statistics of all future work done by this codec to
+    /// the given collector, or to none if it is null.
+    //* =====================================================================
+    void set_statistics_collector(statistics_collector *collector) noexcept;
+
+    //* =====================================================================
+    /// \brief Sets whether the codec measures the time that it spends
+    /// transforming data.  This is off by default, since reading the clock
+    /// can cost as much as transforming a short write.
+    //* =====================================================================
+    void set_timing_enabled(bool enabled) noexcept;
+
+protected:
+    //* =====================================================================
+    /// \brief Records that the codec has sent on the data it was holding
+    /// back.  For use by derived codecs that hold data back.
+    //* =====================================================================
+    void count_flush() noexcept;
+
 private:
     //* =====================================================================
     /// \brief A hook for when the transformation stream starts.
@@ -57,6 +101,11 @@ private:
     //* =====================================================================
     virtual void do_finish(continuation const & /*cont*/) {};
 
+    //* =====================================================================
+    /// \brief A hook for when the transformation stream is flushed.
+    //* =====================================================================
+    virtual void do_flush(continuation const & /*cont*/) {};
+
     //* =====================================================================
     /// \brief Transform the given bytes, sending the transformed data
     /// to the continuation, along with a boolean indicating whether the
@@ -72,7 +121,37 @@ private:
     virtual telnetpp::bytes transform_chunk(
         telnetpp::bytes data, continuation const &continuation) = 0;
 
+    //* =====================================================================
+    /// \brief Returns the length of the prefix of the data that ends with
+    /// the next IAC SE, or the length of the data if it has none.  An IAC
+    /// at the end of the data is remembered for the next call.
+    //* =====================================================================
+    std::size_t find_subnegotiation_end(telnetpp::bytes data) noexcept;
+
+    //* =====================================================================
+    /// \brief Calls the transformation with a continuation that passes
+    /// its output on to cont, recording the output and the time spent in
+    /// the transformation.
+    //* =====================================================================
+    template <typename Transformation>
+    void measure(continuation const &cont, Transformation &&transformation);
+
+    //* =====================================================================
+    /// \brief Adds the statistics recorded since the last call to the
+    /// codec's statistics, and to those of its collector.
+    //* =====================================================================
+    void publish_statistics() noexcept;
+
+    // Publishes the codec's statistics when it leaves scope, so that they
+    // are recorded even if the transformation throws.
+    class publisher;
+
     bool engaged_{false};
+    bool iac_pending_{false};
+    bool timing_enabled_{false};
+    codec_statistics statistics_;
+    codec_statistics pending_statistics_;
+    statistics_collector *collector_{nullptr};
 };
 
 //* =========================================================================
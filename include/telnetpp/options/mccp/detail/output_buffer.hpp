@@ -0,0 +1,134 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace telnetpp::options::mccp::detail {
+
+//* =========================================================================
+/// \brief Describes how a compression library's output cursor is directed
+/// at a region of memory.  Each codec specialises this for its own cursor
+/// type, providing:
+///
+/// \code
+/// static void point(
+///     Cursor &cursor, telnetpp::byte *region, std::size_t size,
+///     std::size_t used);
+/// static std::size_t used(Cursor const &cursor, telnetpp::byte const *region);
+/// \endcode
+///
+/// where point() directs the cursor to write after the first used bytes of
+/// a region of the given size, and used() returns how many bytes of the
+/// region the cursor has written.
+//* =========================================================================
+template <typename Cursor>
+struct output_cursor_traits;
+
+//* =========================================================================
+/// \brief The sizes that govern an output_buffer, which are the same for
+/// every codec.
+//* =========================================================================
+struct output_buffer_sizes
+{
+    static constexpr std::size_t initial_size = 1024;
+    static constexpr std::size_t max_retained_size = 64 * 1024;
+    static constexpr std::size_t max_inflated_size = 256 * 1024;
+};
+
+//* =========================================================================
+/// \brief A contiguous region into which a codec's stream writes its output.
+///
+/// The region grows as the stream fills it, so that all of the output of a
+/// transformation can be passed on in a single piece.  A region that has
+/// grown beyond max_retained_size is kept while the output remains of a
+/// similar size, but is freed after the first output that is much smaller,
+/// so that an occasional large transformation does not leave every codec
+/// holding a large buffer.
+///
+/// Output that is decompressed from a peer's data is not allowed to grow
+/// the region beyond max_inflated_size.  Compressed data can expand by
+/// about 1000:1, so a peer could otherwise make each small read allocate a
+/// very large region.
+//* =========================================================================
+template <typename Cursor>
+class output_buffer : public output_buffer_sizes
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    explicit output_buffer(std::pmr::memory_resource *resource)
+      : storage_{resource}
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Directs the cursor to the start of the region, which is made
+    /// at least the given size.
+    //* =====================================================================
+    void begin(Cursor &cursor, std::size_t size_hint = initial_size)
+    {
+        auto const size = std::max(size_hint, initial_size);
+
+        if (storage_.size() < size)
+        {
+            storage_.resize(size);
+        }
+
+        traits::point(cursor, storage_.data(), storage_.size(), 0);
+    }
+
+    //* =====================================================================
+    /// \brief Doubles the size of the region, keeping the output that has
+    /// been written so far, and directs the cursor to the space that
+    /// follows it.
+    //* =====================================================================
+    void grow(Cursor &cursor)
+    {
+        auto const used = traits::used(cursor, storage_.data());
+        storage_.resize(storage_.size() * 2);
+        traits::point(cursor, storage_.data(), storage_.size(), used);
+    }
+
+    //* =====================================================================
+    /// \brief Returns the size of the region.
+    //* =====================================================================
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return storage_.size();
+    }
+
+    //* =====================================================================
+    /// \brief Returns the output that the cursor has written to the region.
+    //* =====================================================================
+    [[nodiscard]] telnetpp::bytes data(Cursor const &cursor) const noexcept
+    {
+        return {storage_.data(), traits::used(cursor, storage_.data())};
+    }
+
+    //* =====================================================================
+    /// \brief Frees the region if it is no longer worth keeping, given the
+    /// output that was last written to it.  Any output that it holds is
+    /// lost.
+    //* =====================================================================
+    void trim(telnetpp::bytes output) noexcept
+    {
+        if (storage_.size() > max_retained_size
+            && output.size() < storage_.size() / 4)
+        {
+            std::pmr::vector<telnetpp::byte>{storage_.get_allocator()}.swap(
+                storage_);
+        }
+    }
+
+private:
+    using traits = output_cursor_traits<Cursor>;
+
+    std::pmr::vector<telnetpp::byte> storage_;
+};
+
+}  // namespace telnetpp::options::mccp::detail
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace telnetpp::options::mccp {
+
+//* =========================================================================
+/// \brief When a compressor makes the data that it has compressed
+/// available to be decompressed.
+///
+/// Each flush adds a few bytes to the stream and resets some of the state
+/// of the compression, so flushing after many small writes costs both
+/// bandwidth and processor time.  Whatever the policy, the compressed data
+/// is always flushed by codec::flush() and codec::finish().
+//* =========================================================================
+enum class flush_policy : std::uint8_t
+{
+    /// The compressed data is flushed after every write.  This is the
+    /// default.
+    every_write,
+
+    /// The compressed data is flushed only when explicitly requested.
+    explicit_only,
+
+    /// The compressed data is flushed once the amount of data written since
+    /// the last flush reaches a threshold.
+    threshold,
+};
+
+}  // namespace telnetpp::options::mccp
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace telnetpp::options::mccp {
+
+//* =========================================================================
+/// \brief Counters that describe the work done by a codec while its
+/// transformation stream is started.  Data that is passed on untransformed
+/// is not counted.
+//* =========================================================================
+struct TELNETPP_EXPORT codec_statistics
+{
+    /// The number of bytes that were transformed.
+    std::uint64_t bytes_in{0};
+
+    /// The number of bytes that the transformation produced.
+    std::uint64_t bytes_out{0};
+
+    /// The number of times that a codec sent on the data it was holding
+    /// back, whether by policy or on request.
+    std::uint64_t flushes{0};
+
+    /// The number of transformation streams that were started.
+    std::uint64_t streams_started{0};
+
+    /// The number of transformation streams that were finished, whether
+    /// explicitly or by the stream itself.
+    std::uint64_t streams_finished{0};
+
+    /// The time spent transforming data, if the codec measures it.  This
+    /// excludes the time spent in the continuations to which the
+    /// transformed data was sent.
+    std::chrono::nanoseconds transform_time{0};
+
+    //* =====================================================================
+    /// \brief Adds the counters of another set of statistics to these.
+    //* =====================================================================
+    constexpr codec_statistics &operator+=(
+        codec_statistics const &other) noexcept
+    {
+        bytes_in += other.bytes_in;
+        bytes_out += other.bytes_out;
+        flushes += other.flushes;
+        streams_started += other.streams_started;
+        streams_finished += other.streams_finished;
+        transform_time += other.transform_time;
+        return *this;
+    }
+
+    constexpr friend bool operator==(
+        codec_statistics const &lhs, codec_statistics const &rhs) = default;
+};
+
+//* =========================================================================
+/// \brief Accumulates the statistics of any number of codecs, for example
+/// all of those of a server, so that they can be examined together.
+///
+/// Codecs add to a collector as they work, and a collector may be shared
+/// between codecs that are used in different threads.  A collector must
+/// outlive all of the codecs that use it.
+//* =========================================================================
+class TELNETPP_EXPORT statistics_collector
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    statistics_collector() = default;
+
+    statistics_collector(statistics_collector const &) = delete;
+    statistics_collector &operator=(statistics_collector const &) = delete;
+
+    //* =====================================================================
+    /// \brief Adds the given statistics to the totals.
+    //* =====================================================================
+    void add(codec_statistics const &statistics) noexcept;
+
+    //* =====================================================================
+    /// \brief Returns the totals of all statistics added so far.  If
+    /// statistics are being added concurrently, then each counter is
+    /// accurate, but they may not all reflect the same moment.
+    //* =====================================================================
+    [[nodiscard]] codec_statistics snapshot() const noexcept;
+
+    //* =====================================================================
+    /// \brief Sets all of the totals to zero.
+    //* =====================================================================
+    void reset() noexcept;
+
+private:
+    std::atomic<std::uint64_t> bytes_in_{0};
+    std::atomic<std::uint64_t> bytes_out_{0};
+    std::atomic<std::uint64_t> flushes_{0};
+    std::atomic<std::uint64_t> streams_started_{0};
+    std::atomic<std::uint64_t> streams_finished_{0};
+    std::atomic<std::chrono::nanoseconds::rep> transform_time_{0};
+};
+
+}  // namespace telnetpp::options::mccp
@@ -0,0 +1,50 @@
+#pragma once
+
+namespace telnetpp::options::mccp::zlib {
+
+//* =========================================================================
+/// \brief The parameters with which a compression stream is created.  These
+/// are passed directly to zlib's deflateInit2().
+///
+/// Most of the memory used by a compression stream is determined by the
+/// window_bits and memory_level, and comes to roughly
+/// (1 << (window_bits + 2)) + (1 << (memory_level + 9)) bytes.  Smaller
+/// values use less memory at the cost of a poorer compression ratio.
+//* =========================================================================
+struct compression_parameters
+{
+    /// The compression level, from 0 (none) to 9 (best), or -1 for zlib's
+    /// default, which is currently 6.
+    int level = -1;
+
+    /// The base two logarithm of the size of the history window, from 9 to
+    /// 15.
+    int window_bits = 15;
+
+    /// How much memory is used for the internal compression state, from 1
+    /// to 9.
+    int memory_level = 8;
+};
+
+//* =========================================================================
+/// \brief The parameters that zlib uses by default.  Each stream requires
+/// around 260KB.
+//* =========================================================================
+inline constexpr compression_parameters default_compression{};
+
+//* =========================================================================
+/// \brief Parameters for servers with many concurrent compressed sessions.
+/// Each stream requires around 18KB, which still compresses typical
+/// MUD output well.
+//* =========================================================================
+inline constexpr compression_parameters low_memory_compression{
+    .level = -1, .window_bits = 11, .memory_level = 3};
+
+//* =========================================================================
+/// \brief Parameters that give the best compression ratio.  Each stream
+/// requires around 390KB.
+//* =========================================================================
+inline constexpr compression_parameters high_ratio_compression{
+    .level = 9, .window_bits = 15, .memory_level = 9};
+
+}  // namespace telnetpp::options::mccp::zlib
@@ -1,8 +1,13 @@
 #pragma once
 
 #include "telnetpp/options/mccp/codec.hpp"
+#include "telnetpp/options/mccp/flush_policy.hpp"
+#include "telnetpp/options/mccp/zlib/compression_parameters.hpp"
+#include "telnetpp/options/mccp/zlib/stream_pool.hpp"
 
+#include <cstddef>
 #include <memory>
+#include <memory_resource>
 
 //* =========================================================================
 /// \namespace telnetpp::options::mccp::zlib
@@ -11,6 +16,8 @@
 //* =========================================================================
 namespace telnetpp::options::mccp::zlib {
 
+using telnetpp::options::mccp::flush_policy;
+
 //* =========================================================================
 /// \brief Represents an object that can compress arbitrary byte sequences.
 //* =========================================================================
@@ -20,14 +27,57 @@ class TELNETPP_EXPORT compressor  // NOLINT
 public:
     //* =====================================================================
     /// \brief Constructor
+    ///
+    /// All of the memory for the compression stream, including zlib's
+    /// internal state, is allocated from the given resource, which must
+    /// outlive the compressor.
+    ///
+    /// \throws std::invalid_argument if any of the parameters are out of
+    /// range.
+    //* =====================================================================
+    explicit compressor(
+        compression_parameters const &parameters = default_compression,
+        std::pmr::memory_resource *resource =
+            std::pmr::get_default_resource());
+
+    //* =====================================================================
+    /// \brief Constructor for a compressor that borrows its streams from
+    /// the given pool, and so uses the parameters and memory resource of
+    /// that pool.  The pool must outlive the compressor.
     //* =====================================================================
-    compressor();
+    explicit compressor(compression_stream_pool &pool);
 
     //* =====================================================================
     /// \brief Destructor
     //* =====================================================================
     ~compressor() override;
 
+    //* =====================================================================
+    /// \brief Returns the parameters with which compression streams are
+    /// created.
+    //* =====================================================================
+    [[nodiscard]] compression_parameters const &parameters() const noexcept;
+
+    //* =====================================================================
+    /// \brief Returns the number of bytes currently allocated by zlib for
+    /// the compression stream, or 0 if there is no stream.
+    //* =====================================================================
+    [[nodiscard]] std::size_t memory_usage() const noexcept;
+
+    //* =====================================================================
+    /// \brief Sets when compressed data is flushed.  The threshold is the
+    /// number of bytes that may be written without a flush, and is only
+    /// used by the threshold policy.
+    //* =====================================================================
+    void set_flush_policy(
+        flush_policy policy,
+        std::size_t threshold = default_flush_threshold) noexcept;
+
+    //* =====================================================================
+    /// \brief The threshold of a threshold flush policy if none is given.
+    //* =====================================================================
+    static constexpr std::size_t default_flush_threshold = 4096;
+
 private:
     //* =====================================================================
     /// \brief A hook for when the transformation stream starts.
@@ -39,6 +89,11 @@ private:
     //* =====================================================================
     void do_finish(continuation const &cont) override;
 
+    //* =====================================================================
+    /// \brief A hook for when the transformation stream is flushed.
+    //* =====================================================================
+    void do_flush(continuation const &cont) override;
+
     //* =====================================================================
     /// \brief Transform the given bytes, sending the transformed data
     /// to the continuation, along with a boolean indicating whether the
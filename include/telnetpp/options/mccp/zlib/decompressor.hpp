@@ -1,13 +1,19 @@
 #pragma once
 
 #include "telnetpp/options/mccp/codec.hpp"
+#include "telnetpp/options/mccp/zlib/stream_pool.hpp"
 
 #include <memory>
+#include <memory_resource>
 
 namespace telnetpp::options::mccp::zlib {
 
 //* =========================================================================
 /// \brief Represents an object that can decompress arbitrary byte sequences.
+///
+/// The output of each call is passed on in one piece unless it exceeds
+/// 256KiB, in which case it is passed on in pieces of at most that size, so
+/// that a peer cannot make the decompressor allocate without limit.
 //* =========================================================================
 class TELNETPP_EXPORT decompressor  // NOLINT
   : public telnetpp::options::mccp::codec
@@ -15,8 +21,21 @@ class TELNETPP_EXPORT decompressor  // NOLINT
 public:
     //* =====================================================================
     /// \brief Constructor
+    ///
+    /// All of the memory for the decompression stream, including zlib's
+    /// internal state, is allocated from the given resource, which must
+    /// outlive the decompressor.
+    //* =====================================================================
+    explicit decompressor(
+        std::pmr::memory_resource *resource =
+            std::pmr::get_default_resource());
+
+    //* =====================================================================
+    /// \brief Constructor for a decompressor that borrows its streams from
+    /// the given pool, and so uses the memory resource of that pool.  The
+    /// pool must outlive the decompressor.
     //* =====================================================================
-    decompressor();
+    explicit decompressor(decompression_stream_pool &pool);
 
     //* =====================================================================
     /// \brief Destructor
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "telnetpp/options/mccp/detail/output_buffer.hpp"
+
+#include <zlib.h>
+
+#include <cassert>
+#include <cstddef>
+
+namespace telnetpp::options::mccp::detail {
+
+//* =========================================================================
+/// \brief Directs a zlib stream's output at an output_buffer.
+//* =========================================================================
+template <>
+struct output_cursor_traits<z_stream>
+{
+    static void point(
+        z_stream &z,
+        telnetpp::byte *region,
+        std::size_t size,
+        std::size_t used) noexcept
+    {
+        z.next_out = region + used;
+        z.avail_out = static_cast<uInt>(size - used);
+    }
+
+    static std::size_t used(
+        z_stream const &z, telnetpp::byte const *region) noexcept
+    {
+        assert(z.next_out >= region);
+        return static_cast<std::size_t>(z.next_out - region);
+    }
+};
+
+}  // namespace telnetpp::options::mccp::detail
+
+namespace telnetpp::options::mccp::zlib::detail {
+
+using output_buffer = mccp::detail::output_buffer<z_stream>;
+
+}  // namespace telnetpp::options::mccp::zlib::detail
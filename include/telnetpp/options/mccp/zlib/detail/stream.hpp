@@ -0,0 +1,69 @@
+#pragma once
+
+#include "telnetpp/options/mccp/zlib/compression_parameters.hpp"
+#include "telnetpp/options/mccp/zlib/detail/stream_ptr.hpp"
+
+#include <zlib.h>
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace telnetpp::options::mccp::zlib::detail {
+
+//* =========================================================================
+/// \brief An initialized zlib stream, together with the memory resource
+/// from which it and all of zlib's state for it are allocated, and a count
+/// of the memory that zlib has allocated.
+///
+/// zlib's internal state refers back to the z_stream, so a stream must
+/// never be moved once it is initialized.  It is therefore always held by
+/// pointer.
+//* =========================================================================
+struct stream
+{
+    explicit stream(std::pmr::memory_resource *res) noexcept : resource{res}
+    {
+    }
+
+    z_stream z{};
+    std::pmr::memory_resource *resource;
+    std::size_t memory_usage{0};
+    bool deflating{false};
+};
+
+//* =========================================================================
+/// \brief Returns the parameters, having checked that zlib will accept
+/// them.
+///
+/// \throws std::invalid_argument if any of the parameters are out of range.
+//* =========================================================================
+compression_parameters const &validate_parameters(
+    compression_parameters const &parameters);
+
+//* =========================================================================
+/// \brief Creates a stream that is initialized for compression with the
+/// given parameters, allocating from the given resource.
+///
+/// \throws std::bad_alloc if zlib could not allocate its state.
+//* =========================================================================
+stream_ptr make_deflate_stream(
+    compression_parameters const &parameters,
+    std::pmr::memory_resource *resource);
+
+//* =========================================================================
+/// \brief Creates a stream that is initialized for decompression,
+/// allocating from the given resource.
+///
+/// \throws std::bad_alloc if zlib could not allocate its state.
+//* =========================================================================
+stream_ptr make_inflate_stream(std::pmr::memory_resource *resource);
+
+//* =========================================================================
+/// \brief Returns a stream to the state it was in when it was created, so
+/// that it can begin a new compression or decompression stream.
+///
+/// \returns false if the stream could not be reset.
+//* =========================================================================
+bool reset_stream(stream &strm) noexcept;
+
+}  // namespace telnetpp::options::mccp::zlib::detail
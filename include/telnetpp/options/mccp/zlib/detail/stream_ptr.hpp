@@ -0,0 +1,22 @@
+#pragma once
+
+#include <memory>
+
+namespace telnetpp::options::mccp::zlib::detail {
+
+struct stream;
+
+//* =========================================================================
+/// \brief Ends and frees a zlib stream.
+//* =========================================================================
+struct stream_deleter
+{
+    void operator()(stream *strm) const noexcept;
+};
+
+//* =========================================================================
+/// \brief An owning pointer to a zlib stream.
+//* =========================================================================
+using stream_ptr = std::unique_ptr<stream, stream_deleter>;
+
+}  // namespace telnetpp::options::mccp::zlib::detail
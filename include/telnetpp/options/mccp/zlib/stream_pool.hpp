@@ -0,0 +1,150 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+#include "telnetpp/options/mccp/zlib/compression_parameters.hpp"
+#include "telnetpp/options/mccp/zlib/detail/stream_ptr.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace telnetpp::options::mccp::zlib {
+
+class compressor;
+class decompressor;
+
+//* =========================================================================
+/// \brief A bounded pool of initialized zlib streams that can be shared
+/// between many compressors or decompressors.
+///
+/// Without a pool, each codec initializes a new zlib stream whenever it
+/// starts, and frees it when it finishes.  With a pool, a codec borrows a
+/// stream from the pool, and returns it afterwards, where it is reset
+/// ready for its next use.  This avoids repeatedly allocating the large
+/// zlib state when clients toggle compression or reconnect in numbers.
+///
+/// At most capacity streams are kept in the pool; any more that are
+/// returned are freed.  All streams are allocated from the pool's memory
+/// resource, which must be safe to use from any thread that uses the pool.
+/// A pool may be shared between threads, and must outlive all of the
+/// codecs that use it.
+//* =========================================================================
+class TELNETPP_EXPORT stream_pool  // NOLINT
+{
+public:
+    //* =====================================================================
+    /// \brief Returns the largest number of streams that are kept for
+    /// reuse.
+    //* =====================================================================
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    //* =====================================================================
+    /// \brief Returns the memory resource from which streams are allocated.
+    //* =====================================================================
+    [[nodiscard]] std::pmr::memory_resource *resource() const noexcept;
+
+    //* =====================================================================
+    /// \brief Returns the number of streams currently available for reuse.
+    //* =====================================================================
+    [[nodiscard]] std::size_t size() const;
+
+    //* =====================================================================
+    /// \brief Returns how many streams have been borrowed from the pool
+    /// that were reused.
+    //* =====================================================================
+    [[nodiscard]] std::size_t hits() const;
+
+    //* =====================================================================
+    /// \brief Returns how many streams have been borrowed from the pool
+    /// that had to be newly created because none were available.
+    //* =====================================================================
+    [[nodiscard]] std::size_t misses() const;
+
+protected:
+    using stream_ptr = detail::stream_ptr;
+
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    stream_pool(std::size_t capacity, std::pmr::memory_resource *resource);
+
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    virtual ~stream_pool();
+
+    stream_pool(stream_pool const &) = delete;
+    stream_pool &operator=(stream_pool const &) = delete;
+
+private:
+    friend class compressor;
+    friend class decompressor;
+
+    //* =====================================================================
+    /// \brief Borrows a stream from the pool, creating one if necessary.
+    //* =====================================================================
+    stream_ptr acquire();
+
+    //* =====================================================================
+    /// \brief Returns a stream to the pool.
+    //* =====================================================================
+    void release(stream_ptr strm) noexcept;
+
+    //* =====================================================================
+    /// \brief Creates a new stream of the kind held in this pool.
+    //* =====================================================================
+    [[nodiscard]] virtual stream_ptr make_stream() const = 0;
+
+    struct impl;
+    std::unique_ptr<impl> pimpl_;
+};
+
+//* =========================================================================
+/// \brief A pool of streams for compressors, all of which are created with
+/// the same parameters.
+//* =========================================================================
+class TELNETPP_EXPORT compression_stream_pool final : public stream_pool
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    ///
+    /// \throws std::invalid_argument if any of the parameters are out of
+    /// range.
+    //* =====================================================================
+    explicit compression_stream_pool(
+        std::size_t capacity,
+        compression_parameters const &parameters = default_compression,
+        std::pmr::memory_resource *resource =
+            std::pmr::get_default_resource());
+
+    //* =====================================================================
+    /// \brief Returns the parameters with which the streams are created.
+    //* =====================================================================
+    [[nodiscard]] compression_parameters const &parameters() const noexcept;
+
+private:
+    [[nodiscard]] stream_ptr make_stream() const override;
+
+    compression_parameters parameters_;
+};
+
+//* =========================================================================
+/// \brief A pool of streams for decompressors.
+//* =========================================================================
+class TELNETPP_EXPORT decompression_stream_pool final : public stream_pool
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    explicit decompression_stream_pool(
+        std::size_t capacity,
+        std::pmr::memory_resource *resource =
+            std::pmr::get_default_resource());
+
+private:
+    [[nodiscard]] stream_ptr make_stream() const override;
+};
+
+}  // namespace telnetpp::options::mccp::zlib
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "telnetpp/options/mccp/codec.hpp"
+#include "telnetpp/options/mccp/flush_policy.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+//* =========================================================================
+/// \namespace telnetpp::options::mccp::zstd
+/// \brief Implementation of the compressor/decompressor functionality for
+/// use with a telnetpp::options::mccp::codec, using Zstandard.
+///
+/// The MCCP protocols specify zlib streams, so these codecs cannot be used
+/// to talk to ordinary MUD clients and servers.  They are for links where
+/// both ends are known to use them, such as those between the tiers of a
+/// server, where Zstandard's speed is worth more than compatibility.
+//* =========================================================================
+namespace telnetpp::options::mccp::zstd {
+
+//* =========================================================================
+/// \brief Represents an object that can compress arbitrary byte sequences
+/// into Zstandard frames, one frame per transformation stream.
+//* =========================================================================
+class TELNETPP_EXPORT compressor  // NOLINT
+  : public telnetpp::options::mccp::codec
+{
+public:
+    //* =====================================================================
+    /// \brief The compression level used if none is given.  This is the
+    /// same as Zstandard's own default.
+    //* =====================================================================
+    static constexpr int default_level = 3;
+
+    //* =====================================================================
+    /// \brief The threshold of a threshold flush policy if none is given.
+    //* =====================================================================
+    static constexpr std::size_t default_flush_threshold = 4096;
+
+    //* =====================================================================
+    /// \brief Constructor
+    ///
+    /// The buffer into which data is compressed is allocated from the given
+    /// resource, which must outlive the compressor.  Zstandard's own context
+    /// is allocated by Zstandard.
+    ///
+    /// \throws std::invalid_argument if the level is not one that
+    /// Zstandard supports.
+    //* =====================================================================
+    explicit compressor(
+        int level = default_level,
+        std::pmr::memory_resource *resource =
+            std::pmr::get_default_resource());
+
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    ~compressor() override;
+
+    //* =====================================================================
+    /// \brief Returns the level at which data is compressed.
+    //* =====================================================================
+    [[nodiscard]] int level() const noexcept;
+
+    //* =====================================================================
+    /// \brief Sets when compressed data is flushed.  The threshold is the
+    /// number of bytes that may be written without a flush, and is only
+    /// used by the threshold policy.
+    //* =====================================================================
+    void set_flush_policy(
+        flush_policy policy,
+        std::size_t threshold = default_flush_threshold) noexcept;
+
+private:
+    //* =====================================================================
+    /// \brief A hook for when the transformation stream starts.
+    //* =====================================================================
+    void do_start() override;
+
+    //* =====================================================================
+    /// \brief A hook for when transformation stream ends.
+    //* =====================================================================
+    void do_finish(continuation const &cont) override;
+
+    //* =====================================================================
+    /// \brief A hook for when the transformation stream is flushed.
+    //* =====================================================================
+    void do_flush(continuation const &cont) override;
+
+    //* =====================================================================
+    /// \brief Transform the given bytes, sending the transformed data
+    /// to the continuation.
+    ///
+    /// \returns an empty subsequence, since all of the data is compressed.
+    //* =====================================================================
+    telnetpp::bytes transform_chunk(
+        telnetpp::bytes data, continuation const &cont) override;
+
+    struct impl;
+    std::unique_ptr<impl> pimpl_;
+};
+
+}  // namespace telnetpp::options::mccp::zstd
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "telnetpp/options/mccp/codec.hpp"
+
+#include <memory>
+#include <memory_resource>
+
+namespace telnetpp::options::mccp::zstd {
+
+//* =========================================================================
+/// \brief Represents an object that can decompress Zstandard frames.  The
+/// end of a frame ends the transformation stream.
+///
+/// As with the zlib decompressor, the output of each call is passed on in
+/// one piece unless it exceeds 256KiB, in which case it is passed on in
+/// pieces of at most that size.
+//* =========================================================================
+class TELNETPP_EXPORT decompressor  // NOLINT
+  : public telnetpp::options::mccp::codec
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    ///
+    /// The buffer into which data is decompressed is allocated from the
+    /// given resource, which must outlive the decompressor.  Zstandard's
+    /// own context is allocated by Zstandard.
+    //* =====================================================================
+    explicit decompressor(
+        std::pmr::memory_resource *resource =
+            std::pmr::get_default_resource());
+
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    ~decompressor() override;
+
+private:
+    //* =====================================================================
+    /// \brief A hook for when the transformation stream starts.
+    //* =====================================================================
+    void do_start() override;
+
+    //* =====================================================================
+    /// \brief A hook for when transformation stream ends.
+    //* =====================================================================
+    void do_finish(continuation const &cont) override;
+
+    //* =====================================================================
+    /// \brief Transform the given bytes, sending the transformed data
+    /// to the continuation, along with a boolean indicating whether the
+    /// frame was ended inline.
+    ///
+    /// \returns a subsequence of the bytes that were not transformed due to
+    /// the frame ending.
+    ///
+    /// \throws telnetpp::options::mccp::corrupted_stream_error if the data
+    /// was malformed.
+    //* =====================================================================
+    telnetpp::bytes transform_chunk(
+        telnetpp::bytes data, continuation const &cont) override;
+
+    struct impl;
+    std::unique_ptr<impl> pimpl_;
+};
+
+}  // namespace telnetpp::options::mccp::zstd
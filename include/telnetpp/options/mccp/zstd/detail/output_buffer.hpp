@@ -0,0 +1,42 @@
+#pragma once
+
+#include "telnetpp/options/mccp/detail/output_buffer.hpp"
+
+#include <zstd.h>
+
+#include <cstddef>
+
+namespace telnetpp::options::mccp::detail {
+
+//* =========================================================================
+/// \brief Directs a Zstandard output buffer at an output_buffer.
+//* =========================================================================
+template <>
+struct output_cursor_traits<ZSTD_outBuffer>
+{
+    static void point(
+        ZSTD_outBuffer &out,
+        telnetpp::byte *region,
+        std::size_t size,
+        std::size_t used) noexcept
+    {
+        out.dst = region;
+        out.size = size;
+        out.pos = used;
+    }
+
+    static std::size_t used(
+        ZSTD_outBuffer const &out,
+        telnetpp::byte const * /*region*/) noexcept
+    {
+        return out.pos;
+    }
+};
+
+}  // namespace telnetpp::options::mccp::detail
+
+namespace telnetpp::options::mccp::zstd::detail {
+
+using output_buffer = mccp::detail::output_buffer<ZSTD_outBuffer>;
+
+}  // namespace telnetpp::options::mccp::zstd::detail
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "telnetpp/client_option.hpp"
+#include "telnetpp/options/mccp/codec.hpp"
+
+namespace telnetpp::options::mccp3 {
+
+//* =========================================================================
+/// \brief A client option responsible for negotiating the client part of the
+/// MCCP3 protocol.  This is the side that sends compressed data.
+//* =========================================================================
+class TELNETPP_EXPORT client : public telnetpp::client_option
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    ///
+    /// The codec is started when compression begins, and so must be used
+    /// to compress all data written by the session.  When compression ends,
+    /// the end of the compressed stream is passed to send, which must
+    /// write it to the connection just as the application does with the
+    /// output of the codec.  It cannot be written through the session,
+    /// which would escape it and pass it through the codec again.
+    //* =====================================================================
+    client(
+        telnetpp::session &sess,
+        mccp::codec &cdc,
+        mccp::codec::continuation send);
+
+    //* =====================================================================
+    /// \brief Requests that compression begins.
+    /// If the option is active, then this sends the sequence that begins
+    /// compression, and starts the codec.  Otherwise, this does nothing.
+    ///
+    /// The sequence must reach the codec before the codec is started, so
+    /// the session must not be corked when this is called.
+    //* =====================================================================
+    void start_compression();
+
+    //* =====================================================================
+    /// \brief Requests that compression ends.
+    /// If compression is active, then this finishes the codec, which ends
+    /// the compressed stream.  Compression is also ended if the option is
+    /// deactivated.  Otherwise, this does nothing.
+    //* =====================================================================
+    void finish_compression();
+
+private:
+    //* =====================================================================
+    /// \brief Called when a subnegotiation is received while the option is
+    /// active.  Override for option-specific functionality.
+    //* =====================================================================
+    void handle_subnegotiation(telnetpp::bytes data) override;
+
+    mccp::codec &codec_;
+    mccp::codec::continuation send_;
+    bool compression_active_;
+};
+
+}  // namespace telnetpp::options::mccp3
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+
+//* =========================================================================
+/// \namespace telnetpp::options::mccp3
+/// \brief An implementation of version 3 of the Mud Client Compression
+/// Protocol.
+/// \par Overview
+/// Where MCCP (version 2) compresses data sent from the server to the
+/// client, MCCP3 compresses data sent from the client to the server.  The
+/// server offers to accept compressed data by sending IAC WILL MCCP3.  Once
+/// the client has agreed, it can begin compression at any time by sending
+/// IAC SB MCCP3 IAC SE, after which all of its data is compressed.
+/// Compression is ended by ending the compressed stream.
+/// \par Codec
+/// The options control when compression and decompression should happen,
+/// and the work is done by the same telnetpp::options::mccp::codec objects
+/// that are used for MCCP.  A telnetpp::options::mccp3::server uses a
+/// decompressor for the data it receives, and a
+/// telnetpp::options::mccp3::client uses a compressor for the data it
+/// sends.
+/// \par Usage - Server
+/// \code
+///     telnetpp::options::mccp::zlib::decompressor decompressor;
+///     telnetpp::options::mccp3::server mccp3_server{session, decompressor};
+///     session.install(mccp3_server);
+///     mccp3_server.activate();
+/// \endcode
+/// Received data must then be passed through the decompressor before it is
+/// given to the session.  The decompressor passes the data through
+/// unchanged until the client begins compression.
+/// \code
+///     void my_lower_layer_read(telnetpp::bytes data)
+///     {
+///         decompressor(data, [&](telnetpp::bytes plain, bool) {
+///             my_session_receive(plain);
+///         });
+///     }
+/// \endcode
+/// \par Usage - Client
+/// \code
+///     telnetpp::options::mccp::zlib::compressor compressor;
+///     telnetpp::options::mccp3::client mccp3_client{
+///         session, compressor, [&](telnetpp::bytes data, bool) {
+///             my_lower_layer_write(data);
+///         }};
+///     session.install(mccp3_client);
+/// \endcode
+/// Once the option is active, compression is begun with start_compression(),
+/// and data written by the session must be passed through the compressor
+/// before it is sent.
+/// \see https://mudstandards.org/mud/mccp
+//* =========================================================================
+
+namespace telnetpp::options::mccp3::detail {
+
+inline constexpr option_type const option = 87;
+
+}
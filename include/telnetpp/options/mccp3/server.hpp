@@ -0,0 +1,36 @@
+#pragma once
+
+#include "telnetpp/server_option.hpp"
+
+namespace telnetpp::options::mccp {
+class codec;
+}
+
+namespace telnetpp::options::mccp3 {
+
+//* =========================================================================
+/// \brief A server option responsible for negotiating the server part of the
+/// MCCP3 protocol.  This is the side that receives compressed data.
+//* =========================================================================
+class TELNETPP_EXPORT server : public telnetpp::server_option
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    ///
+    /// The codec is started when the client begins compression, and so
+    /// must be used to decompress all data received by the session.
+    //* =====================================================================
+    explicit server(telnetpp::session &sess, mccp::codec &cdc);
+
+private:
+    //* =====================================================================
+    /// \brief Called when a subnegotiation is received while the option is
+    /// active.  Override for option-specific functionality.
+    //* =====================================================================
+    void handle_subnegotiation(telnetpp::bytes data) override;
+
+    mccp::codec &codec_;
+};
+
+}  // namespace telnetpp::options::mccp3
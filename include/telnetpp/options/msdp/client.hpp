@@ -1,7 +1,11 @@
 #pragma once
 
 #include "telnetpp/client_option.hpp"
+#include "telnetpp/detail/subnegotiation_buffer.hpp"
+#include "telnetpp/options/msdp/detail/view_decoder.hpp"
+#include "telnetpp/options/msdp/name_table.hpp"
 #include "telnetpp/options/msdp/variable.hpp"
+#include "telnetpp/options/msdp/variable_view.hpp"
 
 namespace telnetpp::options::msdp {
 
@@ -26,7 +30,35 @@ public:
     /// \brief Register for a signal whenever a list of variables is received
     /// from the remote server.
     //* =====================================================================
-    boost::signals2::signal<void(variable const &)> on_receive;
+    telnetpp::signal<void(variable const &)> on_receive;
+
+    //* =====================================================================
+    /// \fn on_receive_view
+    /// \brief Register for a signal whenever a variable is received from
+    /// the remote server, as a view that is valid only for the duration
+    /// of the signal.
+    ///
+    /// Receiving a variable this way allocates nothing.  If on_receive has
+    /// no slots, it is not emitted, so no owning copy is made.
+    //* =====================================================================
+    telnetpp::signal<void(variable_view const &)> on_receive_view;
+
+    //* =====================================================================
+    /// \brief Sets the table in which the names of received variables are
+    /// looked up, so that each view emitted by on_receive_view carries the
+    /// identifier of its name.  The table must outlive the client.
+    //* =====================================================================
+    void set_name_table(name_table names) noexcept;
+
+    //* =====================================================================
+    /// \fn on_oversized_message
+    /// \brief Register for a signal whenever a message from the
+    /// remote server is discarded because it exceeds the session's
+    /// subnegotiation limit.  This is only known under the error and stream
+    /// overflow policies; under the discard policy, such messages are
+    /// dropped silently.
+    //* =====================================================================
+    telnetpp::signal<void()> on_oversized_message;
 
 private:
     //* =====================================================================
@@ -34,6 +66,16 @@ private:
     /// active.  Override for option-specific functionality.
     //* =====================================================================
     void handle_subnegotiation(telnetpp::bytes data) override;
+
+    //* =====================================================================
+    /// \brief Called when an event for a subnegotiation that was too large
+    /// to be delivered whole is received while the option is active.
+    //* =====================================================================
+    void handle_subnegotiation_event(
+        telnetpp::subnegotiation_event const &event) override;
+
+    detail::view_decoder decoder_;
+    telnetpp::detail::subnegotiation_buffer send_buffer_;
 };
 
 }  // namespace telnetpp::options::msdp
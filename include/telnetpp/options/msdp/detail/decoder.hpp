@@ -6,6 +6,94 @@
 
 namespace telnetpp::options::msdp::detail {
 
+//* =========================================================================
+/// \brief A receiver of the events that are found while decoding MSDP.
+///
+/// Each variable begins with on_var_name and ends with on_var_end.  In
+/// between is its value: either a string, an array whose elements are
+/// between on_array_begin and on_array_end, or a table whose variables are
+/// between on_table_begin and on_table_end.  A variable whose value never
+/// arrived has only its name.
+///
+/// The bytes passed to each event are views of the decoded data.  Every
+/// event does nothing by default, so that a handler need only override
+/// the events that it is interested in.
+//* =========================================================================
+class TELNETPP_EXPORT decode_handler
+{
+public:
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    virtual ~decode_handler() = default;
+
+    //* =====================================================================
+    /// \brief Called when a variable begins, with its name.
+    //* =====================================================================
+    virtual void on_var_name(telnetpp::bytes /*name*/)
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Called with the value of a variable whose value is a string.
+    //* =====================================================================
+    virtual void on_string_value(telnetpp::bytes /*value*/)
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Called when the value of a variable is an array.
+    //* =====================================================================
+    virtual void on_array_begin()
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Called with each element of an array, in order.
+    //* =====================================================================
+    virtual void on_array_element(telnetpp::bytes /*element*/)
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Called after the last element of an array.
+    //* =====================================================================
+    virtual void on_array_end()
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Called when the value of a variable is a table.
+    //* =====================================================================
+    virtual void on_table_begin()
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Called after the last variable of a table.
+    //* =====================================================================
+    virtual void on_table_end()
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Called when a variable ends, after its value.
+    //* =====================================================================
+    virtual void on_var_end()
+    {
+    }
+};
+
+//* =========================================================================
+/// \brief Decode a byte stream, passing each part of each variable to the
+/// handler as it is found.  No variable is built, and nothing is allocated.
+///
+/// Anything that is still open when the data ends is ended then, so that
+/// every begin event has its end event.
+//* =========================================================================
+TELNETPP_EXPORT
+void decode(telnetpp::bytes data, decode_handler &handler);
+
 //* =========================================================================
 /// \brief Decode a byte stream into a list of MSDP variables.
 //* =========================================================================
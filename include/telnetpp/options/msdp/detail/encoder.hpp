@@ -2,6 +2,9 @@
 
 #include "telnetpp/options/msdp/variable.hpp"
 
+#include <cstddef>
+#include <span>
+
 namespace telnetpp::options::msdp::detail {
 
 //* =========================================================================
@@ -12,6 +15,50 @@ void encode_variable(
     telnetpp::options::msdp::variable const &var,
     telnetpp::byte_storage &storage);
 
+//* =========================================================================
+/// \brief Returns the number of bytes that encode_variable appends for the
+/// given variable.
+//* =========================================================================
+TELNETPP_EXPORT
+std::size_t encoded_size(telnetpp::options::msdp::variable const &var);
+
+//* =========================================================================
+/// \brief Returns the number of bytes in a complete MSDP subnegotiation
+/// that carries the given variable, from IAC SB to IAC SE, including any
+/// IAC bytes in the content that must be doubled.
+//* =========================================================================
+TELNETPP_EXPORT
+std::size_t subnegotiation_size(telnetpp::options::msdp::variable const &var);
+
+//* =========================================================================
+/// \brief Encodes the given variable as a complete MSDP subnegotiation,
+/// with any IAC bytes in its content doubled, so that it can be written
+/// exactly as it is.  The buffer must be at least subnegotiation_size(var)
+/// bytes long.  Returns the part of the buffer that was written.
+//* =========================================================================
+TELNETPP_EXPORT
+telnetpp::bytes encode_subnegotiation(
+    telnetpp::options::msdp::variable const &var,
+    std::span<telnetpp::byte> buffer);
+
+//* =========================================================================
+/// \brief Returns the number of bytes in a complete MSDP subnegotiation
+/// that carries all of the given variables.
+//* =========================================================================
+TELNETPP_EXPORT
+std::size_t subnegotiation_size(
+    std::span<telnetpp::options::msdp::variable const *const> vars);
+
+//* =========================================================================
+/// \brief Encodes the given variables, in order, as a single complete MSDP
+/// subnegotiation.  The buffer must be at least subnegotiation_size(vars)
+/// bytes long.  Returns the part of the buffer that was written.
+//* =========================================================================
+TELNETPP_EXPORT
+telnetpp::bytes encode_subnegotiation(
+    std::span<telnetpp::options::msdp::variable const *const> vars,
+    std::span<telnetpp::byte> buffer);
+
 //* =========================================================================
 /// \brief Encode a list of MSDP variables into a sequence of bytes.
 //* =========================================================================
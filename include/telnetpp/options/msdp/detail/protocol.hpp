@@ -21,6 +21,11 @@
 /// Data is transmitted using a telnetpp::options::msdp::variable.  These
 /// can be sent using your option's send() function, or you can register for
 /// changes using the on_receive signal.
+/// \par
+/// Messages are only handled whole, so one that is larger than the
+/// session's subnegotiation limit is never received.  Under the error and
+/// stream overflow policies, the on_oversized_message signal is emitted
+/// once for each such message instead.
 /// \see http://tintin.sourceforge.net/msdp/
 //* =========================================================================
 namespace telnetpp::options::msdp::detail {
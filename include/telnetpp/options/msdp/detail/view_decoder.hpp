@@ -0,0 +1,89 @@
+#pragma once
+
+#include "telnetpp/options/msdp/variable_view.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace telnetpp::options::msdp::detail {
+
+//* =========================================================================
+/// \brief Decodes a byte stream into a list of MSDP variable views.
+///
+/// This decodes exactly as telnetpp::options::msdp::detail::decode does,
+/// but instead of building each variable from owning strings and vectors,
+/// names and strings are views of the decoded data, and arrays and tables
+/// are views of storage that the decoder keeps and reuses.  Once that
+/// storage has grown to suit the data, decoding allocates nothing.
+///
+/// The views passed to the continuation are valid until the decoder is
+/// next used or the data is destroyed, whichever is first.
+//* =========================================================================
+class TELNETPP_EXPORT view_decoder
+{
+public:
+    using continuation = std::function<void(variable_view const &)>;
+
+    //* =====================================================================
+    /// \brief Decodes the data, passing each variable to the continuation.
+    ///
+    /// The continuation may use the decoder again, in which case the
+    /// inner use decodes with storage of its own.
+    //* =====================================================================
+    void operator()(telnetpp::bytes data, continuation const &cont);
+
+    //* =====================================================================
+    /// \brief Sets the table in which the name of each decoded variable is
+    /// looked up to find its identifier.  The table must outlive its use
+    /// by the decoder.
+    //* =====================================================================
+    void set_name_table(name_table names) noexcept;
+
+private:
+    enum class state
+    {
+        idle,
+        name,
+        value,
+        array,
+    };
+
+    // A variable that has been opened, but not yet closed.
+    struct frame
+    {
+        variable_view var;
+        std::size_t first_child;
+        std::size_t first_element;
+    };
+
+    void decode(telnetpp::bytes data, continuation const &cont);
+    void parse(std::size_t index, continuation const &cont);
+    void open_variable(std::size_t index);
+    void close_variable(continuation const &cont);
+    void end_name(std::size_t index);
+    void end_string(std::size_t index);
+    void end_element(std::size_t index);
+    variable_view seal(frame const &closed);
+    void finish(continuation const &cont);
+
+    name_table names_;
+    telnetpp::bytes data_;
+    state state_{state::idle};
+    std::size_t start_{0};
+    bool in_element_{false};
+    bool decoding_{false};
+
+    // The arrays and tables of closed variables.  These are reserved to
+    // the largest size that they can reach before decoding, so that views
+    // of them remain valid as they grow.
+    std::vector<variable_view> children_;
+    std::vector<string_value_view> elements_;
+
+    // The children of the tables that are open, and the open variables
+    // themselves.
+    std::vector<variable_view> open_children_;
+    std::vector<frame> frames_;
+};
+
+}  // namespace telnetpp::options::msdp::detail
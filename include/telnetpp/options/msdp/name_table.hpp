@@ -0,0 +1,341 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+namespace telnetpp::options::msdp {
+
+//* =========================================================================
+/// \brief The identifier of a variable name in a name table.  This is the
+/// position of the name in the list from which the table was made.
+//* =========================================================================
+using name_id = std::uint16_t;
+
+//* =========================================================================
+/// \brief The identifier of any name that is not in a name table.
+//* =========================================================================
+inline constexpr name_id unknown_name = std::numeric_limits<name_id>::max();
+
+namespace detail {
+
+//* =========================================================================
+/// \exclude
+/// \brief Hashes a name with FNV-1a.  This is used for both strings and
+/// bytes, so that a table can be made at compile time from strings and
+/// used at run time with received bytes.
+//* =========================================================================
+template <typename Range>
+constexpr std::uint32_t hash_name(Range const &name) noexcept
+{
+    std::uint32_t result = 2166136261U;
+
+    for (auto const ch : name)
+    {
+        result ^= static_cast<std::uint8_t>(ch);
+        result *= 16777619U;
+    }
+
+    return result;
+}
+
+//* =========================================================================
+/// \exclude
+/// \brief Mixes the hash of a name with the displacement of its bucket to
+/// choose its slot.
+//* =========================================================================
+constexpr std::uint32_t displace_hash(
+    std::uint32_t hash, std::uint32_t displacement) noexcept
+{
+    hash ^= displacement * 0x9E3779B9U;
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6BU;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+}  // namespace detail
+
+//* =========================================================================
+/// \brief A view of a set of MSDP variable names, each of which has a
+/// small integer identifier, so that a received variable can be dispatched
+/// with a switch instead of by comparing its name with each in turn.
+///
+/// A name_table refers to storage that belongs to a static_name_table,
+/// which must outlive it.  A default-constructed name_table is empty.
+/// \see telnetpp::options::msdp::make_name_table
+//* =========================================================================
+class TELNETPP_EXPORT name_table
+{
+public:
+    //* =====================================================================
+    /// \brief Constructs an empty table, in which no name is found.
+    //* =====================================================================
+    constexpr name_table() noexcept = default;
+
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    constexpr name_table(
+        std::span<std::string_view const> names,
+        std::span<std::uint32_t const> displacements,
+        std::span<name_id const> slots) noexcept
+      : names_{names}, displacements_{displacements}, slots_{slots}
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Returns the identifier of the given name, or unknown_name if
+    /// it is not in the table.  This hashes the name once and compares it
+    /// with at most one name in the table.
+    //* =====================================================================
+    [[nodiscard]] name_id find(telnetpp::bytes name) const noexcept;
+
+    //* =====================================================================
+    /// \brief Returns the names in the table, in order of identifier.
+    //* =====================================================================
+    [[nodiscard]] constexpr std::span<std::string_view const> names()
+        const noexcept
+    {
+        return names_;
+    }
+
+private:
+    std::span<std::string_view const> names_;
+    std::span<std::uint32_t const> displacements_;
+    std::span<name_id const> slots_;
+};
+
+//* =========================================================================
+/// \brief A table of N variable names with a perfect hash, so that looking
+/// up a name costs a single hash and comparison however many names there
+/// are.  The hash is found when the table is constructed, which happens at
+/// compile time if the table is constexpr.
+///
+/// \par Usage
+/// \code
+/// static constexpr auto names =
+///     msdp::make_name_table("HEALTH", "MANA", "ROOM");
+///
+/// server.set_name_table(names);
+/// server.on_receive_view.connect([](msdp::variable_view const &view) {
+///     switch (view.id_)
+///     {
+///         case names.id_of("HEALTH"): ...
+///         case names.id_of("MANA"): ...
+///         default: ...
+///     }
+/// });
+/// \endcode
+//* =========================================================================
+template <std::size_t N>
+class static_name_table
+{
+public:
+    static_assert(N < unknown_name, "too many names for a name_id");
+
+    //* =====================================================================
+    /// \brief Constructs the table from the given names.  The identifier of
+    /// each name is its position in the list.
+    /// \throws std::invalid_argument if a name appears more than once.  In
+    /// a constant expression, this is a compile-time error.
+    //* =====================================================================
+    constexpr explicit static_name_table(
+        std::array<std::string_view, N> const &names)
+      : names_{names}
+    {
+        build();
+    }
+
+    //* =====================================================================
+    /// \brief Returns the identifier of a name, which must be in the table.
+    /// This is intended for case labels.
+    /// \throws std::invalid_argument if the name is not in the table.  In a
+    /// constant expression, this is a compile-time error.
+    //* =====================================================================
+    [[nodiscard]] constexpr name_id id_of(std::string_view name) const
+    {
+        auto const id = find_id(name);
+
+        if (id == unknown_name)
+        {
+            throw std::invalid_argument("name is not in the name table");
+        }
+
+        return id;
+    }
+
+    //* =====================================================================
+    /// \brief Returns a view of the table.  The view refers to the table,
+    /// and so cannot be taken of a temporary.
+    //* =====================================================================
+    [[nodiscard]] constexpr name_table table() const & noexcept
+    {
+        return {names_, displacements_, slots_};
+    }
+
+    name_table table() const && = delete;
+
+    //* =====================================================================
+    /// \brief Converts to a view of the table.
+    //* =====================================================================
+    constexpr operator name_table() const & noexcept  // NOLINT
+    {
+        return table();
+    }
+
+    operator name_table() const && = delete;
+
+private:
+    // Names are first sorted into buckets by hash.  The names in each
+    // bucket are then given slots by a displacement that is chosen for
+    // that bucket, so that no two names share a slot.  With twice as many
+    // slots as names, a displacement is quickly found for every bucket.
+    static constexpr std::size_t bucket_count = std::bit_ceil(N == 0 ? 1 : N);
+    static constexpr std::size_t slot_count = bucket_count * 2;
+    static constexpr std::uint32_t max_displacement = 1U << 20;
+
+    constexpr void build()
+    {
+        for (std::size_t lhs = 0; lhs < N; ++lhs)
+        {
+            for (std::size_t rhs = lhs + 1; rhs < N; ++rhs)
+            {
+                if (names_[lhs] == names_[rhs])
+                {
+                    throw std::invalid_argument(
+                        "a name appears twice in the name table");
+                }
+            }
+        }
+
+        std::array<std::uint32_t, N> hashes{};
+        std::array<std::size_t, N> order{};
+
+        for (std::size_t index = 0; index < N; ++index)
+        {
+            hashes[index] = detail::hash_name(names_[index]);
+            order[index] = index;
+        }
+
+        auto const bucket_of = [&hashes](std::size_t index) {
+            return hashes[index] & (bucket_count - 1);
+        };
+
+        std::array<std::size_t, bucket_count> bucket_sizes{};
+
+        for (std::size_t index = 0; index < N; ++index)
+        {
+            ++bucket_sizes[bucket_of(index)];
+        }
+
+        // The largest buckets are the hardest to place, so they are placed
+        // first, while most slots are free.
+        std::sort(
+            order.begin(),
+            order.end(),
+            [&](std::size_t lhs, std::size_t rhs) {
+                auto const lhs_bucket = bucket_of(lhs);
+                auto const rhs_bucket = bucket_of(rhs);
+
+                return bucket_sizes[lhs_bucket] != bucket_sizes[rhs_bucket]
+                         ? bucket_sizes[lhs_bucket] > bucket_sizes[rhs_bucket]
+                         : lhs_bucket < rhs_bucket;
+            });
+
+        slots_.fill(unknown_name);
+
+        for (std::size_t first = 0; first < N;)
+        {
+            auto const bucket = bucket_of(order[first]);
+            auto const last = first + bucket_sizes[bucket];
+            displacements_[bucket] = place(hashes, order, first, last);
+            first = last;
+        }
+    }
+
+    // Finds a displacement that gives each of the names order[first, last)
+    // a free slot of its own, and gives them those slots.
+    constexpr std::uint32_t place(
+        std::array<std::uint32_t, N> const &hashes,
+        std::array<std::size_t, N> const &order,
+        std::size_t first,
+        std::size_t last)
+    {
+        for (std::uint32_t displacement = 0;
+             displacement < max_displacement;
+             ++displacement)
+        {
+            std::size_t placed = first;
+
+            for (; placed < last; ++placed)
+            {
+                auto &slot = slot_for(hashes[order[placed]], displacement);
+
+                if (slot != unknown_name)
+                {
+                    break;
+                }
+
+                slot = static_cast<name_id>(order[placed]);
+            }
+
+            if (placed == last)
+            {
+                return displacement;
+            }
+
+            // Undo the partial placement before trying the next one.
+            for (auto index = first; index < placed; ++index)
+            {
+                slot_for(hashes[order[index]], displacement) = unknown_name;
+            }
+        }
+
+        throw std::invalid_argument("no perfect hash found for the names");
+    }
+
+    constexpr name_id &slot_for(
+        std::uint32_t hash, std::uint32_t displacement) noexcept
+    {
+        return slots_
+            [detail::displace_hash(hash, displacement) & (slot_count - 1)];
+    }
+
+    [[nodiscard]] constexpr name_id find_id(std::string_view name) const
+    {
+        auto const hash = detail::hash_name(name);
+        auto const displacement = displacements_[hash & (bucket_count - 1)];
+        auto const id =
+            slots_[detail::displace_hash(hash, displacement)
+                   & (slot_count - 1)];
+
+        return id != unknown_name && names_[id] == name ? id : unknown_name;
+    }
+
+    std::array<std::string_view, N> names_;
+    std::array<std::uint32_t, bucket_count> displacements_{};
+    std::array<name_id, slot_count> slots_{};
+};
+
+//* =========================================================================
+/// \brief Makes a table of the given variable names, whose identifiers are
+/// their positions in the list.
+//* =========================================================================
+template <typename... Names>
+constexpr auto make_name_table(Names const &...names)
+{
+    return static_name_table<sizeof...(Names)>{
+        std::array<std::string_view, sizeof...(Names)>{
+            std::string_view{names}...}};
+}
+
+}  // namespace telnetpp::options::msdp
@@ -1,12 +1,31 @@
 #pragma once
 
+#include "telnetpp/detail/subnegotiation_buffer.hpp"
+#include "telnetpp/options/msdp/detail/view_decoder.hpp"
+#include "telnetpp/options/msdp/name_table.hpp"
 #include "telnetpp/options/msdp/variable.hpp"
+#include "telnetpp/options/msdp/variable_view.hpp"
 #include "telnetpp/server_option.hpp"
 
+#include <functional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 namespace telnetpp::options::msdp {
 
 //* =========================================================================
 /// \brief An implementation of the server side of an MSDP Telnet option.
+///
+/// As well as sending variables directly, the server can hold a set of
+/// variables that the client may ask for with the MSDP LIST, REPORT,
+/// UNREPORT, SEND and RESET commands.  Once any variable has been set with
+/// set_variable(), the server answers these commands itself.  A variable
+/// that the client has asked to be reported is sent again only when its
+/// value changes, and all such changes are sent together, in a single
+/// subnegotiation, by flush_updates().  This is typically called once per
+/// game tick.
 //* =========================================================================
 class TELNETPP_EXPORT server : public telnetpp::server_option
 {
@@ -14,19 +33,72 @@ public:
     //* =====================================================================
     /// \brief Constructor
     //* =====================================================================
-    explicit server(telnetpp::session &sess) noexcept;
+    explicit server(telnetpp::session &sess);
 
     //* =====================================================================
     /// \brief Send a variables to the remote server.
     //* =====================================================================
     void send(variable const &var);
 
+    //* =====================================================================
+    /// \brief Sets the value of a variable that the client may ask to be
+    /// sent or reported.  If the variable is reported and its value has
+    /// changed, then it is sent by the next flush_updates().
+    //* =====================================================================
+    void set_variable(variable var);
+
+    //* =====================================================================
+    /// \brief Deletes a variable, so that it is no longer reported.
+    //* =====================================================================
+    void delete_variable(telnetpp::bytes name);
+
+    //* =====================================================================
+    /// \brief Returns whether the client has asked for the named variable
+    /// to be reported.
+    //* =====================================================================
+    [[nodiscard]] bool is_reported(telnetpp::bytes name) const;
+
+    //* =====================================================================
+    /// \brief Sends every reported variable that has changed since it was
+    /// last sent, all in a single subnegotiation.  Nothing is sent if no
+    /// reported variable has changed.
+    //* =====================================================================
+    void flush_updates();
+
     //* =====================================================================
     /// \fn on_receive
     /// \brief Register for a signal whenever a list of variables is received
     /// from the remote server.
     //* =====================================================================
-    boost::signals2::signal<void(variable const &)> on_receive;
+    telnetpp::signal<void(variable const &)> on_receive;
+
+    //* =====================================================================
+    /// \fn on_receive_view
+    /// \brief Register for a signal whenever a variable is received from
+    /// the remote client, as a view that is valid only for the duration
+    /// of the signal.
+    ///
+    /// Receiving a variable this way allocates nothing.  If on_receive has
+    /// no slots, it is not emitted, so no owning copy is made.
+    //* =====================================================================
+    telnetpp::signal<void(variable_view const &)> on_receive_view;
+
+    //* =====================================================================
+    /// \brief Sets the table in which the names of received variables are
+    /// looked up, so that each view emitted by on_receive_view carries the
+    /// identifier of its name.  The table must outlive the server.
+    //* =====================================================================
+    void set_name_table(name_table names) noexcept;
+
+    //* =====================================================================
+    /// \fn on_oversized_message
+    /// \brief Register for a signal whenever a message from the
+    /// remote client is discarded because it exceeds the session's
+    /// subnegotiation limit.  This is only known under the error and stream
+    /// overflow policies; under the discard policy, such messages are
+    /// dropped silently.
+    //* =====================================================================
+    telnetpp::signal<void()> on_oversized_message;
 
 private:
     //* =====================================================================
@@ -34,6 +106,71 @@ private:
     /// active.  Override for option-specific functionality.
     //* =====================================================================
     void handle_subnegotiation(telnetpp::bytes data) override;
+
+    //* =====================================================================
+    /// \brief Called when an event for a subnegotiation that was too large
+    /// to be delivered whole is received while the option is active.
+    //* =====================================================================
+    void handle_subnegotiation_event(
+        telnetpp::subnegotiation_event const &event) override;
+
+    //* =====================================================================
+    /// \brief Answers a received variable if it is an MSDP command.
+    //* =====================================================================
+    void handle_command(variable_view const &command);
+
+    //* =====================================================================
+    /// \brief Sends each of the given variables, in order, in a single
+    /// subnegotiation.
+    //* =====================================================================
+    void send_all(std::span<variable const *const> vars);
+
+    //* =====================================================================
+    /// \brief Stops reporting all variables.
+    //* =====================================================================
+    void unreport_all();
+
+    struct reportable
+    {
+        variable var_;
+        bool reported_{false};
+        bool pending_{false};
+    };
+
+    // Variables are looked up by name on every set_variable(), usually
+    // many times a tick, so they are hashed rather than ordered.
+    struct name_hash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(telnetpp::bytes name) const noexcept
+        {
+            return std::hash<std::string_view>{}(std::string_view{
+                reinterpret_cast<char const *>(name.data()),  // NOLINT
+                name.size()});
+        }
+    };
+
+    struct name_equal
+    {
+        using is_transparent = void;
+
+        bool operator()(telnetpp::bytes lhs, telnetpp::bytes rhs) const noexcept
+        {
+            return telnetpp::bytes_equal(lhs, rhs);
+        }
+    };
+
+    detail::view_decoder decoder_;
+    telnetpp::detail::subnegotiation_buffer send_buffer_;
+    std::unordered_map<
+        telnetpp::byte_storage,
+        reportable,
+        name_hash,
+        name_equal>
+        variables_;
+    std::vector<reportable *> pending_;
+    std::vector<variable const *> batch_;
 };
 
 }  // namespace telnetpp::options::msdp
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "telnetpp/options/msdp/name_table.hpp"
+#include "telnetpp/options/msdp/variable.hpp"
+
+#include <span>
+#include <variant>
+
+namespace telnetpp::options::msdp {
+
+struct variable_view;
+
+using string_value_view = telnetpp::bytes;
+using array_value_view = std::span<string_value_view const>;
+using table_value_view = std::span<variable_view const>;
+
+//* =========================================================================
+/// \brief A variant that can either be a view of a string, of an array of
+/// strings, or of an array of telnetpp::options::msdp::variable_view.
+//* =========================================================================
+using value_view = std::variant<
+    string_value_view,
+    array_value_view,
+    table_value_view>;
+
+//* =========================================================================
+/// \brief A non-owning counterpart of telnetpp::options::msdp::variable.
+///
+/// Names and strings are views of the data from which the variable was
+/// decoded, and arrays and tables are views of storage that belongs to the
+/// decoder.  A variable_view is therefore only valid for as long as both of
+/// those are; to keep a variable any longer, convert it with to_variable().
+/// \see telnetpp::options::msdp::detail::view_decoder
+/// \see telnetpp::options::msdp::name_table
+//* =========================================================================
+struct TELNETPP_EXPORT variable_view
+{
+    string_value_view name_;
+    value_view value_;
+
+    /// The identifier of the name in the decoder's name table, or
+    /// unknown_name if it is not in the table.
+    name_id id_{unknown_name};
+};
+
+//* =========================================================================
+/// \brief Returns an owning copy of the variable that is viewed.
+//* =========================================================================
+TELNETPP_EXPORT
+variable to_variable(variable_view const &view);
+
+}  // namespace telnetpp::options::msdp
@@ -1,8 +1,7 @@
 #pragma once
 
 #include "telnetpp/client_option.hpp"
-
-#include <boost/signals2.hpp>
+#include "telnetpp/signal.hpp"
 
 namespace telnetpp::options::naws {
 
@@ -19,7 +18,7 @@ public:
     //* =====================================================================
     explicit client(telnetpp::session &sess) noexcept;
 
-    boost::signals2::signal<void(window_dimension, window_dimension)>
+    telnetpp::signal<void(window_dimension, window_dimension)>
         on_window_size_changed;  // NOLINT
 
 private:
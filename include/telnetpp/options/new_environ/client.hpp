@@ -29,7 +29,7 @@ public:
     /// \param cont a continuation to pass any Telnet response that may
     ///        occur as a result of receiving this response.
     //* =====================================================================
-    boost::signals2::signal<void(response const &rsp)> on_variable_changed;
+    telnetpp::signal<void(response const &rsp)> on_variable_changed;
 
 private:
     //* =====================================================================
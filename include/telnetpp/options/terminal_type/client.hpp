@@ -1,8 +1,7 @@
 #pragma once
 
 #include "telnetpp/client_option.hpp"
-
-#include <boost/signals2.hpp>
+#include "telnetpp/signal.hpp"
 
 namespace telnetpp::options::terminal_type {
 
@@ -23,7 +22,7 @@ public:
     //* =====================================================================
     void request_terminal_type();
 
-    boost::signals2::signal<void(telnetpp::bytes)> on_terminal_type;  // NOLINT
+    telnetpp::signal<void(telnetpp::bytes)> on_terminal_type;  // NOLINT
 
 private:
     //* =====================================================================
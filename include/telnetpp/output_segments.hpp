@@ -0,0 +1,138 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace telnetpp {
+
+//* =========================================================================
+/// \brief A sequence of spans of bytes that together form a block of output,
+/// suitable for passing to a scatter-gather write such as writev().
+///
+/// \par Storage
+/// Up to inline_capacity segments are held without any allocation, which is
+/// enough for a typical element or small batch of elements.  Beyond that,
+/// the segments are moved to the heap.
+///
+/// \par Lifetime
+/// The segments refer either to data passed in by the user or to static
+/// storage within the library; no bytes are copied.  Therefore, the data
+/// passed in must outlive the use of the segments.
+///
+/// \par Scatter-Gather I/O
+/// Each segment is a pointer and a size, so a POSIX iovec or a Windows
+/// WSABUF array can be filled from segments() with a simple loop.
+//* =========================================================================
+class output_segments
+{
+public:
+    static constexpr std::size_t inline_capacity = 16;
+
+    //* =====================================================================
+    /// \brief Appends a segment.  Empty segments are ignored, and a segment
+    /// that directly follows the previous one in memory is merged into it.
+    //* =====================================================================
+    constexpr void push_back(telnetpp::bytes segment)
+    {
+        if (segment.empty())
+        {
+            return;
+        }
+
+        total_size_ += segment.size();
+
+        if (size_ != 0)
+        {
+            auto &last = back();
+
+            if (last.data() + last.size() == segment.data())
+            {
+                last = telnetpp::bytes{
+                    last.data(), last.size() + segment.size()};
+                return;
+            }
+        }
+
+        if (size_ < inline_capacity)
+        {
+            inline_segments_[size_] = segment;
+        }
+        else
+        {
+            if (size_ == inline_capacity)
+            {
+                heap_segments_.assign(
+                    inline_segments_.begin(), inline_segments_.end());
+            }
+
+            heap_segments_.push_back(segment);
+        }
+
+        ++size_;
+    }
+
+    //* =====================================================================
+    /// \brief Removes all segments.  Any heap storage is retained for reuse.
+    //* =====================================================================
+    constexpr void clear() noexcept
+    {
+        heap_segments_.clear();
+        size_ = 0;
+        total_size_ = 0;
+    }
+
+    //* =====================================================================
+    /// \brief Returns the segments.
+    //* =====================================================================
+    [[nodiscard]] constexpr std::span<telnetpp::bytes const> segments()
+        const noexcept
+    {
+        if (size_ <= inline_capacity)
+        {
+            return {inline_segments_.data(), size_};
+        }
+
+        return heap_segments_;
+    }
+
+    //* =====================================================================
+    /// \brief Returns the number of segments.
+    //* =====================================================================
+    [[nodiscard]] constexpr std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether there are no segments.
+    //* =====================================================================
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    //* =====================================================================
+    /// \brief Returns the total number of bytes across all segments.
+    //* =====================================================================
+    [[nodiscard]] constexpr std::size_t total_size() const noexcept
+    {
+        return total_size_;
+    }
+
+private:
+    constexpr telnetpp::bytes &back() noexcept
+    {
+        return size_ <= inline_capacity ? inline_segments_[size_ - 1]
+                                        : heap_segments_.back();
+    }
+
+    std::array<telnetpp::bytes, inline_capacity> inline_segments_{};
+    std::vector<telnetpp::bytes> heap_segments_;
+    std::size_t size_{0};
+    std::size_t total_size_{0};
+};
+
+}  // namespace telnetpp
@@ -2,70 +2,174 @@
 
 #include "telnetpp/command.hpp"
 #include "telnetpp/core.hpp"
+#include "telnetpp/detail/find_iac.hpp"
+#include "telnetpp/detail/parser_state_machine.hpp"
 #include "telnetpp/negotiation.hpp"
 #include "telnetpp/subnegotiation.hpp"
+#include "telnetpp/subnegotiation_event.hpp"
 
-#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <cassert>
 
 namespace telnetpp {
 
+//* =========================================================================
+/// \brief A class that transforms a stream of bytes into Telnet elements.
+///
+/// \par Plain Data
+/// Where possible, plain data is emitted as a span directly into the input
+/// that was passed to the parser, so that no copy is made.  It is only when
+/// a run of plain data is interrupted by an escaped IAC IAC sequence that the
+/// data is collected in an internal buffer first.  In either case, the span
+/// is valid only for the duration of the call to the continuation.
+///
+/// \par Subnegotiations
+/// By default, subnegotiation content is buffered without limit until the
+/// terminating IAC SE is received.  A maximum size may be set, in which case
+/// any subnegotiation that exceeds it is handled according to a
+/// telnetpp::subnegotiation_overflow_policy.  For the error and stream
+/// policies, the continuation is called with telnetpp::subnegotiation_event
+/// objects.  If the continuation cannot accept those, then such
+/// subnegotiations are discarded instead.
+//* =========================================================================
 class parser final
 {
 public:
+    //* =====================================================================
+    /// \brief Sets the maximum size of a subnegotiation's content, and what
+    /// should happen to subnegotiations that exceed it.
+    //* =====================================================================
+    constexpr void set_subnegotiation_limit(
+        std::size_t max_size, subnegotiation_overflow_policy policy) noexcept
+    {
+        assert(
+            max_size != 0 || policy != subnegotiation_overflow_policy::stream);
+
+        max_subnegotiation_size_ = max_size;
+        overflow_policy_ = policy;
+    }
+
     template <typename Continuation>
     constexpr void operator()(telnetpp::bytes data, Continuation &&c)
     {
-        std::ranges::for_each(
-            data, [&](telnetpp::byte by) { parse_byte(by, c); });
+        auto current = data.begin();
+        auto const end = data.end();
+
+        while (current != end)
+        {
+            // Plain data and subnegotiation content are by far the most
+            // common states, and only an IAC byte can end them.  Therefore,
+            // whole runs of bytes in these states are consumed at once.
+            switch (state_)
+            {
+                case parsing_state::idle:
+                    current = parse_idle(current, end, c);
+                    break;
+
+                case parsing_state::subnegotiation_content:
+                    current = parse_subnegotiation_content(current, end, c);
+                    break;
+
+                default:
+                    current = parse_sequence(current, end, c);
+                    break;
+            }
+        }
 
         emit_plain_data(c);
     }
 
 private:
-    enum class parsing_state : std::uint8_t
-    {
-        state_idle,
-        state_iac,
-        state_negotiation,
-        state_subnegotiation,
-        state_subnegotiation_content,
-        state_subnegotiation_content_iac
-    };
+    using parsing_state = detail::parsing_state;
+    using parser_action = detail::parser_action;
 
-    parsing_state state_{parsing_state::state_idle};
+    parsing_state state_{parsing_state::idle};
 
+    telnetpp::bytes plain_data_view_;
     telnetpp::byte_storage plain_data_;
     telnetpp::byte_storage subnegotiation_content_;
     telnetpp::negotiation_type negotiation_type_;
     telnetpp::option_type subnegotiation_option_;
 
+    std::size_t max_subnegotiation_size_{
+        std::numeric_limits<std::size_t>::max()};
+    subnegotiation_overflow_policy overflow_policy_{
+        subnegotiation_overflow_policy::discard};
+    bool subnegotiation_overflowed_{false};
+
+    // Consumes bytes through the transition table until the parser returns
+    // to one of the states in which runs of bytes are consumed at once.
     template <typename Continuation>
-    constexpr void parse_byte(telnetpp::byte by, Continuation &&c)
+    constexpr telnetpp::bytes::iterator parse_sequence(
+        telnetpp::bytes::iterator current,
+        telnetpp::bytes::iterator end,
+        Continuation &&c)
     {
-        switch (state_)
+        auto state = state_;
+
+        do
         {
-            case parsing_state::state_idle:
-                parse_idle(by, c);
+            auto const &transition = detail::next_transition(state, *current);
+            state = transition.next_state;
+            perform_action(transition.action, current, c);
+            ++current;
+        } while (current != end && state != parsing_state::idle
+                 && state != parsing_state::subnegotiation_content);
+
+        state_ = state;
+        return current;
+    }
+
+    template <typename Continuation>
+    constexpr void perform_action(
+        parser_action action,
+        telnetpp::bytes::iterator position,
+        Continuation &&c)
+    {
+        auto const by = *position;
+
+        switch (action)
+        {
+            case parser_action::append_plain_data:
+                append_plain_data({position, 1});
                 break;
 
-            case parsing_state::state_iac:
-                parse_iac(by, c);
+            case parser_action::append_escaped_iac:
+                append_plain_data(escaped_iac);
                 break;
 
-            case parsing_state::state_negotiation:
-                parse_negotiation(by, c);
+            case parser_action::emit_command:
+                emit_plain_data(c);
+                c(telnetpp::command{by});
                 break;
 
-            case parsing_state::state_subnegotiation:
-                parse_subnegotiation(by, c);
+            case parser_action::begin_negotiation:
+                emit_plain_data(c);
+                negotiation_type_ = by;
+                break;
+
+            case parser_action::emit_negotiation:
+                c(telnetpp::negotiation{negotiation_type_, by});
+                break;
+
+            case parser_action::begin_subnegotiation:
+                emit_plain_data(c);
                 break;
 
-            case parsing_state::state_subnegotiation_content:
-                parse_subnegotiation_content(by, c);
+            case parser_action::set_subnegotiation_option:
+                subnegotiation_option_ = by;
+                subnegotiation_content_.clear();
+                subnegotiation_overflowed_ = false;
                 break;
 
-            case parsing_state::state_subnegotiation_content_iac:
-                parse_subnegotiation_content_iac(by, c);
+            case parser_action::append_subnegotiation_content:
+                append_subnegotiation_content({position, 1}, c);
+                break;
+
+            case parser_action::end_subnegotiation:
+                emit_subnegotiation(c);
                 break;
 
             default:
@@ -73,112 +177,241 @@ private:
         }
     }
 
+    // A run of plain data ends at the next IAC, and the sequence that the
+    // IAC begins is then parsed through the transition table.  A sequence
+    // that is wholly within the data is parsed without leaving this loop,
+    // so that IAC-heavy data does not return to operator() for each one.
     template <typename Continuation>
-    constexpr void parse_idle(telnetpp::byte by, Continuation &&c)
+    constexpr telnetpp::bytes::iterator parse_idle(
+        telnetpp::bytes::iterator current,
+        telnetpp::bytes::iterator end,
+        Continuation &&c)
     {
-        switch (by)
+        for (;;)
         {
-            case telnetpp::iac:
-                state_ = parsing_state::state_iac;
-                break;
+            auto const iac_position = detail::find_iac(current, end);
+            append_plain_data({current, iac_position});
 
-            default:
-                plain_data_.push_back(by);
-                break;
+            if (end - iac_position < 2)
+            {
+                if (iac_position != end)
+                {
+                    state_ = parsing_state::iac;
+                }
+
+                return end;
+            }
+
+            // No sequence takes more than two bytes after the IAC to
+            // return to a state in which runs of bytes are consumed, so the
+            // table is looked up at most twice here.
+            auto const &first = detail::next_transition(
+                parsing_state::iac, iac_position[1]);
+            perform_action(first.action, iac_position + 1, c);
+            current = iac_position + 2;
+
+            if (first.next_state == parsing_state::idle)
+            {
+                continue;
+            }
+
+            if (current == end)
+            {
+                state_ = first.next_state;
+                return end;
+            }
+
+            auto const &second =
+                detail::next_transition(first.next_state, *current);
+            perform_action(second.action, current, c);
+            state_ = second.next_state;
+            ++current;
+
+            if (state_ != parsing_state::idle)
+            {
+                return current;
+            }
         }
     }
 
     template <typename Continuation>
-    constexpr void parse_iac(telnetpp::byte by, Continuation &&c)
+    constexpr telnetpp::bytes::iterator parse_subnegotiation_content(
+        telnetpp::bytes::iterator current,
+        telnetpp::bytes::iterator end,
+        Continuation &&c)
     {
-        switch (by)
+        for (;;)
         {
-            case telnetpp::iac:
-                plain_data_.push_back(by);
-                state_ = parsing_state::state_idle;
-                break;
+            auto const iac_position = detail::find_iac(current, end);
+            append_subnegotiation_content({current, iac_position}, c);
 
-            case telnetpp::will:  // fall-through
-            case telnetpp::wont:  // fall-through
-            case telnetpp::do_:   // fall-through
-            case telnetpp::dont:
-                emit_plain_data(c);
-                negotiation_type_ = by;
-                state_ = parsing_state::state_negotiation;
-                break;
+            if (end - iac_position < 2)
+            {
+                if (iac_position != end)
+                {
+                    state_ = parsing_state::subnegotiation_content_iac;
+                }
 
-            case telnetpp::sb:
-                emit_plain_data(c);
-                state_ = parsing_state::state_subnegotiation;
-                break;
+                return end;
+            }
 
-            default:
-                emit_plain_data(c);
-                c(telnetpp::command{by});
-                state_ = parsing_state::state_idle;
-                break;
+            auto const &transition = detail::next_transition(
+                parsing_state::subnegotiation_content_iac, iac_position[1]);
+            perform_action(transition.action, iac_position + 1, c);
+            current = iac_position + 2;
+
+            if (transition.next_state != parsing_state::subnegotiation_content)
+            {
+                state_ = transition.next_state;
+                return current;
+            }
         }
     }
 
     template <typename Continuation>
-    constexpr void parse_negotiation(telnetpp::byte by, Continuation &&c)
+    static constexpr bool accepts_subnegotiation_events = std::
+        is_invocable_v<Continuation &, telnetpp::subnegotiation_event const &>;
+
+    template <typename Continuation>
+    constexpr bool streams_subnegotiations() const noexcept
     {
-        c(telnetpp::negotiation{negotiation_type_, by});
-        state_ = parsing_state::state_idle;
+        return overflow_policy_ == subnegotiation_overflow_policy::stream
+            && accepts_subnegotiation_events<Continuation>;
     }
 
     template <typename Continuation>
-    constexpr void parse_subnegotiation(telnetpp::byte by, Continuation &&c)
+    constexpr void emit_subnegotiation_event(
+        Continuation &&c,
+        subnegotiation_event::event_kind kind,
+        telnetpp::bytes content = {})
     {
-        subnegotiation_option_ = by;
-        subnegotiation_content_.clear();
-        state_ = parsing_state::state_subnegotiation_content;
+        if constexpr (accepts_subnegotiation_events<Continuation>)
+        {
+            c(telnetpp::subnegotiation_event{
+                subnegotiation_option_, kind, content});
+        }
     }
 
     template <typename Continuation>
-    constexpr void parse_subnegotiation_content(
-        telnetpp::byte by, Continuation &&c)
+    constexpr void append_subnegotiation_content(
+        telnetpp::bytes data, Continuation &&c)
     {
-        switch (by)
+        using event_kind = subnegotiation_event::event_kind;
+
+        if (subnegotiation_overflowed_
+            && !streams_subnegotiations<Continuation>())
         {
-            case telnetpp::iac:
-                state_ = parsing_state::state_subnegotiation_content_iac;
-                break;
+            return;
+        }
 
-            default:
-                subnegotiation_content_.push_back(by);
-                break;
+        while (data.size()
+               > max_subnegotiation_size_ - subnegotiation_content_.size())
+        {
+            if (!streams_subnegotiations<Continuation>())
+            {
+                // Release the storage for the discarded content so that the
+                // oversized subnegotiation cannot hold on to it.
+                subnegotiation_overflowed_ = true;
+                subnegotiation_content_.clear();
+                subnegotiation_content_.shrink_to_fit();
+                return;
+            }
+
+            if (!std::exchange(subnegotiation_overflowed_, true))
+            {
+                emit_subnegotiation_event(c, event_kind::begin);
+            }
+
+            auto const remaining_size =
+                max_subnegotiation_size_ - subnegotiation_content_.size();
+            auto const head = data.first(remaining_size);
+            subnegotiation_content_.append(head.begin(), head.end());
+            data = data.subspan(remaining_size);
+
+            emit_subnegotiation_event(
+                c, event_kind::content, subnegotiation_content_);
+            subnegotiation_content_.clear();
         }
+
+        subnegotiation_content_.append(data.begin(), data.end());
     }
 
     template <typename Continuation>
-    constexpr void parse_subnegotiation_content_iac(
-        telnetpp::byte by, Continuation &&c)
+    constexpr void emit_subnegotiation(Continuation &&c)
     {
-        switch (by)
+        using event_kind = subnegotiation_event::event_kind;
+
+        if (!subnegotiation_overflowed_)
         {
-            case telnetpp::se:
-                c(telnetpp::subnegotiation{
-                    subnegotiation_option_, subnegotiation_content_});
-                state_ = parsing_state::state_idle;
-                break;
+            c(telnetpp::subnegotiation{
+                subnegotiation_option_, subnegotiation_content_});
+        }
+        else if (streams_subnegotiations<Continuation>())
+        {
+            if (!subnegotiation_content_.empty())
+            {
+                emit_subnegotiation_event(
+                    c, event_kind::content, subnegotiation_content_);
+            }
 
-            default:
-                subnegotiation_content_.push_back(by);
-                state_ = parsing_state::state_subnegotiation_content;
-                break;
+            emit_subnegotiation_event(c, event_kind::end);
+        }
+        else if (overflow_policy_ == subnegotiation_overflow_policy::error)
+        {
+            emit_subnegotiation_event(c, event_kind::overflow);
         }
     }
 
+    constexpr void append_plain_data(telnetpp::bytes data)
+    {
+        if (data.empty())
+        {
+            return;
+        }
+
+        if (plain_data_.empty())
+        {
+            if (plain_data_view_.empty())
+            {
+                plain_data_view_ = data;
+                return;
+            }
+
+            if (plain_data_view_.data() + plain_data_view_.size()
+                == data.data())
+            {
+                plain_data_view_ = telnetpp::bytes{
+                    plain_data_view_.data(),
+                    plain_data_view_.size() + data.size()};
+                return;
+            }
+
+            // The data is not contiguous with what was viewed, so they must
+            // now be joined together in the buffer.
+            plain_data_.assign(
+                plain_data_view_.begin(), plain_data_view_.end());
+            plain_data_view_ = {};
+        }
+
+        plain_data_.append(data.begin(), data.end());
+    }
+
     template <typename Continuation>
     constexpr void emit_plain_data(Continuation &&c)
     {
-        if (!plain_data_.empty())
+        if (!plain_data_view_.empty())
+        {
+            c(plain_data_view_);
+            plain_data_view_ = {};
+        }
+        else if (!plain_data_.empty())
         {
             c(plain_data_);
             plain_data_.clear();
         }
     }
+
+    static constexpr telnetpp::byte const escaped_iac[] = {telnetpp::iac};
 };
 
 }  // namespace telnetpp
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "telnetpp/core.hpp"
+#include "telnetpp/detail/function_ref.hpp"
 #include "telnetpp/element.hpp"
+#include "telnetpp/subnegotiation_event.hpp"
 
 #include <functional>
 #include <memory>
+#include <span>
 
 namespace telnetpp {
 
@@ -26,6 +29,18 @@ class server_option;
 /// can be dropped in here without any extra work.  Otherwise it may be
 /// necessary to write a small wrapper.
 ///
+/// A channel may optionally also contain the function
+/// write_segments(std::span<telnetpp::bytes const>).  If it does, then the
+/// output for each call to write() is passed to it in one call, and it may
+/// then be sent with a single scatter-gather write, such as writev().
+///
+/// \par Static Dispatch
+/// The session reaches the channel through a type-erased interface, and
+/// each call to async_read wraps its callback in a std::function.  Where
+/// the type of the channel is known, telnetpp::basic_session may be used
+/// instead.  It calls the channel directly and performs no allocations when
+/// reading, and options can be installed into it just as they can here.
+///
 /// \par Sending and Receiving Plain Data
 ///
 /// The first part of using a telnetpp::session is understanding how to send
@@ -80,6 +95,31 @@ class server_option;
 ///
 /// \endcode
 ///
+/// \par Coalescing Output
+///
+/// Ordinarily, each call to write() results in a write to the channel.  When
+/// many small elements are written together, such as when negotiating a
+/// number of options, it is more efficient to send them all at once.  To do
+/// this, the session can be corked, in which case the output is collected in
+/// a buffer until the session is uncorked or flushed:
+///
+/// \code
+/// session.cork();
+/// echo_server.activate();
+/// naws_client.activate();
+/// session.uncork();  // The channel sees a single write.
+/// \endcode
+///
+/// Corking may be nested, and output is only flushed when the outermost cork
+/// is removed.  If the buffer reaches the output high-water mark, then it is
+/// written regardless.
+///
+/// If the channel has a flush() member function, then that is also called
+/// whenever the session is flushed, whether it is corked or not.  A channel
+/// that holds output back, such as one that compresses it with a
+/// mccp::zlib::compressor that does not flush after every write, can use
+/// this to send it on at natural boundaries, such as after a prompt.
+///
 /// \par Using Telnet Options
 ///
 /// Now that we can send and receive data over a Telnet connection, the next
@@ -137,23 +177,22 @@ class server_option;
 ///     });
 /// \endcode
 //* =========================================================================
-class TELNETPP_EXPORT session final  // NOLINT
+class TELNETPP_EXPORT session  // NOLINT
 {
 public:
     //* =====================================================================
     /// \brief Constructor
     //* =====================================================================
     template <typename Channel>
-    explicit session(Channel &channel) : session{}
+    explicit session(Channel &channel)
+      : session{std::make_unique<channel_model<Channel>>(channel)}
     {
-        channel_ = std::unique_ptr<channel_concept>(
-            std::make_unique<channel_model<Channel>>(channel));
     }
 
     //* =====================================================================
     /// \brief Destructor
     //* =====================================================================
-    ~session();
+    virtual ~session();
 
     //* =====================================================================
     /// \brief Returns whether the session is still alive
@@ -161,7 +200,7 @@ public:
     [[nodiscard]] bool is_alive() const;
 
     //* =====================================================================
-    /// \brief Closes the session.
+    /// \brief Closes the session.  Any corked output is flushed first.
     //* =====================================================================
     void close();
 
@@ -185,6 +224,64 @@ public:
     //* =====================================================================
     void write(telnetpp::element const &elem);
 
+    //* =====================================================================
+    /// \brief Sends a batch of Telnet data elements.  This is equivalent to
+    /// writing each in turn, except that the channel is asked to write all
+    /// of them at once.
+    //* =====================================================================
+    void write(std::span<telnetpp::element const> elems);
+
+    //* =====================================================================
+    /// \brief Sends bytes that are already in their final Telnet form, such
+    /// as a complete subnegotiation whose content has had its IAC bytes
+    /// doubled.  They are written exactly as they are, without being
+    /// scanned for bytes to escape.
+    //* =====================================================================
+    void write_encoded(telnetpp::bytes data);
+
+    //* =====================================================================
+    /// \brief Begins collecting output in a buffer rather than writing it to
+    /// the channel immediately.  Calls to cork() may be nested.
+    //* =====================================================================
+    void cork();
+
+    //* =====================================================================
+    /// \brief Reverses a call to cork().  If this removes the outermost
+    /// cork, then any collected output is flushed.
+    //* =====================================================================
+    void uncork();
+
+    //* =====================================================================
+    /// \brief Writes any collected output to the channel in a single write,
+    /// and then flushes the channel if it supports that.  The session
+    /// remains corked.
+    //* =====================================================================
+    void flush();
+
+    //* =====================================================================
+    /// \brief Sets the size at which collected output is flushed even
+    /// though the session is corked.
+    //* =====================================================================
+    void set_output_high_water_mark(std::size_t size);
+
+    //* =====================================================================
+    /// \brief The output high-water mark of a newly-constructed session.
+    //* =====================================================================
+    static constexpr std::size_t default_output_high_water_mark = 64 * 1024;
+
+    //* =====================================================================
+    /// \brief Sets the maximum size of the content of a received
+    /// subnegotiation, and what should happen to subnegotiations that
+    /// exceed it.  By default, there is no limit.
+    ///
+    /// With the stream policy, installed options receive large
+    /// subnegotiations as a series of events in handle_subnegotiation_event.
+    //* =====================================================================
+    void set_subnegotiation_limit(
+        std::size_t max_size,
+        telnetpp::subnegotiation_overflow_policy policy =
+            telnetpp::subnegotiation_overflow_policy::discard);
+
     //* =====================================================================
     /// \brief Installs a handler for the given command.
     //* =====================================================================
@@ -202,12 +299,7 @@ public:
     //* =====================================================================
     void install(telnetpp::server_option &option);
 
-private:
-    //* =====================================================================
-    /// \brief Constructor
-    //* =====================================================================
-    session();
-
+protected:
     //* =====================================================================
     /// \brief An interface for the channel model.
     //* =====================================================================
@@ -229,6 +321,22 @@ private:
         //* =================================================================
         virtual void write(bytes data) = 0;
 
+        //* =================================================================
+        /// \brief Write the given segments of data to the channel.
+        //* =================================================================
+        virtual void write_segments(std::span<bytes const> segments) = 0;
+
+        //* =================================================================
+        /// \brief Sends on any output that the channel is holding back.
+        //* =================================================================
+        virtual void flush() = 0;
+
+        //* =================================================================
+        /// \brief Returns whether the channel can write several segments
+        /// of data in a single call.
+        //* =================================================================
+        [[nodiscard]] virtual bool writes_segments() const noexcept = 0;
+
         //* =================================================================
         /// \brief Returns whether the channel is alive.
         //* =================================================================
@@ -240,6 +348,45 @@ private:
         virtual void close() = 0;
     };
 
+    //* =====================================================================
+    /// \brief Constructor for a session whose channel is implemented by a
+    /// derived class.  The channel must outlive the session.
+    //* =====================================================================
+    explicit session(channel_concept &channel);
+
+    //* =====================================================================
+    /// \brief Acts on any Telnet primitives in the given data, passing any
+    /// plain data on to the callback.
+    //* =====================================================================
+    void receive(
+        telnetpp::bytes content,
+        detail::function_ref<void(telnetpp::bytes)> callback);
+
+    //* =====================================================================
+    /// \brief Write the given segments of data to the given channel, using
+    /// a single call if the channel supports it.
+    //* =====================================================================
+    template <typename Channel>
+    static void write_segments_to(
+        Channel &channel, std::span<bytes const> segments)
+    {
+        if constexpr (requires { channel.write_segments(segments); })
+        {
+            channel.write_segments(segments);
+        }
+        else
+        {
+            for (auto const &segment : segments)
+            {
+                channel.write(segment);
+            }
+        }
+    }
+
+    //* =====================================================================
+    /// \brief An implementation of the channel concept for a channel of
+    /// the given type.
+    //* =====================================================================
     template <typename Channel>
     struct channel_model final : channel_concept
     {
@@ -267,6 +414,38 @@ private:
             channel_.write(data);
         }
 
+        //* =================================================================
+        /// \brief Write the given segments of data to the channel, using
+        /// a single call if the channel supports it.
+        //* =================================================================
+        void write_segments(std::span<bytes const> segments) override
+        {
+            write_segments_to(channel_, segments);
+        }
+
+        //* =================================================================
+        /// \brief Sends on any output that the channel is holding back, if
+        /// the channel supports that.
+        //* =================================================================
+        void flush() override
+        {
+            if constexpr (requires { channel_.flush(); })
+            {
+                channel_.flush();
+            }
+        }
+
+        //* =================================================================
+        /// \brief Returns whether the channel can write several segments
+        /// of data in a single call.
+        //* =================================================================
+        [[nodiscard]] bool writes_segments() const noexcept override
+        {
+            return requires(std::span<bytes const> segments) {
+                channel_.write_segments(segments);
+            };
+        }
+
         //* =================================================================
         /// \brief Returns whether the channel is alive.
         //* =================================================================
@@ -287,8 +466,26 @@ private:
         Channel &channel_;
     };
 
+private:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    explicit session(std::unique_ptr<channel_concept> channel);
+
+    //* =====================================================================
+    /// \brief Writes either a single element or a batch of elements.
+    //* =====================================================================
+    template <typename Elements>
+    void write_elements(Elements const &elems);
+
+    //* =====================================================================
+    /// \brief Writes any collected output to the channel.
+    //* =====================================================================
+    void write_output_buffer();
+
     struct impl;
-    std::unique_ptr<channel_concept> channel_;
+    std::unique_ptr<channel_concept> owned_channel_;
+    channel_concept *channel_;
     std::unique_ptr<impl> pimpl_;
 };
 
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#if defined(TELNETPP_WITH_SIGNALS2)
+#include <boost/signals2.hpp>
+#endif
+
+namespace telnetpp {
+
+template <typename Signature>
+class single_threaded_signal;
+
+//* =========================================================================
+/// \brief A signal for use within a single thread.
+///
+/// This has the same interface as boost::signals2::signal for the uses
+/// made of it in this library: slots are connected with connect() and the
+/// signal is emitted by calling it.  There is no locking and no reference
+/// counting.  An unconnected signal is the size of two vectors and
+/// allocates nothing, and connecting a small function object allocates
+/// only the space for the list of slots.
+///
+/// The price of holding the slots inline is size.  On a typical 64-bit
+/// platform, this signal is 64 bytes where a boost::signals2::signal,
+/// which points to its state on the heap, is 24.  Every option with signals
+/// grows accordingly: a naws::client, which has two, is 152 bytes rather
+/// than 72.
+///
+/// Slots may connect or disconnect slots, including themselves, while the
+/// signal is being emitted.  Slots that are connected during an emission
+/// are not called until the next one.
+//* =========================================================================
+template <typename... Args>
+class single_threaded_signal<void(Args...)>
+{
+public:
+    using slot_type = std::function<void(Args...)>;
+
+    //* =====================================================================
+    /// \brief A handle to a connected slot, which can be used to disconnect
+    /// it.  A connection must not be used after its signal is destroyed.
+    //* =====================================================================
+    class connection
+    {
+    public:
+        //* =================================================================
+        /// \brief Constructs a connection that refers to no slot.
+        //* =================================================================
+        constexpr connection() noexcept = default;
+
+        //* =================================================================
+        /// \brief Returns whether the slot is still connected.
+        //* =================================================================
+        [[nodiscard]] bool connected() const noexcept
+        {
+            return signal_ != nullptr && signal_->connected(id_);
+        }
+
+        //* =================================================================
+        /// \brief Disconnects the slot from its signal.
+        //* =================================================================
+        void disconnect() const
+        {
+            if (signal_ != nullptr)
+            {
+                signal_->disconnect(id_);
+            }
+        }
+
+    private:
+        friend class single_threaded_signal;
+
+        constexpr connection(
+            single_threaded_signal *signal, std::size_t id) noexcept
+          : signal_{signal}, id_{id}
+        {
+        }
+
+        single_threaded_signal *signal_{nullptr};
+        std::size_t id_{0};
+    };
+
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    single_threaded_signal() = default;
+
+    // A connection refers to its signal by address, so signals are neither
+    // copyable nor movable, as with boost::signals2.
+    single_threaded_signal(single_threaded_signal const &) = delete;
+    single_threaded_signal &operator=(single_threaded_signal const &) =
+        delete;
+
+    //* =====================================================================
+    /// \brief Connects a slot to the signal.
+    //* =====================================================================
+    connection connect(slot_type slot)
+    {
+        connect_pending_slots();
+        auto const id = ++last_id_;
+
+        // Slots connected during an emission are held back until it is
+        // over, so that the slot that is running is never moved.
+        (emission_depth_ == 0 ? slots_ : pending_slots_)
+            .push_back({id, std::move(slot)});
+
+        return connection{this, id};
+    }
+
+    //* =====================================================================
+    /// \brief Disconnects all slots from the signal.
+    //* =====================================================================
+    void disconnect_all_slots() noexcept
+    {
+        for (auto &slot : slots_)
+        {
+            slot.id = disconnected_id;
+        }
+
+        pending_slots_.clear();
+        erase_disconnected_slots();
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether there are no slots connected to the signal.
+    //* =====================================================================
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return num_slots() == 0;
+    }
+
+    //* =====================================================================
+    /// \brief Returns the number of slots connected to the signal.
+    //* =====================================================================
+    [[nodiscard]] std::size_t num_slots() const noexcept
+    {
+        return pending_slots_.size()
+             + static_cast<std::size_t>(std::count_if(
+                 slots_.begin(),
+                 slots_.end(),
+                 [](connected_slot const &slot) {
+                     return slot.id != disconnected_id;
+                 }));
+    }
+
+    //* =====================================================================
+    /// \brief Emits the signal, calling each connected slot in the order in
+    /// which they were connected.
+    //* =====================================================================
+    void operator()(Args... args)
+    {
+        // Slots that could not be connected after an earlier emission are
+        // connected before this one, so that they are not missed by it.
+        connect_pending_slots();
+
+        emission_guard guard{*this};
+
+        for (auto const &slot : slots_)
+        {
+            if (slot.id != disconnected_id)
+            {
+                slot.function(args...);
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t disconnected_id = 0;
+
+    struct connected_slot
+    {
+        std::size_t id;
+        slot_type function;
+    };
+
+    struct emission_guard
+    {
+        explicit emission_guard(single_threaded_signal &signal) noexcept
+          : signal_{signal}
+        {
+            ++signal_.emission_depth_;
+        }
+
+        ~emission_guard()
+        {
+            --signal_.emission_depth_;
+            signal_.erase_disconnected_slots();
+
+            // Connecting the pending slots allocates, but this may run
+            // while a throwing slot is being unwound, so it must not throw.
+            // If it fails, the slots stay pending, and still count as
+            // connected, until the next emission or connection tries again.
+            try
+            {
+                signal_.connect_pending_slots();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        emission_guard(emission_guard const &) = delete;
+        emission_guard &operator=(emission_guard const &) = delete;
+
+        single_threaded_signal &signal_;
+    };
+
+    [[nodiscard]] bool connected(std::size_t id) const noexcept
+    {
+        auto const has_id = [id](connected_slot const &slot) {
+            return slot.id == id;
+        };
+
+        return std::any_of(slots_.begin(), slots_.end(), has_id)
+            || std::any_of(
+                   pending_slots_.begin(), pending_slots_.end(), has_id);
+    }
+
+    void disconnect(std::size_t id) noexcept
+    {
+        auto const has_id = [id](connected_slot const &slot) {
+            return slot.id == id;
+        };
+
+        std::erase_if(pending_slots_, has_id);
+
+        if (auto const found =
+                std::find_if(slots_.begin(), slots_.end(), has_id);
+            found != slots_.end())
+        {
+            // The slot may be the one that is currently running, so it is
+            // only marked here, and erased once no emission is in progress.
+            found->id = disconnected_id;
+            erase_disconnected_slots();
+        }
+    }
+
+    void erase_disconnected_slots() noexcept
+    {
+        if (emission_depth_ == 0)
+        {
+            std::erase_if(slots_, [](connected_slot const &slot) {
+                return slot.id == disconnected_id;
+            });
+        }
+    }
+
+    // Inserting at the end of the vector either succeeds or, if it cannot
+    // allocate, leaves both vectors as they were.
+    void connect_pending_slots()
+    {
+        if (emission_depth_ == 0 && !pending_slots_.empty())
+        {
+            slots_.insert(
+                slots_.end(),
+                std::make_move_iterator(pending_slots_.begin()),
+                std::make_move_iterator(pending_slots_.end()));
+            pending_slots_.clear();
+        }
+    }
+
+    std::vector<connected_slot> slots_;
+    std::vector<connected_slot> pending_slots_;
+    std::size_t last_id_{disconnected_id};
+    std::size_t emission_depth_{0};
+};
+
+//* =========================================================================
+/// \brief The type of signal used by options to report events.
+///
+/// By default, this is a telnetpp::single_threaded_signal.  If the library
+/// is built with TELNETPP_WITH_SIGNALS2, then it is the thread-safe
+/// boost::signals2::signal instead.
+//* =========================================================================
+#if defined(TELNETPP_WITH_SIGNALS2)
+template <typename Signature>
+using signal = boost::signals2::signal<Signature>;
+#else
+template <typename Signature>
+using signal = single_threaded_signal<Signature>;
+#endif
+
+}  // namespace telnetpp
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "telnetpp/core.hpp"
+
+#include <cstdint>
+
+namespace telnetpp {
+
+//* =========================================================================
+/// \brief Describes what a parser does with a subnegotiation whose content
+/// exceeds its configured maximum size.
+//* =========================================================================
+enum class subnegotiation_overflow_policy : std::uint8_t
+{
+    /// The subnegotiation is silently discarded.
+    discard,
+
+    /// The subnegotiation is discarded, and an overflow event is emitted
+    /// when it ends.
+    error,
+
+    /// The subnegotiation is delivered as a series of events: a begin
+    /// event, content events of at most the maximum size, and an end event.
+    stream,
+};
+
+//* =========================================================================
+/// \brief A class that encapsulates an event in the reception of a
+/// subnegotiation that was too large to be delivered whole.
+/// \see telnetpp::subnegotiation_overflow_policy
+//* =========================================================================
+class TELNETPP_EXPORT subnegotiation_event
+{
+public:
+    enum class event_kind : std::uint8_t
+    {
+        begin,
+        content,
+        end,
+        overflow,
+    };
+
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    constexpr subnegotiation_event(
+        option_type option, event_kind kind, bytes content = {}) noexcept
+      : option_(option), kind_(kind), content_(content)
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Returns the option for this subnegotiation.
+    //* =====================================================================
+    [[nodiscard]] constexpr option_type option() const noexcept
+    {
+        return option_;
+    }
+
+    //* =====================================================================
+    /// \brief Returns the kind of this event.
+    //* =====================================================================
+    [[nodiscard]] constexpr event_kind kind() const noexcept
+    {
+        return kind_;
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether this is the first event for its
+    /// subnegotiation: the begin event of one that is streamed, or the
+    /// overflow event of one that was discarded.  An option that can only
+    /// handle its subnegotiations whole can use this to notice each one
+    /// that was too large exactly once, whichever policy is in force.
+    //* =====================================================================
+    [[nodiscard]] constexpr bool is_first() const noexcept
+    {
+        return kind_ == event_kind::begin || kind_ == event_kind::overflow;
+    }
+
+    //* =====================================================================
+    /// \brief Returns the content for this event.  This is empty for all
+    /// but content events.
+    //* =====================================================================
+    [[nodiscard]] constexpr bytes content() const noexcept
+    {
+        return content_;
+    }
+
+private:
+    option_type option_;
+    event_kind kind_;
+    bytes content_;
+};
+
+//* =========================================================================
+/// \brief Comparison function for subnegotiation events
+//* =========================================================================
+constexpr inline bool operator==(
+    subnegotiation_event const &lhs, subnegotiation_event const &rhs) noexcept
+{
+    return lhs.option() == rhs.option() && lhs.kind() == rhs.kind()
+        && telnetpp::bytes_equal(lhs.content(), rhs.content());
+}
+
+}  // namespace telnetpp
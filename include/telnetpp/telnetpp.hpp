@@ -3,4 +3,5 @@
 // At the moment, the header for session includes everything that a user
 // fundamentally needs.  Additional features will be included from option
 // headers.
-#include "telnetpp/session.hpp"  // IWYU pragma: export
+#include "telnetpp/basic_session.hpp"  // IWYU pragma: export
+#include "telnetpp/session.hpp"        // IWYU pragma: export
@@ -8,13 +8,15 @@ namespace telnetpp::detail {
 void register_client_option(
     client_option &option,
     negotiation_router &neg_router,
-    subnegotiation_router &sub_router)
+    subnegotiation_router &sub_router,
+    subnegotiation_event_router &event_router)
 {
     register_route_from_negotiation_to_option(
         neg_router, telnetpp::client_option::remote_positive, option);
     register_route_from_negotiation_to_option(
         neg_router, telnetpp::client_option::remote_negative, option);
     register_route_from_subnegotiation_to_option(sub_router, option);
+    register_route_from_subnegotiation_event_to_option(event_router, option);
 }
 
 // ==========================================================================
@@ -23,13 +25,15 @@ void register_client_option(
 void register_server_option(
     server_option &option,
     negotiation_router &neg_router,
-    subnegotiation_router &sub_router)
+    subnegotiation_router &sub_router,
+    subnegotiation_event_router &event_router)
 {
     register_route_from_negotiation_to_option(
         neg_router, telnetpp::server_option::remote_positive, option);
     register_route_from_negotiation_to_option(
         neg_router, telnetpp::server_option::remote_negative, option);
     register_route_from_subnegotiation_to_option(sub_router, option);
+    register_route_from_subnegotiation_event_to_option(event_router, option);
 }
 
 }  // namespace telnetpp::detail
@@ -0,0 +1,113 @@
+#include "telnetpp/options/gmcp/detail/encoder.hpp"
+
+#include "telnetpp/detail/find_iac.hpp"
+#include "telnetpp/options/gmcp/detail/protocol.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace telnetpp::options::gmcp::detail {
+
+namespace {
+
+// The IAC SB <option> that begins a subnegotiation and the IAC SE that
+// ends it.
+constexpr std::size_t framing_size = 5;
+
+// ==========================================================================
+// COUNT_IACS
+// ==========================================================================
+std::size_t count_iacs(telnetpp::bytes data) noexcept
+{
+    std::size_t result = 0;
+
+    for (auto position = telnetpp::detail::find_iac(data.begin(), data.end());
+         position != data.end();
+         position = telnetpp::detail::find_iac(position + 1, data.end()))
+    {
+        ++result;
+    }
+
+    return result;
+}
+
+// ==========================================================================
+// AS_BYTES
+// ==========================================================================
+telnetpp::bytes as_bytes(std::string_view text) noexcept
+{
+    return {
+        reinterpret_cast<telnetpp::byte const *>(text.data()),  // NOLINT
+        text.size()};
+}
+
+// ==========================================================================
+// COPY_ESCAPED
+// ==========================================================================
+telnetpp::byte *copy_escaped(telnetpp::bytes data, telnetpp::byte *out)
+{
+    // Payloads may be large, so the runs between IACs are found with the
+    // same scan that the parser uses and are copied whole.
+    auto first = data.begin();
+
+    for (auto position = telnetpp::detail::find_iac(first, data.end());
+         position != data.end();
+         position = telnetpp::detail::find_iac(first, data.end()))
+    {
+        out = std::copy(first, position + 1, out);
+        *out++ = telnetpp::iac;
+        first = position + 1;
+    }
+
+    return std::copy(first, data.end(), out);
+}
+
+}  // namespace
+
+// ==========================================================================
+// SUBNEGOTIATION_SIZE
+// ==========================================================================
+std::size_t subnegotiation_size(
+    std::string_view package, telnetpp::bytes payload) noexcept
+{
+    auto const package_bytes = as_bytes(package);
+    auto result =
+        framing_size + package_bytes.size() + count_iacs(package_bytes);
+
+    if (!payload.empty())
+    {
+        result += 1 + payload.size() + count_iacs(payload);
+    }
+
+    return result;
+}
+
+// ==========================================================================
+// ENCODE_SUBNEGOTIATION
+// ==========================================================================
+telnetpp::bytes encode_subnegotiation(
+    std::string_view package,
+    telnetpp::bytes payload,
+    std::span<telnetpp::byte> buffer) noexcept
+{
+    assert(buffer.size() >= subnegotiation_size(package, payload));
+
+    auto *out = buffer.data();
+    *out++ = telnetpp::iac;
+    *out++ = telnetpp::sb;
+    *out++ = telnetpp::options::gmcp::detail::option;
+    out = copy_escaped(as_bytes(package), out);
+
+    if (!payload.empty())
+    {
+        *out++ = telnetpp::options::gmcp::detail::separator;
+        out = copy_escaped(payload, out);
+    }
+
+    *out++ = telnetpp::iac;
+    *out++ = telnetpp::se;
+
+    return buffer.first(static_cast<std::size_t>(out - buffer.data()));
+}
+
+}  // namespace telnetpp::options::gmcp::detail
@@ -0,0 +1,96 @@
+#include "telnetpp/options/gmcp/detail/handler_table.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace telnetpp::options::gmcp::detail {
+
+namespace {
+
+// ==========================================================================
+// TO_LOWER
+// ==========================================================================
+constexpr unsigned char to_lower(unsigned char ch) noexcept
+{
+    return ch >= 'A' && ch <= 'Z' ? static_cast<unsigned char>(ch + 'a' - 'A')
+                                  : ch;
+}
+
+// ==========================================================================
+// COMPARE_NAMES
+// ==========================================================================
+template <typename Lhs, typename Rhs>
+int compare_names(Lhs const &lhs, Rhs const &rhs) noexcept
+{
+    auto const size = std::min(lhs.size(), rhs.size());
+
+    for (std::size_t index = 0; index < size; ++index)
+    {
+        auto const lhs_ch = to_lower(static_cast<unsigned char>(lhs[index]));
+        auto const rhs_ch = to_lower(static_cast<unsigned char>(rhs[index]));
+
+        if (lhs_ch != rhs_ch)
+        {
+            return lhs_ch < rhs_ch ? -1 : 1;
+        }
+    }
+
+    return lhs.size() < rhs.size() ? -1 : lhs.size() > rhs.size() ? 1 : 0;
+}
+
+}  // namespace
+
+// ==========================================================================
+// SET
+// ==========================================================================
+void handler_table::set(std::string_view package, message_handler handler)
+{
+    auto const position = std::lower_bound(
+        entries_.begin(),
+        entries_.end(),
+        package,
+        [](entry const &lhs, std::string_view rhs) {
+            return compare_names(lhs.package_, rhs) < 0;
+        });
+    auto const found = position != entries_.end()
+                    && compare_names(position->package_, package) == 0;
+
+    if (!handler)
+    {
+        if (found)
+        {
+            entries_.erase(position);
+        }
+    }
+    else if (found)
+    {
+        position->handler_ = std::move(handler);
+    }
+    else
+    {
+        entries_.insert(
+            position, entry{std::string{package}, std::move(handler)});
+    }
+}
+
+// ==========================================================================
+// FIND
+// ==========================================================================
+message_handler const *handler_table::find(
+    telnetpp::bytes package) const noexcept
+{
+    auto const position = std::lower_bound(
+        entries_.begin(),
+        entries_.end(),
+        package,
+        [](entry const &lhs, telnetpp::bytes rhs) {
+            return compare_names(lhs.package_, rhs) < 0;
+        });
+
+    return position != entries_.end()
+                && compare_names(position->package_, package) == 0
+             ? &position->handler_
+             : nullptr;
+}
+
+}  // namespace telnetpp::options::gmcp::detail
@@ -0,0 +1,30 @@
+#include "telnetpp/options/gmcp/message_view.hpp"
+
+#include "telnetpp/options/gmcp/detail/protocol.hpp"
+
+#include <algorithm>
+
+namespace telnetpp::options::gmcp {
+
+// ==========================================================================
+// SPLIT_MESSAGE
+// ==========================================================================
+message_view split_message(telnetpp::bytes content) noexcept
+{
+    // Only the package name is searched; the payload is not looked at.
+    auto const separator =
+        std::find(content.begin(), content.end(), detail::separator);
+
+    if (separator == content.end())
+    {
+        return {content, {}};
+    }
+
+    auto const package_size =
+        static_cast<std::size_t>(separator - content.begin());
+
+    return {
+        content.first(package_size), content.subspan(package_size + 1)};
+}
+
+}  // namespace telnetpp::options::gmcp
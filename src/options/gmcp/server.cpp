@@ -0,0 +1,78 @@
+#include "telnetpp/options/gmcp/server.hpp"
+
+#include "telnetpp/options/gmcp/detail/encoder.hpp"
+#include "telnetpp/options/gmcp/detail/protocol.hpp"
+
+#include <utility>
+
+namespace telnetpp::options::gmcp {
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+server::server(telnetpp::session &sess) noexcept
+  : telnetpp::server_option(sess, telnetpp::options::gmcp::detail::option)
+{
+}
+
+// ==========================================================================
+// SEND
+// ==========================================================================
+void server::send(std::string_view package, telnetpp::bytes payload)
+{
+    send_buffer_(
+        detail::subnegotiation_size(package, payload),
+        [&](std::span<telnetpp::byte> buffer) {
+            return detail::encode_subnegotiation(package, payload, buffer);
+        },
+        [this](telnetpp::bytes frame) { write_encoded_subnegotiation(frame); });
+}
+
+// ==========================================================================
+// SEND
+// ==========================================================================
+void server::send(std::string_view package, std::string_view payload)
+{
+    send(
+        package,
+        telnetpp::bytes{
+            reinterpret_cast<telnetpp::byte const *>(payload.data()),  // NOLINT
+            payload.size()});
+}
+
+// ==========================================================================
+// SET_HANDLER
+// ==========================================================================
+void server::set_handler(std::string_view package, message_handler handler)
+{
+    handlers_.set(package, std::move(handler));
+}
+
+// ==========================================================================
+// HANDLE_SUBNEGOTIATION
+// ==========================================================================
+void server::handle_subnegotiation(telnetpp::bytes data)
+{
+    auto const message = split_message(data);
+
+    if (auto const *handler = handlers_.find(message.package_); handler)
+    {
+        (*handler)(message);
+    }
+
+    on_receive(message);
+}
+
+// ==========================================================================
+// HANDLE_SUBNEGOTIATION_EVENT
+// ==========================================================================
+void server::handle_subnegotiation_event(
+    telnetpp::subnegotiation_event const &event)
+{
+    if (event.is_first())
+    {
+        on_oversized_message();
+    }
+}
+
+}  // namespace telnetpp::options::gmcp
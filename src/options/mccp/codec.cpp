@@ -1,13 +1,101 @@
 #include "telnetpp/options/mccp/codec.hpp"
 
+#include "telnetpp/detail/find_iac.hpp"
+
+#include <chrono>
+
 namespace telnetpp::options::mccp {
 
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+// ==========================================================================
+// ELAPSED_SINCE
+// ==========================================================================
+std::chrono::nanoseconds elapsed_since(clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock::now() - start);
+}
+
+}  // namespace
+
+// ==========================================================================
+// MEASURE
+// ==========================================================================
+template <typename Transformation>
+void codec::measure(continuation const &cont, Transformation &&transformation)
+{
+    auto const count = [this](telnetpp::bytes data, bool stream_ended) {
+        pending_statistics_.bytes_out += data.size();
+
+        if (stream_ended && engaged_)
+        {
+            engaged_ = false;
+            ++pending_statistics_.streams_finished;
+        }
+    };
+
+    if (!timing_enabled_)
+    {
+        transformation(
+            [&count, &cont](telnetpp::bytes data, bool stream_ended) {
+                count(data, stream_ended);
+                cont(data, stream_ended);
+            });
+
+        return;
+    }
+
+    auto const started = clock::now();
+
+    // The time spent in the continuation is taken away as it happens, so
+    // that only the time spent transforming remains.
+    transformation([this, &count, &cont](
+                       telnetpp::bytes data, bool stream_ended) {
+        count(data, stream_ended);
+
+        auto const continuation_started = clock::now();
+        cont(data, stream_ended);
+        pending_statistics_.transform_time -=
+            elapsed_since(continuation_started);
+    });
+
+    pending_statistics_.transform_time += elapsed_since(started);
+}
+
+// ==========================================================================
+// PUBLISHER
+// ==========================================================================
+class codec::publisher
+{
+public:
+    explicit publisher(codec &owner) noexcept : owner_{owner}
+    {
+    }
+
+    ~publisher()
+    {
+        owner_.publish_statistics();
+    }
+
+    publisher(publisher const &) = delete;
+    publisher &operator=(publisher const &) = delete;
+
+private:
+    codec &owner_;
+};
+
 // ==========================================================================
 // START
 // ==========================================================================
 void codec::start()
 {
     engaged_ = true;
+    iac_pending_ = false;
+    ++pending_statistics_.streams_started;
+    publish_statistics();
     do_start();
 }
 
@@ -16,8 +104,41 @@ void codec::start()
 // ==========================================================================
 void codec::finish(continuation const &cont)
 {
-    do_finish(cont);
-    engaged_ = false;
+    publisher const publish{*this};
+
+    if (engaged_)
+    {
+        measure(cont, [this](continuation const &measured_cont) {
+            do_finish(measured_cont);
+        });
+
+        // Codecs with nothing to send on finish without calling the
+        // continuation.
+        if (engaged_)
+        {
+            engaged_ = false;
+            ++pending_statistics_.streams_finished;
+        }
+    }
+    else
+    {
+        do_finish(cont);
+    }
+}
+
+// ==========================================================================
+// FLUSH
+// ==========================================================================
+void codec::flush(continuation const &cont)
+{
+    if (engaged_)
+    {
+        publisher const publish{*this};
+
+        measure(cont, [this](continuation const &measured_cont) {
+            do_flush(measured_cont);
+        });
+    }
 }
 
 // ==========================================================================
@@ -25,28 +146,129 @@ void codec::finish(continuation const &cont)
 // ==========================================================================
 void codec::operator()(telnetpp::bytes data, continuation const &cont)
 {
+    publisher const publish{*this};
+
     while (!data.empty())
     {
         if (engaged_)
         {
-            data = transform_chunk(
-                data,
-                [&](telnetpp::bytes decompressed_data,
-                    bool decompression_ended) {
-                    engaged_ = !decompression_ended;
-                    cont(decompressed_data, decompression_ended);
-                });
+            auto const chunk_size = data.size();
+
+            measure(cont, [this, &data](continuation const &measured_cont) {
+                data = transform_chunk(data, measured_cont);
+            });
+
+            pending_statistics_.bytes_in += chunk_size - data.size();
         }
         else
         {
-            // Every byte might activate decompression, so they must be
-            // transmitted individually.
-            cont(data.subspan(0, 1), false);
-            data = data.subspan(1);
+            // The transformation can only be started by the end of a
+            // subnegotiation, so everything up to and including the next
+            // IAC SE can be passed on together.  Whatever follows it must
+            // wait until the continuation has had the chance to start the
+            // stream.
+            auto const passthrough_size = find_subnegotiation_end(data);
+            cont(data.first(passthrough_size), false);
+            data = data.subspan(passthrough_size);
         }
     }
 }
 
+// ==========================================================================
+// STATISTICS
+// ==========================================================================
+codec_statistics const &codec::statistics() const noexcept
+{
+    return statistics_;
+}
+
+// ==========================================================================
+// RESET_STATISTICS
+// ==========================================================================
+void codec::reset_statistics() noexcept
+{
+    statistics_ = {};
+}
+
+// ==========================================================================
+// SET_STATISTICS_COLLECTOR
+// ==========================================================================
+void codec::set_statistics_collector(statistics_collector *collector) noexcept
+{
+    collector_ = collector;
+}
+
+// ==========================================================================
+// SET_TIMING_ENABLED
+// ==========================================================================
+void codec::set_timing_enabled(bool enabled) noexcept
+{
+    timing_enabled_ = enabled;
+}
+
+// ==========================================================================
+// COUNT_FLUSH
+// ==========================================================================
+void codec::count_flush() noexcept
+{
+    ++pending_statistics_.flushes;
+}
+
+// ==========================================================================
+// PUBLISH_STATISTICS
+// ==========================================================================
+void codec::publish_statistics() noexcept
+{
+    if (pending_statistics_ == codec_statistics{})
+    {
+        return;
+    }
+
+    statistics_ += pending_statistics_;
+
+    if (collector_ != nullptr)
+    {
+        collector_->add(pending_statistics_);
+    }
+
+    pending_statistics_ = {};
+}
+
+// ==========================================================================
+// FIND_SUBNEGOTIATION_END
+// ==========================================================================
+std::size_t codec::find_subnegotiation_end(telnetpp::bytes data) noexcept
+{
+    auto position = data.begin();
+
+    while (position != data.end())
+    {
+        if (iac_pending_)
+        {
+            // This byte completes a two-byte sequence, so it is either the
+            // SE that ends a subnegotiation, or it cannot begin one.
+            iac_pending_ = false;
+
+            if (*position++ == telnetpp::se)
+            {
+                break;
+            }
+        }
+        else
+        {
+            position = telnetpp::detail::find_iac(position, data.end());
+
+            if (position != data.end())
+            {
+                iac_pending_ = true;
+                ++position;
+            }
+        }
+    }
+
+    return static_cast<std::size_t>(position - data.begin());
+}
+
 // ==========================================================================
 // CORRUPTED_STREAM_ERROR::CONSTRUCTOR
 // ==========================================================================
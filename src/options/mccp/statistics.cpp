@@ -0,0 +1,53 @@
+#include "telnetpp/options/mccp/statistics.hpp"
+
+namespace telnetpp::options::mccp {
+
+namespace {
+
+constexpr auto relaxed = std::memory_order_relaxed;
+
+}  // namespace
+
+// ==========================================================================
+// ADD
+// ==========================================================================
+void statistics_collector::add(codec_statistics const &statistics) noexcept
+{
+    bytes_in_.fetch_add(statistics.bytes_in, relaxed);
+    bytes_out_.fetch_add(statistics.bytes_out, relaxed);
+    flushes_.fetch_add(statistics.flushes, relaxed);
+    streams_started_.fetch_add(statistics.streams_started, relaxed);
+    streams_finished_.fetch_add(statistics.streams_finished, relaxed);
+    transform_time_.fetch_add(statistics.transform_time.count(), relaxed);
+}
+
+// ==========================================================================
+// SNAPSHOT
+// ==========================================================================
+codec_statistics statistics_collector::snapshot() const noexcept
+{
+    codec_statistics statistics;
+    statistics.bytes_in = bytes_in_.load(relaxed);
+    statistics.bytes_out = bytes_out_.load(relaxed);
+    statistics.flushes = flushes_.load(relaxed);
+    statistics.streams_started = streams_started_.load(relaxed);
+    statistics.streams_finished = streams_finished_.load(relaxed);
+    statistics.transform_time =
+        std::chrono::nanoseconds{transform_time_.load(relaxed)};
+    return statistics;
+}
+
+// ==========================================================================
+// RESET
+// ==========================================================================
+void statistics_collector::reset() noexcept
+{
+    bytes_in_.store(0, relaxed);
+    bytes_out_.store(0, relaxed);
+    flushes_.store(0, relaxed);
+    streams_started_.store(0, relaxed);
+    streams_finished_.store(0, relaxed);
+    transform_time_.store(0, relaxed);
+}
+
+}  // namespace telnetpp::options::mccp
@@ -1,43 +1,49 @@
 #include "telnetpp/options/mccp/zlib/compressor.hpp"
 
-#include <zlib.h>
+#include "telnetpp/options/mccp/zlib/detail/output_buffer.hpp"
+#include "telnetpp/options/mccp/zlib/detail/stream.hpp"
 
-#include <optional>
 #include <cassert>
+#include <utility>
 
 namespace telnetpp::options::mccp::zlib {
 
-namespace {
-
-// In a Telnet application, we don't expect to be sending out massive amounts
-// of data at a time; usually only a few bytes.  Therefore, it's not necessary
-// to allocate massive blocks of 128KB or 256KB as suggested by the ZLib
-// how-to guide.  Instead, we can just use small blocks on the stack and
-// iterate in the very rare case that a single message yields a block of 1KB
-// or more.
-constexpr std::size_t output_buffer_size = 1024;
-
-}  // namespace
-
 // ==========================================================================
 // ZLIB_COMPRESSION::IMPL
 // ==========================================================================
 struct compressor::impl
 {
-    std::optional<z_stream> stream_;
+    impl(
+        compression_parameters const &parameters,
+        std::pmr::memory_resource *resource,
+        stream_pool *pool)
+      : parameters_{detail::validate_parameters(parameters)},
+        resource_{resource},
+        pool_{pool},
+        output_buffer_{resource}
+    {
+    }
+
+    compression_parameters parameters_;
+    std::pmr::memory_resource *resource_;
+    stream_pool *pool_;
+    detail::stream_ptr stream_;
+    detail::output_buffer output_buffer_;
+
+    flush_policy flush_policy_{flush_policy::every_write};
+    std::size_t flush_threshold_{default_flush_threshold};
+    std::size_t unflushed_size_{0};
 
     // ======================================================================
     // CONSTRUCT_STREAM
     // ======================================================================
     void construct_stream()
     {
-        assert(stream_ == std::nullopt);
-
-        stream_ = z_stream{};
+        assert(!stream_);
 
-        [[maybe_unused]] auto result =
-            deflateInit(&*stream_, Z_DEFAULT_COMPRESSION);
-        assert(result == Z_OK);
+        stream_ = pool_ != nullptr
+                    ? pool_->acquire()
+                    : detail::make_deflate_stream(parameters_, resource_);
     }
 
     // ======================================================================
@@ -45,19 +51,93 @@ struct compressor::impl
     // ======================================================================
     void destroy_stream()
     {
-        assert(stream_ != std::nullopt);
+        assert(stream_);
+        unflushed_size_ = 0;
+
+        if (pool_ != nullptr)
+        {
+            pool_->release(std::move(stream_));
+        }
+        else
+        {
+            stream_.reset();
+        }
+    }
+
+    // ======================================================================
+    // SHOULD_FLUSH
+    // ======================================================================
+    [[nodiscard]] bool should_flush() const noexcept
+    {
+        switch (flush_policy_)
+        {
+            case flush_policy::every_write:
+                return true;
+
+            case flush_policy::explicit_only:
+                return false;
+
+            case flush_policy::threshold:
+                return unflushed_size_ >= flush_threshold_;
+        }
+
+        return true;
+    }
+
+    // ======================================================================
+    // COMPRESS
+    // ======================================================================
+    void compress(int flush, continuation const &cont)
+    {
+        auto &z = stream_->z;
+        output_buffer_.begin(z, deflateBound(&z, z.avail_in));
+
+        // All of the input is consumed and, when flushing, all of the
+        // output is collected, so that it can be sent in one piece.
+        for (;;)
+        {
+            [[maybe_unused]] auto const response = deflate(&z, flush);
+            assert(response == Z_OK || response == Z_BUF_ERROR);
+
+            if (z.avail_out != 0 && (z.avail_in == 0 || response != Z_OK))
+            {
+                break;
+            }
+
+            output_buffer_.grow(z);
+        }
 
-        [[maybe_unused]] auto result = deflateEnd(&*stream_);
-        assert(result == Z_OK || result == Z_STREAM_ERROR || Z_DATA_ERROR);
+        if (flush != Z_NO_FLUSH)
+        {
+            unflushed_size_ = 0;
+        }
 
-        stream_ = std::nullopt;
+        auto const output_data = output_buffer_.data(z);
+
+        if (!output_data.empty())
+        {
+            cont(output_data, false);
+        }
+
+        output_buffer_.trim(output_data);
     }
 };
 
 // ==========================================================================
 // CONSTRUCTOR
 // ==========================================================================
-compressor::compressor() : pimpl_(new impl)
+compressor::compressor(
+    compression_parameters const &parameters,
+    std::pmr::memory_resource *resource)
+  : pimpl_(std::make_unique<impl>(parameters, resource, nullptr))
+{
+}
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+compressor::compressor(compression_stream_pool &pool)
+  : pimpl_(std::make_unique<impl>(pool.parameters(), pool.resource(), &pool))
 {
 }
 
@@ -72,6 +152,32 @@ compressor::~compressor()
     }
 }
 
+// ==========================================================================
+// PARAMETERS
+// ==========================================================================
+compression_parameters const &compressor::parameters() const noexcept
+{
+    return pimpl_->parameters_;
+}
+
+// ==========================================================================
+// MEMORY_USAGE
+// ==========================================================================
+std::size_t compressor::memory_usage() const noexcept
+{
+    return pimpl_->stream_ ? pimpl_->stream_->memory_usage : 0;
+}
+
+// ==========================================================================
+// SET_FLUSH_POLICY
+// ==========================================================================
+void compressor::set_flush_policy(
+    flush_policy policy, std::size_t threshold) noexcept
+{
+    pimpl_->flush_policy_ = policy;
+    pimpl_->flush_threshold_ = threshold;
+}
+
 // ==========================================================================
 // DO_START
 // ==========================================================================
@@ -89,29 +195,42 @@ void compressor::do_finish(continuation const &cont)
         pimpl_->construct_stream();
     }
 
-    assert(pimpl_->stream_.has_value());
-    byte output_buffer[output_buffer_size];
-    pimpl_->stream_->avail_in = 0;
-    pimpl_->stream_->next_in = nullptr;
-
-    auto response = Z_OK;
+    assert(pimpl_->stream_);
+    auto &z = pimpl_->stream_->z;
+    z.avail_in = 0;
+    z.next_in = nullptr;
+    pimpl_->output_buffer_.begin(z);
 
-    do
+    for (auto response = deflate(&z, Z_FINISH); response != Z_STREAM_END;
+         response = deflate(&z, Z_FINISH))
     {
-        pimpl_->stream_->avail_out = output_buffer_size;
-        pimpl_->stream_->next_out = output_buffer;
-
-        response = deflate(&*pimpl_->stream_, Z_FINISH);
+        assert(response == Z_OK || response == Z_BUF_ERROR);
+        pimpl_->output_buffer_.grow(z);
+    }
 
-        auto const output_data =
-            telnetpp::bytes{output_buffer, pimpl_->stream_->next_out};
+    auto const output_data = pimpl_->output_buffer_.data(z);
+    cont(output_data, true);
 
-        cont(output_data, true);
-    } while (response == Z_OK);
+    pimpl_->output_buffer_.trim(output_data);
+    pimpl_->destroy_stream();
+}
 
-    assert(response == Z_STREAM_END);
+// ==========================================================================
+// DO_FLUSH
+// ==========================================================================
+void compressor::do_flush(continuation const &cont)
+{
+    // There is nothing to flush if nothing has been written since the
+    // last flush, and flushing anyway would only add an empty block.
+    if (!pimpl_->stream_ || pimpl_->unflushed_size_ == 0)
+    {
+        return;
+    }
 
-    pimpl_->destroy_stream();
+    pimpl_->stream_->z.avail_in = 0;
+    pimpl_->stream_->z.next_in = nullptr;
+    pimpl_->compress(Z_SYNC_FLUSH, cont);
+    count_flush();
 }
 
 // ==========================================================================
@@ -125,22 +244,22 @@ telnetpp::bytes compressor::transform_chunk(
         pimpl_->construct_stream();
     }
 
-    assert(pimpl_->stream_.has_value());
-    byte output_buffer[output_buffer_size];
-    pimpl_->stream_->avail_in = static_cast<uInt>(data.size());
-    pimpl_->stream_->next_in = const_cast<telnetpp::byte *>(data.data());
-    pimpl_->stream_->avail_out = output_buffer_size;
-    pimpl_->stream_->next_out = output_buffer;
-
-    [[maybe_unused]] auto response = deflate(&*pimpl_->stream_, Z_SYNC_FLUSH);
-    assert(response == Z_OK);
-
-    auto const output_data =
-        telnetpp::bytes{output_buffer, pimpl_->stream_->next_out};
+    assert(pimpl_->stream_);
+    pimpl_->stream_->z.avail_in = static_cast<uInt>(data.size());
+    pimpl_->stream_->z.next_in = const_cast<telnetpp::byte *>(data.data());
+    pimpl_->unflushed_size_ += data.size();
 
-    cont(output_data, false);
+    if (pimpl_->should_flush())
+    {
+        pimpl_->compress(Z_SYNC_FLUSH, cont);
+        count_flush();
+    }
+    else
+    {
+        pimpl_->compress(Z_NO_FLUSH, cont);
+    }
 
-    return data.subspan(data.size() - pimpl_->stream_->avail_in);
+    return data.subspan(data.size() - pimpl_->stream_->z.avail_in);
 }
 
 }  // namespace telnetpp::options::mccp::zlib
@@ -1,42 +1,38 @@
 #include "telnetpp/options/mccp/zlib/decompressor.hpp"
 
-#include <zlib.h>
+#include "telnetpp/options/mccp/zlib/detail/output_buffer.hpp"
+#include "telnetpp/options/mccp/zlib/detail/stream.hpp"
 
-#include <optional>
+#include <algorithm>
 #include <cassert>
+#include <utility>
 
 namespace telnetpp::options::mccp::zlib {
 
-namespace {
-
-// In a Telnet application, we don't expect to be receiving massive amounts
-// of data at a time; usually only a few bytes.  Therefore, it's not necessary
-// to allocate massive blocks of 128KB or 256KB as suggested by the ZLib
-// how-to guide.  Instead, we can just use small blocks on the stack and
-// iterate in the very rare case that a single message yields a block of 1KB
-// or more.
-constexpr std::size_t receive_buffer_size = 1024;
-
-}  // namespace
-
 // ==========================================================================
 // DECOMPRESSOR::IMPL
 // ==========================================================================
 struct decompressor::impl
 {
-    std::optional<z_stream> stream_;
+    impl(std::pmr::memory_resource *resource, stream_pool *pool)
+      : resource_{resource}, pool_{pool}, output_buffer_{resource}
+    {
+    }
+
+    std::pmr::memory_resource *resource_;
+    stream_pool *pool_;
+    detail::stream_ptr stream_;
+    detail::output_buffer output_buffer_;
 
     // ======================================================================
     // CONSTRUCT_STREAM
     // ======================================================================
     void construct_stream()
     {
-        assert(stream_ == std::nullopt);
+        assert(!stream_);
 
-        stream_ = z_stream{};
-
-        [[maybe_unused]] auto result = inflateInit(&*stream_);
-        assert(result == Z_OK);
+        stream_ = pool_ != nullptr ? pool_->acquire()
+                                   : detail::make_inflate_stream(resource_);
     }
 
     // ======================================================================
@@ -44,19 +40,32 @@ struct decompressor::impl
     // ======================================================================
     void destroy_stream()
     {
-        assert(stream_ != std::nullopt);
-
-        [[maybe_unused]] auto result = inflateEnd(&*stream_);
-        assert(result == Z_OK || result == Z_STREAM_ERROR);
-
-        stream_ = std::nullopt;
+        assert(stream_);
+
+        if (pool_ != nullptr)
+        {
+            pool_->release(std::move(stream_));
+        }
+        else
+        {
+            stream_.reset();
+        }
     }
 };
 
 // ==========================================================================
 // CONSTRUCTOR
 // ==========================================================================
-decompressor::decompressor() : pimpl_(new impl)
+decompressor::decompressor(std::pmr::memory_resource *resource)
+  : pimpl_(std::make_unique<impl>(resource, nullptr))
+{
+}
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+decompressor::decompressor(decompression_stream_pool &pool)
+  : pimpl_(std::make_unique<impl>(pool.resource(), &pool))
 {
 }
 
@@ -100,14 +109,49 @@ telnetpp::bytes decompressor::transform_chunk(
         pimpl_->construct_stream();
     }
 
-    assert(pimpl_->stream_.has_value());
-    byte receive_buffer[receive_buffer_size];
-    pimpl_->stream_->avail_in = static_cast<uInt>(data.size());
-    pimpl_->stream_->next_in = const_cast<telnetpp::byte *>(data.data());
-    pimpl_->stream_->avail_out = receive_buffer_size;
-    pimpl_->stream_->next_out = receive_buffer;
+    assert(pimpl_->stream_);
+    auto &z = pimpl_->stream_->z;
+    auto &output_buffer = pimpl_->output_buffer_;
+    z.avail_in = static_cast<uInt>(data.size());
+    z.next_in = const_cast<telnetpp::byte *>(data.data());
 
-    auto response = inflate(&*pimpl_->stream_, Z_SYNC_FLUSH);
+    // Compressed text commonly expands several times over, so room is made
+    // for that up front.  Anything larger grows the buffer so that all of
+    // the data is still passed on in one piece, up to a limit.
+    output_buffer.begin(
+        z,
+        std::min(data.size() * 4, detail::output_buffer::max_inflated_size));
+
+    auto response = inflate(&z, Z_SYNC_FLUSH);
+    bool passed_on_full_buffer = false;
+
+    while (response == Z_OK && z.avail_out == 0)
+    {
+        if (output_buffer.capacity()
+            <= detail::output_buffer::max_inflated_size / 2)
+        {
+            output_buffer.grow(z);
+        }
+        else
+        {
+            // The buffer may grow no further, so what it holds is passed on
+            // and it is filled again from the start.  The continuation may
+            // finish the stream, in which case the rest of the data is
+            // handed back so that it is not decompressed.
+            auto const unconsumed_size = z.avail_in;
+            cont(output_buffer.data(z), false);
+
+            if (!pimpl_->stream_)
+            {
+                return data.last(unconsumed_size);
+            }
+
+            passed_on_full_buffer = true;
+            output_buffer.begin(z);
+        }
+
+        response = inflate(&z, Z_SYNC_FLUSH);
+    }
 
     if (response == Z_DATA_ERROR)
     {
@@ -115,20 +159,27 @@ telnetpp::bytes decompressor::transform_chunk(
             "Inflation of byte in ZLib stream yielded Z_DATA_ERROR");
     }
 
-    assert(response == Z_OK || response == Z_STREAM_END);
-
-    auto const received_data =
-        telnetpp::bytes{receive_buffer, pimpl_->stream_->next_out};
+    assert(
+        response == Z_OK || response == Z_STREAM_END
+        || response == Z_BUF_ERROR);
 
+    auto const received_data = output_buffer.data(z);
     bool const stream_ended = response == Z_STREAM_END;
-    data = data.subspan(data.size() - pimpl_->stream_->avail_in);
+    data = data.subspan(data.size() - z.avail_in);
 
     if (stream_ended)
     {
         pimpl_->destroy_stream();
     }
 
-    cont(received_data, stream_ended);
+    // Output that exactly filled the buffer is not followed by an empty
+    // piece.
+    if (!passed_on_full_buffer || !received_data.empty() || stream_ended)
+    {
+        cont(received_data, stream_ended);
+    }
+
+    output_buffer.trim(received_data);
 
     return data;
 }
@@ -0,0 +1,168 @@
+#include "telnetpp/options/mccp/zlib/detail/stream.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+namespace telnetpp::options::mccp::zlib::detail {
+
+namespace {
+
+// zlib's free function is not told the size of the block being freed,
+// which a memory resource requires, so each block is prefixed with its
+// size, padded to keep the block aligned.
+constexpr std::size_t allocation_alignment = alignof(std::max_align_t);
+constexpr std::size_t allocation_header_size = allocation_alignment;
+
+// ==========================================================================
+// ALLOCATE
+// ==========================================================================
+voidpf allocate(voidpf opaque, uInt items, uInt size)
+{
+    auto *strm = static_cast<stream *>(opaque);
+    auto const block_size = std::size_t{items} * size;
+    std::byte *block = nullptr;
+
+    try
+    {
+        block = static_cast<std::byte *>(strm->resource->allocate(
+            allocation_header_size + block_size, allocation_alignment));
+    }
+    catch (std::bad_alloc const &)
+    {
+        // zlib reports allocation failures as Z_MEM_ERROR.
+        return Z_NULL;
+    }
+
+    std::memcpy(block, &block_size, sizeof(block_size));
+    strm->memory_usage += block_size;
+    return block + allocation_header_size;
+}
+
+// ==========================================================================
+// DEALLOCATE
+// ==========================================================================
+void deallocate(voidpf opaque, voidpf address)
+{
+    auto *strm = static_cast<stream *>(opaque);
+    auto *block = static_cast<std::byte *>(address) - allocation_header_size;
+
+    std::size_t block_size = 0;
+    std::memcpy(&block_size, block, sizeof(block_size));
+    strm->memory_usage -= block_size;
+    strm->resource->deallocate(
+        block, allocation_header_size + block_size, allocation_alignment);
+}
+
+// ==========================================================================
+// MAKE_STREAM
+// ==========================================================================
+template <typename Initializer>
+stream_ptr make_stream(
+    std::pmr::memory_resource *resource,
+    bool deflating,
+    Initializer &&initialize)
+{
+    std::pmr::polymorphic_allocator<stream> allocator{resource};
+    auto *strm = allocator.allocate(1);
+    allocator.construct(strm, resource);
+
+    strm->deflating = deflating;
+    strm->z.zalloc = &allocate;
+    strm->z.zfree = &deallocate;
+    strm->z.opaque = strm;
+
+    if (auto const result = initialize(strm->z); result != Z_OK)
+    {
+        // zlib frees anything that it allocated before failing.
+        allocator.deallocate(strm, 1);
+        assert(result == Z_MEM_ERROR);
+        throw std::bad_alloc{};
+    }
+
+    return stream_ptr{strm};
+}
+
+}  // namespace
+
+// ==========================================================================
+// STREAM_DELETER::OPERATOR()
+// ==========================================================================
+void stream_deleter::operator()(stream *strm) const noexcept
+{
+    [[maybe_unused]] auto const result =
+        strm->deflating ? deflateEnd(&strm->z) : inflateEnd(&strm->z);
+    assert(
+        result == Z_OK || result == Z_STREAM_ERROR || result == Z_DATA_ERROR);
+
+    std::pmr::polymorphic_allocator<stream> allocator{strm->resource};
+    std::destroy_at(strm);
+    allocator.deallocate(strm, 1);
+}
+
+// ==========================================================================
+// VALIDATE_PARAMETERS
+// ==========================================================================
+compression_parameters const &validate_parameters(
+    compression_parameters const &parameters)
+{
+    if (parameters.level < Z_DEFAULT_COMPRESSION
+        || parameters.level > Z_BEST_COMPRESSION)
+    {
+        throw std::invalid_argument("compression level out of range");
+    }
+
+    if (parameters.window_bits < 9 || parameters.window_bits > MAX_WBITS)
+    {
+        throw std::invalid_argument("compression window bits out of range");
+    }
+
+    if (parameters.memory_level < 1 || parameters.memory_level > MAX_MEM_LEVEL)
+    {
+        throw std::invalid_argument("compression memory level out of range");
+    }
+
+    return parameters;
+}
+
+// ==========================================================================
+// MAKE_DEFLATE_STREAM
+// ==========================================================================
+stream_ptr make_deflate_stream(
+    compression_parameters const &parameters,
+    std::pmr::memory_resource *resource)
+{
+    return make_stream(resource, true, [&parameters](z_stream &z) {
+        return deflateInit2(
+            &z,
+            parameters.level,
+            Z_DEFLATED,
+            parameters.window_bits,
+            parameters.memory_level,
+            Z_DEFAULT_STRATEGY);
+    });
+}
+
+// ==========================================================================
+// MAKE_INFLATE_STREAM
+// ==========================================================================
+stream_ptr make_inflate_stream(std::pmr::memory_resource *resource)
+{
+    return make_stream(
+        resource, false, [](z_stream &z) { return inflateInit(&z); });
+}
+
+// ==========================================================================
+// RESET_STREAM
+// ==========================================================================
+bool reset_stream(stream &strm) noexcept
+{
+    auto const result =
+        strm.deflating ? deflateReset(&strm.z) : inflateReset(&strm.z);
+
+    return result == Z_OK;
+}
+
+}  // namespace telnetpp::options::mccp::zlib::detail
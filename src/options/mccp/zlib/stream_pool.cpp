@@ -0,0 +1,180 @@
+#include "telnetpp/options/mccp/zlib/stream_pool.hpp"
+
+#include "telnetpp/options/mccp/zlib/detail/stream.hpp"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace telnetpp::options::mccp::zlib {
+
+// ==========================================================================
+// STREAM_POOL::IMPL
+// ==========================================================================
+struct stream_pool::impl
+{
+    impl(std::size_t capacity, std::pmr::memory_resource *resource)
+      : capacity_{capacity}, resource_{resource}
+    {
+        streams_.reserve(capacity_);
+    }
+
+    std::size_t const capacity_;
+    std::pmr::memory_resource *const resource_;
+
+    mutable std::mutex mutex_;
+    std::vector<stream_ptr> streams_;
+    std::size_t hits_{0};
+    std::size_t misses_{0};
+};
+
+// ==========================================================================
+// STREAM_POOL::CONSTRUCTOR
+// ==========================================================================
+stream_pool::stream_pool(
+    std::size_t capacity, std::pmr::memory_resource *resource)
+  : pimpl_(std::make_unique<impl>(capacity, resource))
+{
+}
+
+// ==========================================================================
+// STREAM_POOL::DESTRUCTOR
+// ==========================================================================
+stream_pool::~stream_pool() = default;
+
+// ==========================================================================
+// STREAM_POOL::CAPACITY
+// ==========================================================================
+std::size_t stream_pool::capacity() const noexcept
+{
+    return pimpl_->capacity_;
+}
+
+// ==========================================================================
+// STREAM_POOL::RESOURCE
+// ==========================================================================
+std::pmr::memory_resource *stream_pool::resource() const noexcept
+{
+    return pimpl_->resource_;
+}
+
+// ==========================================================================
+// STREAM_POOL::SIZE
+// ==========================================================================
+std::size_t stream_pool::size() const
+{
+    std::scoped_lock lock{pimpl_->mutex_};
+    return pimpl_->streams_.size();
+}
+
+// ==========================================================================
+// STREAM_POOL::HITS
+// ==========================================================================
+std::size_t stream_pool::hits() const
+{
+    std::scoped_lock lock{pimpl_->mutex_};
+    return pimpl_->hits_;
+}
+
+// ==========================================================================
+// STREAM_POOL::MISSES
+// ==========================================================================
+std::size_t stream_pool::misses() const
+{
+    std::scoped_lock lock{pimpl_->mutex_};
+    return pimpl_->misses_;
+}
+
+// ==========================================================================
+// STREAM_POOL::ACQUIRE
+// ==========================================================================
+stream_pool::stream_ptr stream_pool::acquire()
+{
+    {
+        std::scoped_lock lock{pimpl_->mutex_};
+
+        if (!pimpl_->streams_.empty())
+        {
+            auto strm = std::move(pimpl_->streams_.back());
+            pimpl_->streams_.pop_back();
+            ++pimpl_->hits_;
+            return strm;
+        }
+
+        ++pimpl_->misses_;
+    }
+
+    // Creating the stream is the expensive part, so it is done outside of
+    // the lock.
+    return make_stream();
+}
+
+// ==========================================================================
+// STREAM_POOL::RELEASE
+// ==========================================================================
+void stream_pool::release(stream_ptr strm) noexcept
+{
+    // Resetting the stream is done outside of the lock.  A stream that
+    // cannot be reset is simply freed.
+    if (!strm || !detail::reset_stream(*strm))
+    {
+        return;
+    }
+
+    std::scoped_lock lock{pimpl_->mutex_};
+
+    if (pimpl_->streams_.size() < pimpl_->capacity_)
+    {
+        // The storage for the streams is reserved up front, so this cannot
+        // throw.
+        pimpl_->streams_.push_back(std::move(strm));
+    }
+}
+
+// ==========================================================================
+// COMPRESSION_STREAM_POOL::CONSTRUCTOR
+// ==========================================================================
+compression_stream_pool::compression_stream_pool(
+    std::size_t capacity,
+    compression_parameters const &parameters,
+    std::pmr::memory_resource *resource)
+  : stream_pool(capacity, resource),
+    parameters_{detail::validate_parameters(parameters)}
+{
+}
+
+// ==========================================================================
+// COMPRESSION_STREAM_POOL::PARAMETERS
+// ==========================================================================
+compression_parameters const &compression_stream_pool::parameters()
+    const noexcept
+{
+    return parameters_;
+}
+
+// ==========================================================================
+// COMPRESSION_STREAM_POOL::MAKE_STREAM
+// ==========================================================================
+stream_pool::stream_ptr compression_stream_pool::make_stream() const
+{
+    return detail::make_deflate_stream(parameters_, resource());
+}
+
+// ==========================================================================
+// DECOMPRESSION_STREAM_POOL::CONSTRUCTOR
+// ==========================================================================
+decompression_stream_pool::decompression_stream_pool(
+    std::size_t capacity, std::pmr::memory_resource *resource)
+  : stream_pool(capacity, resource)
+{
+}
+
+// ==========================================================================
+// DECOMPRESSION_STREAM_POOL::MAKE_STREAM
+// ==========================================================================
+stream_pool::stream_ptr decompression_stream_pool::make_stream() const
+{
+    return detail::make_inflate_stream(resource());
+}
+
+}  // namespace telnetpp::options::mccp::zlib
@@ -0,0 +1,257 @@
+#include "telnetpp/options/mccp/zstd/compressor.hpp"
+
+#include "telnetpp/options/mccp/zstd/detail/output_buffer.hpp"
+
+#include <zstd.h>
+#include <zstd_errors.h>
+
+#include <new>
+#include <stdexcept>
+
+namespace telnetpp::options::mccp::zstd {
+
+namespace {
+
+struct context_deleter
+{
+    void operator()(ZSTD_CCtx *context) const noexcept
+    {
+        ZSTD_freeCCtx(context);
+    }
+};
+
+using context_ptr = std::unique_ptr<ZSTD_CCtx, context_deleter>;
+
+// ==========================================================================
+// VALIDATE_LEVEL
+// ==========================================================================
+int validate_level(int level)
+{
+    if (level < ZSTD_minCLevel() || level > ZSTD_maxCLevel())
+    {
+        throw std::invalid_argument("compression level out of range");
+    }
+
+    return level;
+}
+
+// ==========================================================================
+// CHECK
+// ==========================================================================
+std::size_t check(std::size_t result)
+{
+    if (ZSTD_isError(result))
+    {
+        if (ZSTD_getErrorCode(result) == ZSTD_error_memory_allocation)
+        {
+            throw std::bad_alloc{};
+        }
+
+        throw std::runtime_error(ZSTD_getErrorName(result));
+    }
+
+    return result;
+}
+
+}  // namespace
+
+// ==========================================================================
+// COMPRESSOR::IMPL
+// ==========================================================================
+struct compressor::impl
+{
+    impl(int level, std::pmr::memory_resource *resource)
+      : level_{validate_level(level)}, output_buffer_{resource}
+    {
+    }
+
+    int level_;
+    context_ptr context_;
+    detail::output_buffer output_buffer_;
+
+    flush_policy flush_policy_{flush_policy::every_write};
+    std::size_t flush_threshold_{default_flush_threshold};
+    std::size_t unflushed_size_{0};
+
+    // ======================================================================
+    // CONTEXT
+    // ======================================================================
+    // The context is created when it is first needed, and then kept for
+    // every following stream, since Zstandard can reset it cheaply.
+    ZSTD_CCtx *context()
+    {
+        if (!context_)
+        {
+            context_.reset(ZSTD_createCCtx());
+
+            if (!context_)
+            {
+                throw std::bad_alloc{};
+            }
+
+            check(ZSTD_CCtx_setParameter(
+                context_.get(), ZSTD_c_compressionLevel, level_));
+        }
+
+        return context_.get();
+    }
+
+    // ======================================================================
+    // SHOULD_FLUSH
+    // ======================================================================
+    [[nodiscard]] bool should_flush() const noexcept
+    {
+        switch (flush_policy_)
+        {
+            case flush_policy::every_write:
+                return true;
+
+            case flush_policy::explicit_only:
+                return false;
+
+            case flush_policy::threshold:
+                return unflushed_size_ >= flush_threshold_;
+        }
+
+        return true;
+    }
+
+    // ======================================================================
+    // COMPRESS
+    // ======================================================================
+    void compress(
+        telnetpp::bytes data,
+        ZSTD_EndDirective directive,
+        continuation const &cont)
+    {
+        auto *const ctx = context();
+        ZSTD_inBuffer in{data.data(), data.size(), 0};
+        ZSTD_outBuffer out{};
+        output_buffer_.begin(out, ZSTD_compressBound(data.size()));
+
+        // All of the input is consumed and, when flushing or ending, all of
+        // the output is collected, so that it can be sent in one piece.
+        for (;;)
+        {
+            auto const remaining =
+                check(ZSTD_compressStream2(ctx, &out, &in, directive));
+
+            if (directive == ZSTD_e_continue ? in.pos == in.size
+                                             : remaining == 0)
+            {
+                break;
+            }
+
+            if (out.pos == out.size)
+            {
+                output_buffer_.grow(out);
+            }
+        }
+
+        if (directive != ZSTD_e_continue)
+        {
+            unflushed_size_ = 0;
+        }
+
+        auto const output_data = output_buffer_.data(out);
+        bool const stream_ended = directive == ZSTD_e_end;
+
+        if (!output_data.empty() || stream_ended)
+        {
+            cont(output_data, stream_ended);
+        }
+
+        output_buffer_.trim(output_data);
+    }
+};
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+compressor::compressor(int level, std::pmr::memory_resource *resource)
+  : pimpl_(std::make_unique<impl>(level, resource))
+{
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+compressor::~compressor() = default;
+
+// ==========================================================================
+// LEVEL
+// ==========================================================================
+int compressor::level() const noexcept
+{
+    return pimpl_->level_;
+}
+
+// ==========================================================================
+// SET_FLUSH_POLICY
+// ==========================================================================
+void compressor::set_flush_policy(
+    flush_policy policy, std::size_t threshold) noexcept
+{
+    pimpl_->flush_policy_ = policy;
+    pimpl_->flush_threshold_ = threshold;
+}
+
+// ==========================================================================
+// DO_START
+// ==========================================================================
+void compressor::do_start()
+{
+    if (pimpl_->context_)
+    {
+        ZSTD_CCtx_reset(pimpl_->context_.get(), ZSTD_reset_session_only);
+    }
+
+    pimpl_->unflushed_size_ = 0;
+}
+
+// ==========================================================================
+// DO_FINISH
+// ==========================================================================
+void compressor::do_finish(continuation const &cont)
+{
+    pimpl_->compress({}, ZSTD_e_end, cont);
+}
+
+// ==========================================================================
+// DO_FLUSH
+// ==========================================================================
+void compressor::do_flush(continuation const &cont)
+{
+    // There is nothing to flush if nothing has been written since the
+    // last flush.
+    if (pimpl_->unflushed_size_ == 0)
+    {
+        return;
+    }
+
+    pimpl_->compress({}, ZSTD_e_flush, cont);
+    count_flush();
+}
+
+// ==========================================================================
+// TRANSFORM_CHUNK
+// ==========================================================================
+telnetpp::bytes compressor::transform_chunk(
+    telnetpp::bytes data, continuation const &cont)
+{
+    pimpl_->unflushed_size_ += data.size();
+
+    if (pimpl_->should_flush())
+    {
+        pimpl_->compress(data, ZSTD_e_flush, cont);
+        count_flush();
+    }
+    else
+    {
+        pimpl_->compress(data, ZSTD_e_continue, cont);
+    }
+
+    return {};
+}
+
+}  // namespace telnetpp::options::mccp::zstd
@@ -0,0 +1,184 @@
+#include "telnetpp/options/mccp/zstd/decompressor.hpp"
+
+#include "telnetpp/options/mccp/zstd/detail/output_buffer.hpp"
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <new>
+
+namespace telnetpp::options::mccp::zstd {
+
+namespace {
+
+struct context_deleter
+{
+    void operator()(ZSTD_DCtx *context) const noexcept
+    {
+        ZSTD_freeDCtx(context);
+    }
+};
+
+using context_ptr = std::unique_ptr<ZSTD_DCtx, context_deleter>;
+
+}  // namespace
+
+// ==========================================================================
+// DECOMPRESSOR::IMPL
+// ==========================================================================
+struct decompressor::impl
+{
+    explicit impl(std::pmr::memory_resource *resource)
+      : output_buffer_{resource}
+    {
+    }
+
+    context_ptr context_;
+    detail::output_buffer output_buffer_;
+
+    // Set when the stream is finished, so that a transformation can tell
+    // whether its continuation finished it.
+    bool finished_{false};
+
+    // ======================================================================
+    // CONTEXT
+    // ======================================================================
+    // The context is created when it is first needed, and then kept for
+    // every following stream, since Zstandard can reset it cheaply.
+    ZSTD_DCtx *context()
+    {
+        if (!context_)
+        {
+            context_.reset(ZSTD_createDCtx());
+
+            if (!context_)
+            {
+                throw std::bad_alloc{};
+            }
+        }
+
+        return context_.get();
+    }
+
+    // ======================================================================
+    // RESET
+    // ======================================================================
+    void reset() noexcept
+    {
+        if (context_)
+        {
+            ZSTD_DCtx_reset(context_.get(), ZSTD_reset_session_only);
+        }
+    }
+};
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+decompressor::decompressor(std::pmr::memory_resource *resource)
+  : pimpl_(std::make_unique<impl>(resource))
+{
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+decompressor::~decompressor() = default;
+
+// ==========================================================================
+// DO_START
+// ==========================================================================
+void decompressor::do_start()
+{
+    pimpl_->reset();
+}
+
+// ==========================================================================
+// DO_FINISH
+// ==========================================================================
+void decompressor::do_finish(continuation const & /*cont*/)
+{
+    pimpl_->reset();
+    pimpl_->finished_ = true;
+}
+
+// ==========================================================================
+// TRANSFORM_CHUNK
+// ==========================================================================
+telnetpp::bytes decompressor::transform_chunk(
+    telnetpp::bytes data, continuation const &cont)
+{
+    auto *const ctx = pimpl_->context();
+    auto &output_buffer = pimpl_->output_buffer_;
+    ZSTD_inBuffer in{data.data(), data.size(), 0};
+    pimpl_->finished_ = false;
+
+    // As with zlib, compressed text commonly expands several times over,
+    // so room is made for that up front, up to the same limit.
+    ZSTD_outBuffer out{};
+    output_buffer.begin(
+        out,
+        std::min(data.size() * 4, detail::output_buffer::max_inflated_size));
+    bool stream_ended = false;
+
+    for (;;)
+    {
+        auto const result = ZSTD_decompressStream(ctx, &out, &in);
+
+        if (ZSTD_isError(result))
+        {
+            pimpl_->reset();
+            throw corrupted_stream_error(ZSTD_getErrorName(result));
+        }
+
+        if (result == 0)
+        {
+            // The frame has been decoded and flushed in full.  Anything
+            // that follows it is not part of the stream.
+            stream_ended = true;
+            pimpl_->reset();
+            break;
+        }
+
+        if (out.pos < out.size && in.pos == in.size)
+        {
+            break;
+        }
+
+        if (out.pos == out.size)
+        {
+            if (output_buffer.capacity()
+                <= detail::output_buffer::max_inflated_size / 2)
+            {
+                output_buffer.grow(out);
+            }
+            else
+            {
+                // The buffer may grow no further, so what it holds is
+                // passed on and it is filled again from the start.  As with
+                // zlib, if the continuation finishes the stream, the rest of
+                // the data is handed back so that it is not decompressed.
+                cont(output_buffer.data(out), false);
+
+                if (pimpl_->finished_)
+                {
+                    return data.subspan(in.pos);
+                }
+
+                output_buffer.begin(out);
+            }
+        }
+    }
+
+    auto const received_data = output_buffer.data(out);
+
+    if (!received_data.empty() || stream_ended)
+    {
+        cont(received_data, stream_ended);
+    }
+
+    output_buffer.trim(received_data);
+    return data.subspan(in.pos);
+}
+
+}  // namespace telnetpp::options::mccp::zstd
@@ -0,0 +1,62 @@
+#include "telnetpp/options/mccp3/client.hpp"
+
+#include "telnetpp/options/mccp3/detail/protocol.hpp"
+
+#include <utility>
+
+namespace telnetpp::options::mccp3 {
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+client::client(
+    telnetpp::session &sess,
+    mccp::codec &cdc,
+    mccp::codec::continuation send)
+  : client_option(sess, detail::option),
+    codec_(cdc),
+    send_(std::move(send)),
+    compression_active_(false)
+{
+    on_state_changed.connect([this]() {
+        if (!active())
+        {
+            finish_compression();
+        }
+    });
+}
+
+// ==========================================================================
+// START_COMPRESSION
+// ==========================================================================
+void client::start_compression()
+{
+    if (active() && !compression_active_)
+    {
+        write_subnegotiation({});
+        codec_.start();
+        compression_active_ = true;
+    }
+}
+
+// ==========================================================================
+// FINISH_COMPRESSION
+// ==========================================================================
+void client::finish_compression()
+{
+    if (compression_active_)
+    {
+        codec_.finish(send_);
+        compression_active_ = false;
+    }
+}
+
+// ==========================================================================
+// HANDLE_SUBNEGOTIATION
+// ==========================================================================
+void client::handle_subnegotiation(telnetpp::bytes /*data*/)
+{
+    // MCCP3 defines no subnegotiations from the server.
+}
+
+}  // namespace telnetpp::options::mccp3
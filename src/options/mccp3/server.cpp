@@ -0,0 +1,34 @@
+#include "telnetpp/options/mccp3/server.hpp"
+
+#include "telnetpp/options/mccp/codec.hpp"
+#include "telnetpp/options/mccp3/detail/protocol.hpp"
+
+namespace telnetpp::options::mccp3 {
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+server::server(telnetpp::session &sess, mccp::codec &cdc)
+  : server_option(sess, detail::option), codec_(cdc)
+{
+    on_state_changed.connect([this]() {
+        if (!active())
+        {
+            // Any data still held by the codec is the incomplete end of a
+            // compressed stream, so there is nothing to pass on.
+            codec_.finish([](telnetpp::bytes, bool) {});
+        }
+    });
+}
+
+// ==========================================================================
+// HANDLE_SUBNEGOTIATION
+// ==========================================================================
+void server::handle_subnegotiation(telnetpp::bytes /*data*/)
+{
+    // Everything that the client sends after this subnegotiation is
+    // compressed.
+    codec_.start();
+}
+
+}  // namespace telnetpp::options::mccp3
@@ -1,6 +1,5 @@
 #include "telnetpp/options/msdp/client.hpp"
 
-#include "telnetpp/options/msdp/detail/decoder.hpp"
 #include "telnetpp/options/msdp/detail/encoder.hpp"
 #include "telnetpp/options/msdp/detail/protocol.hpp"
 
@@ -19,8 +18,20 @@ client::client(telnetpp::session &sess) noexcept
 // ==========================================================================
 void client::send(variable const &var)
 {
-    detail::encode(
-        var, [this](telnetpp::bytes data) { write_subnegotiation(data); });
+    send_buffer_(
+        detail::subnegotiation_size(var),
+        [&](std::span<telnetpp::byte> buffer) {
+            return detail::encode_subnegotiation(var, buffer);
+        },
+        [this](telnetpp::bytes frame) { write_encoded_subnegotiation(frame); });
+}
+
+// ==========================================================================
+// SET_NAME_TABLE
+// ==========================================================================
+void client::set_name_table(name_table names) noexcept
+{
+    decoder_.set_name_table(names);
 }
 
 // ==========================================================================
@@ -28,7 +39,26 @@ void client::send(variable const &var)
 // ==========================================================================
 void client::handle_subnegotiation(telnetpp::bytes data)
 {
-    detail::decode(data, [&](auto const &var) { on_receive(var); });
+    decoder_(data, [this](variable_view const &view) {
+        on_receive_view(view);
+
+        if (!on_receive.empty())
+        {
+            on_receive(to_variable(view));
+        }
+    });
+}
+
+// ==========================================================================
+// HANDLE_SUBNEGOTIATION_EVENT
+// ==========================================================================
+void client::handle_subnegotiation_event(
+    telnetpp::subnegotiation_event const &event)
+{
+    if (event.is_first())
+    {
+        on_oversized_message();
+    }
 }
 
 }  // namespace telnetpp::options::msdp
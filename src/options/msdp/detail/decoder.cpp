@@ -13,153 +13,149 @@ namespace {
 
 using variable = telnetpp::options::msdp::variable;
 
-class parser
+// The parser is a template so that the tree builder's events are not
+// dispatched virtually.
+template <typename Handler>
+class event_parser
 {
    public:
     // ======================================================================
     // CONSTRUCTOR
     // ======================================================================
-    explicit parser(std::function<void(variable const &)> cont)
-      : cont_(std::move(cont))
+    event_parser(telnetpp::bytes data, Handler &handler)
+      : data_(data), handler_(handler)
     {
     }
 
     // ======================================================================
     // OPERATOR()
     // ======================================================================
-    void operator()(byte data)
+    void operator()()
     {
-        switch (state_)
+        for (std::size_t index = 0; index < data_.size(); ++index)
         {
-            case state::idle:
-                parse_idle(data);
-                break;
+            switch (state_)
+            {
+                case state::idle:
+                    parse_idle(index);
+                    break;
+
+                case state::name:
+                    parse_name(index);
+                    break;
+
+                case state::value:
+                    parse_value(index);
+                    break;
+
+                case state::array:
+                    parse_array(index);
+                    break;
+
+                default:
+                    assert(!"invalid state");
+                    break;
+            }
+        }
+    }
 
+    // ======================================================================
+    // FINISH
+    // ======================================================================
+    void finish()
+    {
+        // Whatever was being decoded when the data ended is kept, as far as
+        // it got, and everything that is open is then closed.
+        switch (state_)
+        {
             case state::name:
-                parse_name(data);
+                handler_.on_var_name(rest_of_data(data_.size()));
+                close_variable();
                 break;
 
             case state::value:
-                parse_value(data);
+                handler_.on_string_value(rest_of_data(data_.size()));
+                close_variable();
                 break;
 
             case state::array:
-                parse_array(data);
+                end_element(data_.size());
+                handler_.on_array_end();
+                close_variable();
                 break;
 
             default:
-                assert(!"invalid state");
                 break;
         }
-    }
 
-    // ======================================================================
-    // FINISH
-    // ======================================================================
-    void finish()
-    {
-        if (!var_.name_.empty())
+        while (depth_ != 0)
         {
-            cont_(var_);
+            handler_.on_table_end();
+            close_variable();
         }
-    }
-
-   private:
-    // ======================================================================
-    // TOP
-    // ======================================================================
-    auto &top()
-    {
-        return *current_var_.back();
-    }
-
-    // ======================================================================
-    // VALUE
-    // ======================================================================
-    auto &value()
-    {
-        return top().value_;
-    }
-
-    // ======================================================================
-    // VALUE_AS_STRING
-    // ======================================================================
-    auto &value_as_string()
-    {
-        return std::get<string_value>(value());
-    }
 
-    // ======================================================================
-    // VALUE_AS_ARRAY
-    // ======================================================================
-    auto &value_as_array()
-    {
-        return std::get<array_value>(value());
+        state_ = state::idle;
     }
 
+   private:
     // ======================================================================
-    // VALUE_AS_TABLE
+    // REST_OF_DATA
     // ======================================================================
-    auto &value_as_table()
+    telnetpp::bytes rest_of_data(std::size_t index) const
     {
-        return std::get<table_value>(value());
+        return data_.subspan(start_, index - start_);
     }
 
     // ======================================================================
-    // NAME
+    // OPEN_VARIABLE
     // ======================================================================
-    auto &name()
+    void open_variable(std::size_t index)
     {
-        return top().name_;
+        ++depth_;
+        start_ = index + 1;
+        state_ = state::name;
     }
 
     // ======================================================================
-    // OPEN_VARIABLE
+    // CLOSE_VARIABLE
     // ======================================================================
-    void open_variable()
+    void close_variable()
     {
-        if (current_var_.empty())
-        {
-            var_ = variable{};
-            current_var_.push_back(&var_);
-        }
-        else
-        {
-            auto &outer_var = value_as_table();
-            outer_var.emplace_back();
-            current_var_.push_back(&outer_var.back());
-        }
+        --depth_;
+        handler_.on_var_end();
     }
 
     // ======================================================================
-    // CLOSE_VARIABLE
+    // END_ELEMENT
     // ======================================================================
-    void close_variable()
+    void end_element(std::size_t index)
     {
-        current_var_.pop_back();
-
-        if (current_var_.empty())
+        // Anything before the first element is ignored.
+        if (in_element_)
         {
-            cont_(var_);
-            var_ = {};
+            handler_.on_array_element(rest_of_data(index));
+            in_element_ = false;
         }
     }
 
     // ======================================================================
     // PARSE_IDLE
     // ======================================================================
-    void parse_idle(byte data)
+    void parse_idle(std::size_t index)
     {
-        switch (data)
+        switch (data_[index])
         {
             case telnetpp::options::msdp::detail::var:
-                open_variable();
-                state_ = state::name;
+                open_variable(index);
                 break;
 
             case telnetpp::options::msdp::detail::table_close:
-                close_variable();
-                state_ = state::idle;
+                // A stray close with no variable open is ignored.
+                if (depth_ != 0)
+                {
+                    handler_.on_table_end();
+                    close_variable();
+                }
                 break;
 
             default:
@@ -170,49 +166,47 @@ class parser
     // ======================================================================
     // PARSE_NAME
     // ======================================================================
-    void parse_name(byte data)
+    void parse_name(std::size_t index)
     {
-        if (data == telnetpp::options::msdp::detail::val)
+        if (data_[index] == telnetpp::options::msdp::detail::val)
         {
+            handler_.on_var_name(rest_of_data(index));
+            start_ = index + 1;
             state_ = state::value;
-            value() = string_value{};
-        }
-        else
-        {
-            name() += data;
         }
     }
 
     // ======================================================================
     // PARSE_VALUE
     // ======================================================================
-    void parse_value(byte data)
+    void parse_value(std::size_t index)
     {
-        switch (data)
+        switch (data_[index])
         {
             case telnetpp::options::msdp::detail::array_open:
-                value() = array_value{};
+                handler_.on_array_begin();
+                in_element_ = false;
                 state_ = state::array;
                 break;
 
             case telnetpp::options::msdp::detail::table_open:
-                value() = table_value{};
+                handler_.on_table_begin();
                 state_ = state::idle;
                 break;
 
             case telnetpp::options::msdp::detail::table_close:
+                handler_.on_string_value(rest_of_data(index));
                 close_variable();
                 state_ = state::idle;
                 break;
 
             case telnetpp::options::msdp::detail::var:
+                handler_.on_string_value(rest_of_data(index));
                 close_variable();
-                open_variable();
-                state_ = state::name;
+                open_variable(index);
                 break;
 
             default:
-                value_as_string() += data;
                 break;
         }
     }
@@ -220,21 +214,24 @@ class parser
     // ======================================================================
     // PARSE_ARRAY
     // ======================================================================
-    void parse_array(byte data)
+    void parse_array(std::size_t index)
     {
-        switch (data)
+        switch (data_[index])
         {
             case telnetpp::options::msdp::detail::array_close:
+                end_element(index);
+                handler_.on_array_end();
                 close_variable();
                 state_ = state::idle;
                 break;
 
             case telnetpp::options::msdp::detail::val:
-                value_as_array().push_back({});
+                end_element(index);
+                in_element_ = true;
+                start_ = index + 1;
                 break;
 
             default:
-                value_as_array().back() += data;
                 break;
         }
     }
@@ -247,28 +244,150 @@ class parser
         array,
     };
 
-    variable var_;
-    std::vector<variable *> current_var_;
+    telnetpp::bytes data_;
+    Handler &handler_;
 
     state state_ = state::idle;
-    std::function<void(variable const &)> cont_;
+    std::size_t start_ = 0;
+    std::size_t depth_ = 0;
+    bool in_element_ = false;
+};
+
+class tree_builder final : public decode_handler
+{
+   public:
+    // ======================================================================
+    // CONSTRUCTOR
+    // ======================================================================
+    explicit tree_builder(std::function<void(variable const &)> const &cont)
+      : cont_(cont)
+    {
+    }
+
+    // ======================================================================
+    // END_OF_DATA
+    // ======================================================================
+    void end_of_data()
+    {
+        end_of_data_ = true;
+    }
+
+    // ======================================================================
+    // ON_VAR_NAME
+    // ======================================================================
+    void on_var_name(telnetpp::bytes name) override
+    {
+        open_variable();
+        top().name_.assign(name.data(), name.size());
+    }
+
+    // ======================================================================
+    // ON_STRING_VALUE
+    // ======================================================================
+    void on_string_value(telnetpp::bytes value) override
+    {
+        top().value_.emplace<string_value>(value.data(), value.size());
+    }
+
+    // ======================================================================
+    // ON_ARRAY_BEGIN
+    // ======================================================================
+    void on_array_begin() override
+    {
+        top().value_ = array_value{};
+    }
+
+    // ======================================================================
+    // ON_ARRAY_ELEMENT
+    // ======================================================================
+    void on_array_element(telnetpp::bytes element) override
+    {
+        std::get<array_value>(top().value_)
+            .emplace_back(element.data(), element.size());
+    }
+
+    // ======================================================================
+    // ON_TABLE_BEGIN
+    // ======================================================================
+    void on_table_begin() override
+    {
+        top().value_ = table_value{};
+    }
+
+    // ======================================================================
+    // ON_VAR_END
+    // ======================================================================
+    void on_var_end() override
+    {
+        current_var_.pop_back();
+
+        if (current_var_.empty())
+        {
+            // A variable that was only closed because the data ended is
+            // passed on only if it has a name.
+            if (!end_of_data_ || !var_.name_.empty())
+            {
+                cont_(var_);
+            }
+
+            var_ = {};
+        }
+    }
+
+   private:
+    // ======================================================================
+    // TOP
+    // ======================================================================
+    variable &top()
+    {
+        return *current_var_.back();
+    }
+
+    // ======================================================================
+    // OPEN_VARIABLE
+    // ======================================================================
+    void open_variable()
+    {
+        if (current_var_.empty())
+        {
+            current_var_.push_back(&var_);
+        }
+        else
+        {
+            auto &outer_var = std::get<table_value>(top().value_);
+            outer_var.emplace_back();
+            current_var_.push_back(&outer_var.back());
+        }
+    }
+
+    variable var_;
+    std::vector<variable *> current_var_;
+    bool end_of_data_ = false;
+    std::function<void(variable const &)> const &cont_;
 };
 
 }  // namespace
 
+// ==========================================================================
+// DECODE
+// ==========================================================================
+void decode(telnetpp::bytes data, decode_handler &handler)
+{
+    event_parser<decode_handler> parse{data, handler};
+    parse();
+    parse.finish();
+}
+
 // ==========================================================================
 // DECODE
 // ==========================================================================
 void decode(
     telnetpp::bytes data, std::function<void(variable const &)> const &cont)
 {
-    parser parse{cont};
-
-    for (auto const &by : data)
-    {
-        parse(by);
-    }
-
+    tree_builder build{cont};
+    event_parser<tree_builder> parse{data, build};
+    parse();
+    build.end_of_data();
     parse.finish();
 }
 
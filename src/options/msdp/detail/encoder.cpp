@@ -3,46 +3,246 @@
 #include "telnetpp/detail/overloaded.hpp"
 #include "telnetpp/options/msdp/detail/protocol.hpp"
 
+#include <algorithm>
+#include <cassert>
+
 using variable = telnetpp::options::msdp::variable;
 
 namespace telnetpp::options::msdp::detail {
 
+namespace {
+
 // ==========================================================================
-// ENCODE_VARIABLE
+// WRITE_VARIABLE
 // ==========================================================================
-void encode_variable(
-    telnetpp::options::msdp::variable const &encode_var,
-    telnetpp::byte_storage &storage)
+// Passes the bytes of an encoded variable to a sink, in order.  This is the
+// only place that knows how a variable is framed; the sink decides what to
+// do with the framing bytes and with the names and values between them.
+template <typename Sink>
+void write_variable(variable const &write_var, Sink &sink)
 {
-    storage.push_back(telnetpp::options::msdp::detail::var);
-    storage += encode_var.name_;
-    storage.push_back(telnetpp::options::msdp::detail::val);
+    sink.put(telnetpp::options::msdp::detail::var);
+    sink.put_string(write_var.name_);
+    sink.put(telnetpp::options::msdp::detail::val);
 
     std::visit(
         telnetpp::detail::overloaded{
-            [&](telnetpp::options::msdp::string_value const &vbl) {
-                storage += vbl;
+            [&sink](telnetpp::options::msdp::string_value const &vbl) {
+                sink.put_string(vbl);
             },
-            [&](telnetpp::options::msdp::array_value const &arr) {
-                storage.push_back(telnetpp::options::msdp::detail::array_open);
+            [&sink](telnetpp::options::msdp::array_value const &arr) {
+                sink.put(telnetpp::options::msdp::detail::array_open);
                 for (auto const &vbl : arr)
                 {
-                    storage.push_back(telnetpp::options::msdp::detail::val);
-                    storage += vbl;
+                    sink.put(telnetpp::options::msdp::detail::val);
+                    sink.put_string(vbl);
                 }
-                storage.push_back(telnetpp::options::msdp::detail::array_close);
+                sink.put(telnetpp::options::msdp::detail::array_close);
             },
-            [&](telnetpp::options::msdp::table_value const &tbl) {
+            [&sink](telnetpp::options::msdp::table_value const &tbl) {
                 for (auto const &vbl : tbl)
                 {
-                    storage.push_back(
-                        telnetpp::options::msdp::detail::table_open);
-                    encode_variable(vbl, storage);
-                    storage.push_back(
-                        telnetpp::options::msdp::detail::table_close);
+                    sink.put(telnetpp::options::msdp::detail::table_open);
+                    write_variable(vbl, sink);
+                    sink.put(telnetpp::options::msdp::detail::table_close);
                 }
             }},
-        encode_var.value_);
+        write_var.value_);
+}
+
+// ==========================================================================
+// COUNTING_SINK
+// ==========================================================================
+// Counts the bytes of an encoding, and separately the IAC bytes in its names
+// and values that escaping would double.
+class counting_sink
+{
+public:
+    void put(telnetpp::byte /*by*/) noexcept
+    {
+        ++size_;
+    }
+
+    void put_string(telnetpp::bytes str) noexcept
+    {
+        size_ += str.size();
+        iacs_ += static_cast<std::size_t>(
+            std::count(str.begin(), str.end(), telnetpp::iac));
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] std::size_t escaped_size() const noexcept
+    {
+        return size_ + iacs_;
+    }
+
+private:
+    std::size_t size_{0};
+    std::size_t iacs_{0};
+};
+
+// ==========================================================================
+// STORAGE_SINK
+// ==========================================================================
+// Appends an encoding to storage as it is, leaving any escaping to be done
+// when it is written.
+class storage_sink
+{
+public:
+    explicit storage_sink(telnetpp::byte_storage &storage) noexcept
+      : storage_{storage}
+    {
+    }
+
+    void put(telnetpp::byte by)
+    {
+        storage_.push_back(by);
+    }
+
+    void put_string(telnetpp::bytes str)
+    {
+        storage_.append(str.data(), str.size());
+    }
+
+private:
+    telnetpp::byte_storage &storage_;
+};
+
+// ==========================================================================
+// ESCAPING_SINK
+// ==========================================================================
+// Writes into a buffer that is known to be large enough, doubling any IAC
+// bytes in names and values as it goes.  The MSDP protocol bytes are never
+// IAC, and so are written as they are.
+class escaping_sink
+{
+public:
+    explicit escaping_sink(telnetpp::byte *out) noexcept : out_{out}
+    {
+    }
+
+    void put(telnetpp::byte by) noexcept
+    {
+        *out_++ = by;
+    }
+
+    void put_string(telnetpp::bytes str) noexcept
+    {
+        // Names and values are usually short, so a simple loop does better
+        // here than searching for each IAC and copying the runs between.
+        for (auto const by : str)
+        {
+            put(by);
+
+            if (by == telnetpp::iac)
+            {
+                put(by);
+            }
+        }
+    }
+
+    [[nodiscard]] telnetpp::byte *position() const noexcept
+    {
+        return out_;
+    }
+
+private:
+    telnetpp::byte *out_;
+};
+
+}  // namespace
+
+// ==========================================================================
+// ENCODE_VARIABLE
+// ==========================================================================
+void encode_variable(
+    telnetpp::options::msdp::variable const &encode_var,
+    telnetpp::byte_storage &storage)
+{
+    // Reserving the whole encoding first means that the storage grows at
+    // most once, however large the variable.
+    storage.reserve(storage.size() + encoded_size(encode_var));
+
+    storage_sink sink{storage};
+    write_variable(encode_var, sink);
+}
+
+// ==========================================================================
+// ENCODED_SIZE
+// ==========================================================================
+std::size_t encoded_size(telnetpp::options::msdp::variable const &size_var)
+{
+    counting_sink sink;
+    write_variable(size_var, sink);
+    return sink.size();
+}
+
+// ==========================================================================
+// SUBNEGOTIATION_SIZE
+// ==========================================================================
+std::size_t subnegotiation_size(
+    telnetpp::options::msdp::variable const &size_var)
+{
+    telnetpp::options::msdp::variable const *const vars[] = {&size_var};
+    return subnegotiation_size(vars);
+}
+
+// ==========================================================================
+// SUBNEGOTIATION_SIZE
+// ==========================================================================
+std::size_t subnegotiation_size(
+    std::span<telnetpp::options::msdp::variable const *const> vars)
+{
+    counting_sink sink;
+
+    for (auto const *size_var : vars)
+    {
+        write_variable(*size_var, sink);
+    }
+
+    // IAC SB MSDP <content> IAC SE
+    return 5 + sink.escaped_size();
+}
+
+// ==========================================================================
+// ENCODE_SUBNEGOTIATION
+// ==========================================================================
+telnetpp::bytes encode_subnegotiation(
+    telnetpp::options::msdp::variable const &encode_var,
+    std::span<telnetpp::byte> buffer)
+{
+    telnetpp::options::msdp::variable const *const vars[] = {&encode_var};
+    return encode_subnegotiation(vars, buffer);
+}
+
+// ==========================================================================
+// ENCODE_SUBNEGOTIATION
+// ==========================================================================
+telnetpp::bytes encode_subnegotiation(
+    std::span<telnetpp::options::msdp::variable const *const> vars,
+    std::span<telnetpp::byte> buffer)
+{
+    assert(buffer.size() >= subnegotiation_size(vars));
+
+    escaping_sink sink{buffer.data()};
+    sink.put(telnetpp::iac);
+    sink.put(telnetpp::sb);
+    sink.put(telnetpp::options::msdp::detail::option);
+
+    for (auto const *encode_var : vars)
+    {
+        write_variable(*encode_var, sink);
+    }
+
+    sink.put(telnetpp::iac);
+    sink.put(telnetpp::se);
+
+    return buffer.first(
+        static_cast<std::size_t>(sink.position() - buffer.data()));
 }
 
 }  // namespace telnetpp::options::msdp::detail
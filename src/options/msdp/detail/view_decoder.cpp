@@ -0,0 +1,305 @@
+#include "telnetpp/options/msdp/detail/view_decoder.hpp"
+
+#include "telnetpp/options/msdp/detail/protocol.hpp"
+
+#include <cassert>
+
+namespace telnetpp::options::msdp::detail {
+
+// ==========================================================================
+// OPERATOR()
+// ==========================================================================
+void view_decoder::operator()(telnetpp::bytes data, continuation const &cont)
+{
+    // The views passed to the continuation refer to this decoder's
+    // storage, so if the continuation decodes again, it must not disturb
+    // them.
+    if (decoding_)
+    {
+        view_decoder inner;
+        inner.set_name_table(names_);
+        inner(data, cont);
+        return;
+    }
+
+    decoding_ = true;
+
+    try
+    {
+        decode(data, cont);
+    }
+    catch (...)
+    {
+        decoding_ = false;
+        throw;
+    }
+
+    decoding_ = false;
+}
+
+// ==========================================================================
+// SET_NAME_TABLE
+// ==========================================================================
+void view_decoder::set_name_table(name_table names) noexcept
+{
+    names_ = names;
+}
+
+// ==========================================================================
+// DECODE
+// ==========================================================================
+void view_decoder::decode(telnetpp::bytes data, continuation const &cont)
+{
+    data_ = data;
+    state_ = state::idle;
+    in_element_ = false;
+    children_.clear();
+    elements_.clear();
+    open_children_.clear();
+    frames_.clear();
+
+    // Every variable is introduced by a VAR and every array element by a
+    // VAL, so these bound the sizes of the arrays and tables.
+    std::size_t variables = 0;
+    std::size_t values = 0;
+
+    for (auto const by : data)
+    {
+        variables += by == var ? 1 : 0;
+        values += by == val ? 1 : 0;
+    }
+
+    children_.reserve(variables);
+    elements_.reserve(values);
+
+    for (std::size_t index = 0; index < data.size(); ++index)
+    {
+        parse(index, cont);
+    }
+
+    finish(cont);
+}
+
+// ==========================================================================
+// PARSE
+// ==========================================================================
+void view_decoder::parse(std::size_t index, continuation const &cont)
+{
+    auto const by = data_[index];
+
+    switch (state_)
+    {
+        case state::idle:
+            if (by == var)
+            {
+                open_variable(index + 1);
+                state_ = state::name;
+            }
+            else if (by == table_close)
+            {
+                close_variable(cont);
+            }
+            break;
+
+        case state::name:
+            if (by == val)
+            {
+                end_name(index);
+                frames_.back().var.value_ = string_value_view{};
+                start_ = index + 1;
+                state_ = state::value;
+            }
+            break;
+
+        case state::value:
+            switch (by)
+            {
+                case array_open:
+                    frames_.back().var.value_ = array_value_view{};
+                    frames_.back().first_element = elements_.size();
+                    in_element_ = false;
+                    state_ = state::array;
+                    break;
+
+                case table_open:
+                    frames_.back().var.value_ = table_value_view{};
+                    frames_.back().first_child = open_children_.size();
+                    state_ = state::idle;
+                    break;
+
+                case table_close:
+                    end_string(index);
+                    close_variable(cont);
+                    state_ = state::idle;
+                    break;
+
+                case var:
+                    end_string(index);
+                    close_variable(cont);
+                    open_variable(index + 1);
+                    state_ = state::name;
+                    break;
+
+                default:
+                    break;
+            }
+            break;
+
+        case state::array:
+            if (by == array_close)
+            {
+                end_element(index);
+                close_variable(cont);
+                state_ = state::idle;
+            }
+            else if (by == val)
+            {
+                end_element(index);
+                in_element_ = true;
+                start_ = index + 1;
+            }
+            break;
+    }
+}
+
+// ==========================================================================
+// OPEN_VARIABLE
+// ==========================================================================
+void view_decoder::open_variable(std::size_t index)
+{
+    frames_.push_back({variable_view{}, 0, 0});
+    start_ = index;
+}
+
+// ==========================================================================
+// CLOSE_VARIABLE
+// ==========================================================================
+void view_decoder::close_variable(continuation const &cont)
+{
+    if (frames_.empty())
+    {
+        return;
+    }
+
+    auto const closed = seal(frames_.back());
+    frames_.pop_back();
+
+    if (frames_.empty())
+    {
+        cont(closed);
+    }
+    else
+    {
+        open_children_.push_back(closed);
+    }
+}
+
+// ==========================================================================
+// END_NAME
+// ==========================================================================
+void view_decoder::end_name(std::size_t index)
+{
+    auto &top = frames_.back().var;
+    top.name_ = data_.subspan(start_, index - start_);
+    top.id_ = names_.find(top.name_);
+}
+
+// ==========================================================================
+// END_STRING
+// ==========================================================================
+void view_decoder::end_string(std::size_t index)
+{
+    frames_.back().var.value_ = data_.subspan(start_, index - start_);
+}
+
+// ==========================================================================
+// END_ELEMENT
+// ==========================================================================
+void view_decoder::end_element(std::size_t index)
+{
+    if (in_element_)
+    {
+        assert(elements_.size() < elements_.capacity());
+        elements_.push_back(data_.subspan(start_, index - start_));
+        in_element_ = false;
+    }
+}
+
+// ==========================================================================
+// SEAL
+// ==========================================================================
+variable_view view_decoder::seal(frame const &closed)
+{
+    auto result = closed.var;
+
+    if (std::holds_alternative<table_value_view>(result.value_))
+    {
+        auto const first_child =
+            open_children_.begin()
+            + static_cast<std::ptrdiff_t>(closed.first_child);
+        auto const size =
+            static_cast<std::size_t>(open_children_.end() - first_child);
+
+        assert(children_.size() + size <= children_.capacity());
+        auto const *const table = children_.data() + children_.size();
+        children_.insert(children_.end(), first_child, open_children_.end());
+        open_children_.erase(first_child, open_children_.end());
+
+        result.value_ = table_value_view{table, size};
+    }
+    else if (std::holds_alternative<array_value_view>(result.value_))
+    {
+        result.value_ = array_value_view{elements_}.subspan(
+            closed.first_element);
+    }
+
+    return result;
+}
+
+// ==========================================================================
+// FINISH
+// ==========================================================================
+void view_decoder::finish(continuation const &cont)
+{
+    if (frames_.empty())
+    {
+        return;
+    }
+
+    // Whatever was being decoded when the data ended is kept, as far as it
+    // got.
+    switch (state_)
+    {
+        case state::name:
+            end_name(data_.size());
+            break;
+
+        case state::value:
+            end_string(data_.size());
+            break;
+
+        case state::array:
+            end_element(data_.size());
+            break;
+
+        case state::idle:
+            break;
+    }
+
+    while (frames_.size() > 1)
+    {
+        auto const closed = seal(frames_.back());
+        frames_.pop_back();
+        open_children_.push_back(closed);
+    }
+
+    auto const outermost = seal(frames_.back());
+    frames_.clear();
+
+    if (!outermost.name_.empty())
+    {
+        cont(outermost);
+    }
+}
+
+}  // namespace telnetpp::options::msdp::detail
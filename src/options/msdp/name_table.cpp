@@ -0,0 +1,41 @@
+#include "telnetpp/options/msdp/name_table.hpp"
+
+#include <algorithm>
+
+namespace telnetpp::options::msdp {
+
+// ==========================================================================
+// FIND
+// ==========================================================================
+name_id name_table::find(telnetpp::bytes name) const noexcept
+{
+    if (names_.empty())
+    {
+        return unknown_name;
+    }
+
+    // The number of buckets and of slots are both powers of two.
+    auto const hash = detail::hash_name(name);
+    auto const displacement =
+        displacements_[hash & (displacements_.size() - 1)];
+    auto const id =
+        slots_[detail::displace_hash(hash, displacement) & (slots_.size() - 1)];
+
+    if (id == unknown_name)
+    {
+        return unknown_name;
+    }
+
+    auto const candidate = names_[id];
+
+    return std::ranges::equal(
+               name,
+               candidate,
+               [](telnetpp::byte lhs, char rhs) {
+                   return lhs == static_cast<telnetpp::byte>(rhs);
+               })
+             ? id
+             : unknown_name;
+}
+
+}  // namespace telnetpp::options::msdp
@@ -1,17 +1,101 @@
 #include "telnetpp/options/msdp/server.hpp"
 
-#include "telnetpp/options/msdp/detail/decoder.hpp"
+#include "telnetpp/detail/overloaded.hpp"
 #include "telnetpp/options/msdp/detail/encoder.hpp"
 #include "telnetpp/options/msdp/detail/protocol.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
 namespace telnetpp::options::msdp {
 
+namespace {
+
+// The commands of the MSDP protocol, and the lists that may be asked for
+// with the LIST command.
+constexpr std::string_view list_command = "LIST";
+constexpr std::string_view report_command = "REPORT";
+constexpr std::string_view reset_command = "RESET";
+constexpr std::string_view send_command = "SEND";
+constexpr std::string_view unreport_command = "UNREPORT";
+
+constexpr std::string_view commands_list = "COMMANDS";
+constexpr std::string_view lists_list = "LISTS";
+constexpr std::string_view reportable_variables_list = "REPORTABLE_VARIABLES";
+constexpr std::string_view reported_variables_list = "REPORTED_VARIABLES";
+constexpr std::string_view sendable_variables_list = "SENDABLE_VARIABLES";
+
+constexpr std::string_view all_commands[] = {
+    list_command,
+    report_command,
+    reset_command,
+    send_command,
+    unreport_command};
+
+constexpr std::string_view all_lists[] = {
+    commands_list,
+    lists_list,
+    reportable_variables_list,
+    reported_variables_list,
+    sendable_variables_list};
+
+// ==========================================================================
+// IS
+// ==========================================================================
+bool is(telnetpp::bytes name, std::string_view text)
+{
+    return std::ranges::equal(name, text, [](auto lhs, auto rhs) {
+        return lhs == static_cast<telnetpp::byte>(rhs);
+    });
+}
+
+// ==========================================================================
+// TO_STORAGE
+// ==========================================================================
+telnetpp::byte_storage to_storage(std::string_view text)
+{
+    return {text.begin(), text.end()};
+}
+
+// ==========================================================================
+// FOR_EACH_STRING
+// ==========================================================================
+// Calls fn for the value of a command, which may be a single string or an
+// array of them.
+template <typename Function>
+void for_each_string(value_view const &value, Function &&fn)
+{
+    std::visit(
+        telnetpp::detail::overloaded{
+            [&fn](string_value_view str) { fn(str); },
+            [&fn](array_value_view arr) {
+                for (auto const str : arr)
+                {
+                    fn(str);
+                }
+            },
+            [](table_value_view) {}},
+        value);
+}
+
+}  // namespace
+
 // ==========================================================================
 // CONSTRUCTOR
 // ==========================================================================
-server::server(telnetpp::session &sess) noexcept
+server::server(telnetpp::session &sess)
   : telnetpp::server_option(sess, telnetpp::options::msdp::detail::option)
 {
+    // A client must ask again for its variables to be reported after the
+    // option is reactivated.
+    on_state_changed.connect([this]() {
+        if (!active())
+        {
+            unreport_all();
+        }
+    });
 }
 
 // ==========================================================================
@@ -19,8 +103,98 @@ server::server(telnetpp::session &sess) noexcept
 // ==========================================================================
 void server::send(variable const &var)
 {
-    detail::encode(
-        var, [this](telnetpp::bytes data) { write_subnegotiation(data); });
+    variable const *const vars[] = {&var};
+    send_all(vars);
+}
+
+// ==========================================================================
+// SET_VARIABLE
+// ==========================================================================
+void server::set_variable(variable var)
+{
+    auto const found = variables_.find(var.name_);
+
+    if (found == variables_.end())
+    {
+        auto name = var.name_;
+        variables_.emplace(std::move(name), reportable{std::move(var)});
+        return;
+    }
+
+    auto &entry = found->second;
+
+    if (entry.var_.value_ == var.value_)
+    {
+        return;
+    }
+
+    entry.var_.value_ = std::move(var.value_);
+
+    if (entry.reported_ && !entry.pending_)
+    {
+        entry.pending_ = true;
+        pending_.push_back(&entry);
+    }
+}
+
+// ==========================================================================
+// DELETE_VARIABLE
+// ==========================================================================
+void server::delete_variable(telnetpp::bytes name)
+{
+    if (auto const found = variables_.find(name); found != variables_.end())
+    {
+        std::erase(pending_, &found->second);
+        variables_.erase(found);
+    }
+}
+
+// ==========================================================================
+// IS_REPORTED
+// ==========================================================================
+bool server::is_reported(telnetpp::bytes name) const
+{
+    auto const found = variables_.find(name);
+    return found != variables_.end() && found->second.reported_;
+}
+
+// ==========================================================================
+// FLUSH_UPDATES
+// ==========================================================================
+void server::flush_updates()
+{
+    batch_.clear();
+
+    for (auto *entry : pending_)
+    {
+        // A variable may have been sent in answer to a command since it
+        // changed, in which case it is no longer pending.
+        if (entry->pending_)
+        {
+            entry->pending_ = false;
+            batch_.push_back(&entry->var_);
+        }
+    }
+
+    pending_.clear();
+
+    if (!batch_.empty())
+    {
+        // The batch is taken while it is in use in case the write leads to
+        // another flush.
+        auto batch = std::exchange(batch_, {});
+        send_all(batch);
+        batch.clear();
+        batch_ = std::move(batch);
+    }
+}
+
+// ==========================================================================
+// SET_NAME_TABLE
+// ==========================================================================
+void server::set_name_table(name_table names) noexcept
+{
+    decoder_.set_name_table(names);
 }
 
 // ==========================================================================
@@ -28,7 +202,171 @@ void server::send(variable const &var)
 // ==========================================================================
 void server::handle_subnegotiation(telnetpp::bytes data)
 {
-    detail::decode(data, [&](auto const &var) { on_receive(var); });
+    decoder_(data, [this](variable_view const &view) {
+        on_receive_view(view);
+
+        if (!on_receive.empty())
+        {
+            on_receive(to_variable(view));
+        }
+
+        if (!variables_.empty())
+        {
+            handle_command(view);
+        }
+    });
+}
+
+// ==========================================================================
+// HANDLE_COMMAND
+// ==========================================================================
+void server::handle_command(variable_view const &command)
+{
+    std::vector<variable> lists;
+    std::vector<variable const *> replies;
+
+    auto const for_each_variable = [&](auto &&fn) {
+        for_each_string(command.value_, [&](telnetpp::bytes name) {
+            if (auto const found = variables_.find(name);
+                found != variables_.end())
+            {
+                fn(found->second);
+            }
+        });
+    };
+
+    // The current values of the variables named in a REPORT or SEND are
+    // sent straight away, so any pending update of them is superseded.
+    auto const reply_with = [&replies](reportable &entry) {
+        entry.pending_ = false;
+        replies.push_back(&entry.var_);
+    };
+
+    if (is(command.name_, report_command))
+    {
+        for_each_variable([&](reportable &entry) {
+            entry.reported_ = true;
+            reply_with(entry);
+        });
+    }
+    else if (is(command.name_, send_command))
+    {
+        for_each_variable(reply_with);
+    }
+    else if (is(command.name_, unreport_command))
+    {
+        for_each_variable([](reportable &entry) {
+            entry.reported_ = false;
+            entry.pending_ = false;
+        });
+    }
+    else if (is(command.name_, reset_command))
+    {
+        for_each_string(command.value_, [this](telnetpp::bytes list) {
+            if (is(list, reportable_variables_list)
+                || is(list, reported_variables_list))
+            {
+                unreport_all();
+            }
+        });
+    }
+    else if (is(command.name_, list_command))
+    {
+        for_each_string(command.value_, [&](telnetpp::bytes list) {
+            array_value names;
+
+            if (is(list, commands_list))
+            {
+                std::ranges::transform(
+                    all_commands, std::back_inserter(names), to_storage);
+            }
+            else if (is(list, lists_list))
+            {
+                std::ranges::transform(
+                    all_lists, std::back_inserter(names), to_storage);
+            }
+            else if (
+                is(list, reportable_variables_list)
+                || is(list, sendable_variables_list))
+            {
+                for (auto const &[name, entry] : variables_)
+                {
+                    names.push_back(name);
+                }
+            }
+            else if (is(list, reported_variables_list))
+            {
+                for (auto const &[name, entry] : variables_)
+                {
+                    if (entry.reported_)
+                    {
+                        names.push_back(name);
+                    }
+                }
+            }
+            else
+            {
+                return;
+            }
+
+            // Variables are held in no particular order, so every list is
+            // sent in order of name.
+            std::ranges::sort(names);
+
+            lists.emplace_back(
+                telnetpp::byte_storage{list.begin(), list.end()},
+                std::move(names));
+        });
+
+        for (auto const &list : lists)
+        {
+            replies.push_back(&list);
+        }
+    }
+
+    if (!replies.empty())
+    {
+        send_all(replies);
+    }
+}
+
+// ==========================================================================
+// SEND_ALL
+// ==========================================================================
+void server::send_all(std::span<variable const *const> vars)
+{
+    send_buffer_(
+        detail::subnegotiation_size(vars),
+        [&](std::span<telnetpp::byte> buffer) {
+            return detail::encode_subnegotiation(vars, buffer);
+        },
+        [this](telnetpp::bytes frame) { write_encoded_subnegotiation(frame); });
+}
+
+// ==========================================================================
+// UNREPORT_ALL
+// ==========================================================================
+void server::unreport_all()
+{
+    for (auto &[name, entry] : variables_)
+    {
+        entry.reported_ = false;
+        entry.pending_ = false;
+    }
+
+    pending_.clear();
+}
+
+// ==========================================================================
+// HANDLE_SUBNEGOTIATION_EVENT
+// ==========================================================================
+void server::handle_subnegotiation_event(
+    telnetpp::subnegotiation_event const &event)
+{
+    if (event.is_first())
+    {
+        on_oversized_message();
+    }
 }
 
 }  // namespace telnetpp::options::msdp
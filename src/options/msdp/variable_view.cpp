@@ -0,0 +1,50 @@
+#include "telnetpp/options/msdp/variable_view.hpp"
+
+#include "telnetpp/detail/overloaded.hpp"
+
+#include <algorithm>
+
+namespace telnetpp::options::msdp {
+
+namespace {
+
+// ==========================================================================
+// TO_STRING_VALUE
+// ==========================================================================
+string_value to_string_value(string_value_view view)
+{
+    return {view.begin(), view.end()};
+}
+
+}  // namespace
+
+// ==========================================================================
+// TO_VARIABLE
+// ==========================================================================
+variable to_variable(variable_view const &view)
+{
+    return std::visit(
+        telnetpp::detail::overloaded{
+            [&](string_value_view value) {
+                return variable{
+                    to_string_value(view.name_), to_string_value(value)};
+            },
+            [&](array_value_view values) {
+                array_value array(values.size());
+                std::transform(
+                    values.begin(),
+                    values.end(),
+                    array.begin(),
+                    to_string_value);
+                return variable{to_string_value(view.name_), std::move(array)};
+            },
+            [&](table_value_view values) {
+                table_value table(values.size());
+                std::transform(
+                    values.begin(), values.end(), table.begin(), to_variable);
+                return variable{to_string_value(view.name_), std::move(table)};
+            }},
+        view.value_);
+}
+
+}  // namespace telnetpp::options::msdp
@@ -4,10 +4,15 @@
 #include "telnetpp/detail/negotiation_router.hpp"
 #include "telnetpp/detail/overloaded.hpp"
 #include "telnetpp/detail/registration.hpp"
+#include "telnetpp/detail/subnegotiation_event_router.hpp"
 #include "telnetpp/detail/subnegotiation_router.hpp"
 #include "telnetpp/generator.hpp"
+#include "telnetpp/output_segments.hpp"
 #include "telnetpp/parser.hpp"
 
+#include <cassert>
+#include <utility>
+
 namespace telnetpp {
 
 struct session::impl
@@ -16,12 +21,26 @@ struct session::impl
     telnetpp::detail::command_router command_router_;
     telnetpp::detail::negotiation_router negotiation_router_;
     telnetpp::detail::subnegotiation_router subnegotiation_router_;
+    telnetpp::detail::subnegotiation_event_router subnegotiation_event_router_;
+
+    telnetpp::byte_storage output_buffer_;
+    std::size_t cork_depth_{0};
+    std::size_t output_high_water_mark_{default_output_high_water_mark};
 };
 
 // ==========================================================================
 // CONSTRUCTOR
 // ==========================================================================
-session::session() : pimpl_{std::make_unique<impl>()}
+session::session(std::unique_ptr<channel_concept> channel) : session{*channel}
+{
+    owned_channel_ = std::move(channel);
+}
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+session::session(channel_concept &channel)
+  : channel_{&channel}, pimpl_{std::make_unique<impl>()}
 {
     // By default, the session will respond to WILL/WONT(option) with
     // DONT(option), and to DO/DONT(option) with WONT(option).  This behaviour
@@ -57,6 +76,7 @@ bool session::is_alive() const
 // ==========================================================================
 void session::close()
 {
+    flush();
     channel_->close();
 }
 
@@ -66,8 +86,20 @@ void session::close()
 void session::async_read(std::function<void(telnetpp::bytes)> const &callback)
 {
     channel_->async_read([this, callback](telnetpp::bytes content) {
-        auto const &token_handler = [this,
-                                     callback](telnetpp::element const &elem) {
+        receive(content, callback);
+        callback({});
+    });
+}
+
+// ==========================================================================
+// RECEIVE
+// ==========================================================================
+void session::receive(
+    telnetpp::bytes content,
+    detail::function_ref<void(telnetpp::bytes)> callback)
+{
+    auto const &token_handler = detail::overloaded{
+        [this, &callback](telnetpp::element const &elem) {
             std::visit(
                 detail::overloaded{
                     [&](telnetpp::bytes input_content) {
@@ -83,11 +115,12 @@ void session::async_read(std::function<void(telnetpp::bytes)> const &callback)
                         pimpl_->subnegotiation_router_(sub);
                     }},
                 elem);
-        };
+        },
+        [this](telnetpp::subnegotiation_event const &event) {
+            pimpl_->subnegotiation_event_router_(event);
+        }};
 
-        pimpl_->parser_(content, token_handler);
-        callback({});
-    });
+    pimpl_->parser_(content, token_handler);
 }
 
 // ==========================================================================
@@ -95,8 +128,150 @@ void session::async_read(std::function<void(telnetpp::bytes)> const &callback)
 // ==========================================================================
 void session::write(telnetpp::element const &elem)
 {
-    telnetpp::generate(
-        elem, [this](telnetpp::bytes data) { channel_->write(data); });
+    write_elements(elem);
+}
+
+// ==========================================================================
+// WRITE
+// ==========================================================================
+void session::write(std::span<telnetpp::element const> elems)
+{
+    write_elements(elems);
+}
+
+// ==========================================================================
+// WRITE_ENCODED
+// ==========================================================================
+void session::write_encoded(telnetpp::bytes data)
+{
+    if (data.empty())
+    {
+        return;
+    }
+
+    if (pimpl_->cork_depth_ != 0)
+    {
+        auto &buffer = pimpl_->output_buffer_;
+        buffer.append(data.begin(), data.end());
+
+        if (buffer.size() >= pimpl_->output_high_water_mark_)
+        {
+            write_output_buffer();
+        }
+    }
+    else
+    {
+        channel_->write(data);
+    }
+}
+
+// ==========================================================================
+// WRITE_ELEMENTS
+// ==========================================================================
+template <typename Elements>
+void session::write_elements(Elements const &elems)
+{
+    if (pimpl_->cork_depth_ != 0)
+    {
+        auto &buffer = pimpl_->output_buffer_;
+
+        telnetpp::generate(elems, [&buffer](telnetpp::bytes data) {
+            buffer.append(data.begin(), data.end());
+        });
+
+        if (buffer.size() >= pimpl_->output_high_water_mark_)
+        {
+            write_output_buffer();
+        }
+    }
+    else if (channel_->writes_segments())
+    {
+        telnetpp::output_segments segments;
+        telnetpp::generate(elems, segments);
+
+        if (!segments.empty())
+        {
+            channel_->write_segments(segments.segments());
+        }
+    }
+    else
+    {
+        // Gathering the output into segments first would gain nothing
+        // here, so each part is written as soon as it is generated.
+        telnetpp::generate(elems, [this](telnetpp::bytes data) {
+            channel_->write(data);
+        });
+    }
+}
+
+// ==========================================================================
+// CORK
+// ==========================================================================
+void session::cork()
+{
+    ++pimpl_->cork_depth_;
+}
+
+// ==========================================================================
+// UNCORK
+// ==========================================================================
+void session::uncork()
+{
+    assert(pimpl_->cork_depth_ != 0);
+
+    if (--pimpl_->cork_depth_ == 0)
+    {
+        flush();
+    }
+}
+
+// ==========================================================================
+// FLUSH
+// ==========================================================================
+void session::flush()
+{
+    write_output_buffer();
+    channel_->flush();
+}
+
+// ==========================================================================
+// WRITE_OUTPUT_BUFFER
+// ==========================================================================
+void session::write_output_buffer()
+{
+    if (pimpl_->output_buffer_.empty())
+    {
+        return;
+    }
+
+    // The buffer is taken from the session while it is being written so
+    // that anything written in reaction to it is collected separately.
+    // Its storage is then returned so that it can be reused.
+    auto buffer = std::exchange(pimpl_->output_buffer_, {});
+    channel_->write(buffer);
+
+    if (pimpl_->output_buffer_.empty())
+    {
+        buffer.clear();
+        pimpl_->output_buffer_ = std::move(buffer);
+    }
+}
+
+// ==========================================================================
+// SET_OUTPUT_HIGH_WATER_MARK
+// ==========================================================================
+void session::set_output_high_water_mark(std::size_t size)
+{
+    pimpl_->output_high_water_mark_ = size;
+}
+
+// ==========================================================================
+// SET_SUBNEGOTIATION_LIMIT
+// ==========================================================================
+void session::set_subnegotiation_limit(
+    std::size_t max_size, telnetpp::subnegotiation_overflow_policy policy)
+{
+    pimpl_->parser_.set_subnegotiation_limit(max_size, policy);
 }
 
 // ==========================================================================
@@ -115,7 +290,10 @@ void session::install(
 void session::install(client_option &option)
 {
     detail::register_client_option(
-        option, pimpl_->negotiation_router_, pimpl_->subnegotiation_router_);
+        option,
+        pimpl_->negotiation_router_,
+        pimpl_->subnegotiation_router_,
+        pimpl_->subnegotiation_event_router_);
 }
 
 // ==========================================================================
@@ -124,7 +302,10 @@ void session::install(client_option &option)
 void session::install(server_option &option)
 {
     detail::register_server_option(
-        option, pimpl_->negotiation_router_, pimpl_->subnegotiation_router_);
+        option,
+        pimpl_->negotiation_router_,
+        pimpl_->subnegotiation_router_,
+        pimpl_->subnegotiation_event_router_);
 }
 
 }  // namespace telnetpp
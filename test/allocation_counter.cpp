@@ -0,0 +1,70 @@
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::size_t> allocation_count{0};
+std::atomic<std::size_t> largest_allocation_size{0};
+std::atomic<bool> failing{false};
+
+}  // namespace
+
+namespace allocation_counter {
+
+std::size_t allocations() noexcept
+{
+    return allocation_count.load();
+}
+
+std::size_t largest_allocation() noexcept
+{
+    return largest_allocation_size.load();
+}
+
+void reset_largest_allocation() noexcept
+{
+    largest_allocation_size = 0;
+}
+
+void fail_allocations(bool fail) noexcept
+{
+    failing = fail;
+}
+
+}  // namespace allocation_counter
+
+void *operator new(std::size_t size)
+{
+    if (failing.load())
+    {
+        throw std::bad_alloc{};
+    }
+
+    ++allocation_count;
+
+    auto largest = largest_allocation_size.load();
+    while (size > largest
+           && !largest_allocation_size.compare_exchange_weak(largest, size))
+    {
+    }
+
+    if (auto *const block = std::malloc(size == 0 ? 1 : size))
+    {
+        return block;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *block) noexcept
+{
+    std::free(block);
+}
+
+void operator delete(void *block, std::size_t /*size*/) noexcept
+{
+    std::free(block);
+}
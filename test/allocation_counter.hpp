@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+//* =========================================================================
+/// \brief Reports on the allocations made through the global operator new,
+/// which the test program replaces, so that tests can check when and how
+/// much the library allocates.
+//* =========================================================================
+namespace allocation_counter {
+
+//* =========================================================================
+/// \brief Returns the number of allocations made so far.
+//* =========================================================================
+std::size_t allocations() noexcept;
+
+//* =========================================================================
+/// \brief Returns the size of the largest allocation made since the last
+/// call to reset_largest_allocation().
+//* =========================================================================
+std::size_t largest_allocation() noexcept;
+
+//* =========================================================================
+/// \brief Forgets the largest allocation made so far.
+//* =========================================================================
+void reset_largest_allocation() noexcept;
+
+//* =========================================================================
+/// \brief Makes every allocation throw std::bad_alloc until this is called
+/// again with false.
+//* =========================================================================
+void fail_allocations(bool fail) noexcept;
+
+}  // namespace allocation_counter
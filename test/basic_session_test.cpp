@@ -0,0 +1,213 @@
+#include "allocation_counter.hpp"
+#include "fakes/fake_channel.hpp"
+#include "fakes/fake_client_option.hpp"
+#include "fakes/fake_server_option.hpp"
+
+#include <gtest/gtest.h>
+#include <telnetpp/basic_session.hpp>
+
+#include <functional>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace {
+
+class a_basic_session : public testing::Test
+{
+protected:
+    void async_read()
+    {
+        session_.async_read([this](telnetpp::bytes content) {
+            received_content_.append(content.begin(), content.end());
+            complete_ = content.empty();
+        });
+    }
+
+    fake_channel channel_;
+    telnetpp::basic_session<fake_channel> session_{channel_};
+
+    telnetpp::byte_storage received_content_;
+    bool complete_{false};
+};
+
+}  // namespace
+
+TEST_F(a_basic_session, is_a_session)
+{
+    [[maybe_unused]] telnetpp::session &sess = session_;
+}
+
+TEST_F(a_basic_session, routes_text_to_user_supplied_function)
+{
+    async_read();
+    channel_.receive("TEST\xFF\xFF STRING"_tb);
+
+    ASSERT_EQ("TEST\xFF STRING"_tb, received_content_);
+    ASSERT_TRUE(complete_);
+}
+
+TEST_F(a_basic_session, routes_negotiations_to_installed_client_option)
+{
+    fake_client_option client{session_, 42};
+    session_.install(client);
+
+    async_read();
+    channel_.receive("\xFF\xFB\x2A"_tb);
+
+    ASSERT_EQ("\xFF\xFD\x2A"_tb, channel_.written_);
+    ASSERT_TRUE(client.active());
+}
+
+TEST_F(a_basic_session, routes_subnegotiations_to_installed_server_option)
+{
+    fake_server_option server{session_, 0xA5};
+    server.negotiate(telnetpp::do_);
+    session_.install(server);
+
+    telnetpp::byte_storage received;
+    server.on_subnegotiation.connect([&](telnetpp::bytes data) {
+        received.append(data.begin(), data.end());
+    });
+
+    async_read();
+    channel_.receive("\xFF\xFA\xA5TEST\xFF\xF0"_tb);
+
+    ASSERT_EQ("TEST"_tb, received);
+    ASSERT_TRUE(complete_);
+}
+
+TEST_F(a_basic_session, writes_elements_to_the_channel)
+{
+    session_.write("a\xFF"_tb);
+    session_.write(telnetpp::command{telnetpp::ayt});
+
+    ASSERT_EQ("a\xFF\xFF\xFF\xF6"_tb, channel_.written_);
+}
+
+TEST_F(a_basic_session, is_alive_if_the_channel_is_alive)
+{
+    ASSERT_TRUE(session_.is_alive());
+    channel_.alive_ = false;
+    ASSERT_FALSE(session_.is_alive());
+}
+
+TEST_F(a_basic_session, flushes_and_closes_the_channel_when_closed)
+{
+    session_.cork();
+    session_.write("abc"_tb);
+    session_.close();
+
+    ASSERT_EQ("abc"_tb, channel_.written_);
+    ASSERT_FALSE(channel_.alive_);
+}
+
+namespace {
+
+// A channel whose reads accept any callable, and which records the
+// callable that it was passed.
+struct fake_template_channel
+{
+    template <typename Callback>
+    void async_read(Callback &&callback)
+    {
+        read_callback_ = std::forward<Callback>(callback);
+    }
+
+    void write(telnetpp::bytes data)
+    {
+        written_.append(data.begin(), data.end());
+    }
+
+    [[nodiscard]] bool is_alive() const
+    {
+        return true;
+    }
+
+    void close()
+    {
+    }
+
+    std::function<void(telnetpp::bytes)> read_callback_;
+    telnetpp::byte_storage written_;
+};
+
+// A callable that is neither copied into nor wrapped by a std::function
+// on its way to the channel.
+struct received_content_appender
+{
+    void operator()(telnetpp::bytes data) const
+    {
+        received_content_->append(data.begin(), data.end());
+    }
+
+    telnetpp::byte_storage *received_content_;
+};
+
+}  // namespace
+
+TEST(a_basic_session_with_a_template_channel, reads_through_any_callable)
+{
+    fake_template_channel channel;
+    telnetpp::basic_session<fake_template_channel> session{channel};
+
+    telnetpp::byte_storage received_content;
+    session.async_read(received_content_appender{&received_content});
+
+    channel.read_callback_(
+        "abc\xFF\xF1"
+        "def"_tb);
+
+    ASSERT_EQ("abcdef"_tb, received_content);
+}
+
+namespace {
+
+// A channel whose reads accept any callable, and which calls it at once
+// with data that it has already received, without storing it.
+struct fake_immediate_channel
+{
+    template <typename Callback>
+    void async_read(Callback &&callback)
+    {
+        callback(received_);
+    }
+
+    void write(telnetpp::bytes data)
+    {
+        written_.append(data.begin(), data.end());
+    }
+
+    [[nodiscard]] bool is_alive() const
+    {
+        return true;
+    }
+
+    void close()
+    {
+    }
+
+    telnetpp::bytes received_;
+    telnetpp::byte_storage written_;
+};
+
+}  // namespace
+
+TEST(
+    a_basic_session_with_a_template_channel,
+    does_not_allocate_when_reading)
+{
+    fake_immediate_channel channel;
+    telnetpp::basic_session<fake_immediate_channel> session{channel};
+
+    telnetpp::byte_storage received_content;
+    received_content.reserve(64);
+
+    auto const data = "abc\xFF\xF1" "def"_tb;
+    channel.received_ = data;
+
+    auto const allocations_before = allocation_counter::allocations();
+    session.async_read(received_content_appender{&received_content});
+
+    ASSERT_EQ(allocations_before, allocation_counter::allocations());
+    ASSERT_EQ("abcdef"_tb, received_content);
+}
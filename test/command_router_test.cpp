@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <telnetpp/detail/command_router.hpp>
 
+#include <functional>
+
 TEST(
     command_router_test,
     message_with_registered_key_goes_to_registered_function)
@@ -48,3 +50,26 @@ TEST(
     ASSERT_EQ(expected, cmd);
     ASSERT_TRUE(unregistered_route_called);
 }
+
+TEST(command_router_test, registering_an_empty_function_unregisters_the_route)
+{
+    telnetpp::detail::command_router router;
+
+    bool registered_route_called = false;
+    router.register_route(telnetpp::ayt, [&](telnetpp::command) {
+        registered_route_called = true;
+    });
+    router.register_route(
+        telnetpp::ayt, std::function<void(telnetpp::command)>{});
+
+    bool unregistered_route_called = false;
+    router.set_unregistered_route(
+        [&unregistered_route_called](telnetpp::command) {
+            unregistered_route_called = true;
+        });
+
+    router(telnetpp::command{telnetpp::ayt});
+
+    ASSERT_FALSE(registered_route_called);
+    ASSERT_TRUE(unregistered_route_called);
+}
@@ -11,11 +11,19 @@ public:
     {
     }
 
-    boost::signals2::signal<void(telnetpp::bytes data)> on_subnegotiation;
+    telnetpp::signal<void(telnetpp::bytes data)> on_subnegotiation;
+    telnetpp::signal<void(telnetpp::subnegotiation_event const &)>
+        on_subnegotiation_event;
 
 private:
     void handle_subnegotiation(telnetpp::bytes data) override
     {
         on_subnegotiation(data);
     }
+
+    void handle_subnegotiation_event(
+        telnetpp::subnegotiation_event const &event) override
+    {
+        on_subnegotiation_event(event);
+    }
 };
@@ -11,7 +11,7 @@ public:
     {
     }
 
-    boost::signals2::signal<void(telnetpp::bytes data)> on_subnegotiation;
+    telnetpp::signal<void(telnetpp::bytes data)> on_subnegotiation;
 
 private:
     void handle_subnegotiation(telnetpp::bytes data) override
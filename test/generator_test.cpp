@@ -92,3 +92,47 @@ TEST_F(generator_test, subnegotiation_with_iac_content_generates_doubled_iac)
 
     ASSERT_EQ(output_, expected);
 }
+
+TEST_F(generator_test, element_generates_segments_that_outlive_the_call)
+{
+    telnetpp::output_segments segments;
+
+    telnetpp::generate(telnetpp::negotiation{telnetpp::do_, 0x18}, segments);
+    telnetpp::generate(telnetpp::command{telnetpp::nop}, segments);
+
+    std::vector<telnetpp::byte> const expected = {
+        0xFF, 0xFD, 0x18, 0xFF, 0xF1};
+
+    for (auto const &segment : segments.segments())
+    {
+        output_.insert(output_.end(), segment.begin(), segment.end());
+    }
+
+    ASSERT_EQ(output_, expected);
+    ASSERT_EQ(expected.size(), segments.total_size());
+}
+
+TEST_F(generator_test, batch_of_elements_generates_segments_in_order)
+{
+    static constexpr telnetpp::byte const content[] = {
+        'a', 'b', 0xFF, 'c', 'd'};
+
+    std::vector<telnetpp::element> const elements = {
+        telnetpp::bytes{content},
+        telnetpp::subnegotiation{0xCD, content},
+        telnetpp::command{telnetpp::ayt}};
+
+    telnetpp::output_segments segments;
+    telnetpp::generate(elements, segments);
+
+    std::vector<telnetpp::byte> const expected = {
+        'a',  'b',  0xFF, 0xFF, 'c',  'd',  0xFF, 0xFA, 0xCD, 'a', 'b',
+        0xFF, 0xFF, 'c',  'd',  0xFF, 0xF0, 0xFF, 0xF6};
+
+    for (auto const &segment : segments.segments())
+    {
+        output_.insert(output_.end(), segment.begin(), segment.end());
+    }
+
+    ASSERT_EQ(output_, expected);
+}
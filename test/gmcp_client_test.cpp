@@ -0,0 +1,204 @@
+#include "telnet_option_fixture.hpp"
+
+#include <gtest/gtest.h>
+#include <telnetpp/options/gmcp/client.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace {
+
+namespace gmcp = telnetpp::options::gmcp;
+
+using a_gmcp_client = a_telnet_option<gmcp::client>;
+
+std::string to_string(telnetpp::bytes data)
+{
+    return {data.begin(), data.end()};
+}
+
+}  // namespace
+
+TEST_F(a_gmcp_client, is_a_gmcp_client)
+{
+    ASSERT_EQ(201, option_.option_code());
+}
+
+namespace {
+
+class an_activated_gmcp_client : public a_gmcp_client
+{
+protected:
+    an_activated_gmcp_client()
+    {
+        option_.on_receive.connect([this](gmcp::message_view const &msg) {
+            received_.push_back(
+                to_string(msg.package_) + "|" + to_string(msg.payload_));
+        });
+
+        option_.negotiate(telnetpp::will);
+        assert(option_.active());
+        channel_.written_.clear();
+    }
+
+    std::vector<std::string> received_;
+};
+
+}  // namespace
+
+TEST_F(an_activated_gmcp_client, sends_a_message_with_its_payload)
+{
+    option_.send("Char.Vitals", R"({"hp":1})");
+
+    telnetpp::byte_storage expected = {
+        telnetpp::iac, telnetpp::sb, option_.option_code()};
+    expected += "Char.Vitals {\"hp\":1}"_tb;
+    expected += {telnetpp::iac, telnetpp::se};
+
+    ASSERT_EQ(expected, channel_.written_);
+}
+
+TEST_F(an_activated_gmcp_client, sends_a_message_without_a_payload)
+{
+    option_.send("Core.Ping");
+
+    telnetpp::byte_storage expected = {
+        telnetpp::iac, telnetpp::sb, option_.option_code()};
+    expected += "Core.Ping"_tb;
+    expected += {telnetpp::iac, telnetpp::se};
+
+    ASSERT_EQ(expected, channel_.written_);
+}
+
+TEST_F(an_activated_gmcp_client, send_doubles_iac_bytes_in_the_payload)
+{
+    static constexpr telnetpp::byte payload[] = {'"', telnetpp::iac, '"'};
+    option_.send("A.B", payload);
+
+    telnetpp::byte_storage const expected = {
+        telnetpp::iac,
+        telnetpp::sb,
+        option_.option_code(),
+        'A',
+        '.',
+        'B',
+        ' ',
+        '"',
+        telnetpp::iac,
+        telnetpp::iac,
+        '"',
+        telnetpp::iac,
+        telnetpp::se};
+
+    ASSERT_EQ(expected, channel_.written_);
+}
+
+TEST_F(an_activated_gmcp_client, receives_a_message_with_its_payload)
+{
+    option_.subnegotiate("Char.Vitals {\"hp\": 1}"_tb);
+
+    std::vector<std::string> const expected = {
+        "Char.Vitals|{\"hp\": 1}"};
+
+    ASSERT_EQ(expected, received_);
+}
+
+TEST_F(an_activated_gmcp_client, receives_a_message_without_a_payload)
+{
+    option_.subnegotiate("Core.Ping"_tb);
+
+    std::vector<std::string> const expected = {"Core.Ping|"};
+
+    ASSERT_EQ(expected, received_);
+}
+
+TEST_F(an_activated_gmcp_client, passes_messages_to_their_package_handler)
+{
+    std::vector<std::string> vitals;
+    std::vector<std::string> pings;
+
+    option_.set_handler("Char.Vitals", [&](gmcp::message_view const &msg) {
+        vitals.push_back(to_string(msg.payload_));
+    });
+    option_.set_handler("Core.Ping", [&](gmcp::message_view const &msg) {
+        pings.push_back(to_string(msg.package_));
+    });
+
+    option_.subnegotiate("Char.Vitals 1"_tb);
+    option_.subnegotiate("Room.Info 2"_tb);
+    option_.subnegotiate("core.ping"_tb);
+
+    std::vector<std::string> const expected_vitals = {"1"};
+    std::vector<std::string> const expected_pings = {"core.ping"};
+    std::vector<std::string> const expected_received = {
+        "Char.Vitals|1", "Room.Info|2", "core.ping|"};
+
+    ASSERT_EQ(expected_vitals, vitals);
+    ASSERT_EQ(expected_pings, pings);
+    ASSERT_EQ(expected_received, received_);
+}
+
+TEST_F(an_activated_gmcp_client, replaces_and_removes_package_handlers)
+{
+    int first_calls = 0;
+    int second_calls = 0;
+
+    option_.set_handler(
+        "Char.Vitals", [&](gmcp::message_view const &) { ++first_calls; });
+    option_.set_handler(
+        "CHAR.VITALS", [&](gmcp::message_view const &) { ++second_calls; });
+    option_.subnegotiate("Char.Vitals"_tb);
+
+    option_.set_handler("char.vitals", {});
+    option_.subnegotiate("Char.Vitals"_tb);
+
+    ASSERT_EQ(0, first_calls);
+    ASSERT_EQ(1, second_calls);
+    ASSERT_EQ(2U, received_.size());
+}
+
+TEST_F(an_activated_gmcp_client, reports_a_message_larger_than_the_limit_once)
+{
+    int oversized_messages = 0;
+    option_.on_oversized_message.connect([&] { ++oversized_messages; });
+
+    session_.install(option_);
+    session_.set_subnegotiation_limit(
+        4, telnetpp::subnegotiation_overflow_policy::error);
+
+    static auto const content =
+        "\xFF\xFA\xC9"
+        "Char.Vitals {}"
+        "\xFF\xF0"_tb;
+
+    session_.async_read([](telnetpp::bytes) {});
+    channel_.receive(content);
+
+    ASSERT_EQ(1, oversized_messages);
+    ASSERT_TRUE(received_.empty());
+}
+
+TEST_F(
+    an_activated_gmcp_client,
+    reports_a_streamed_message_larger_than_the_limit_once)
+{
+    int oversized_messages = 0;
+    option_.on_oversized_message.connect([&] { ++oversized_messages; });
+
+    session_.install(option_);
+    session_.set_subnegotiation_limit(
+        4, telnetpp::subnegotiation_overflow_policy::stream);
+
+    static auto const content =
+        "\xFF\xFA\xC9"
+        "Char.Vitals {}"
+        "\xFF\xF0"_tb;
+
+    session_.async_read([](telnetpp::bytes) {});
+    channel_.receive(content);
+
+    ASSERT_EQ(1, oversized_messages);
+    ASSERT_TRUE(received_.empty());
+}
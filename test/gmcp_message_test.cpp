@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <telnetpp/options/gmcp/detail/encoder.hpp>
+#include <telnetpp/options/gmcp/detail/handler_table.hpp>
+#include <telnetpp/options/gmcp/message_view.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace gmcp = telnetpp::options::gmcp;
+
+TEST(splitting_a_gmcp_message, divides_it_at_the_first_space)
+{
+    auto const content = R"(Room.Info {"name": "The Square"})"_tb;
+    auto const msg = gmcp::split_message(content);
+
+    ASSERT_TRUE(telnetpp::bytes_equal("Room.Info"_tb, msg.package_));
+    ASSERT_TRUE(
+        telnetpp::bytes_equal(R"({"name": "The Square"})"_tb, msg.payload_));
+    ASSERT_EQ(content.data(), msg.package_.data());
+    ASSERT_EQ(
+        content.data() + content.size(),
+        msg.payload_.data() + msg.payload_.size());
+}
+
+TEST(splitting_a_gmcp_message, gives_no_payload_if_there_is_no_space)
+{
+    auto const content = "Core.Ping"_tb;
+    auto const msg = gmcp::split_message(content);
+
+    ASSERT_TRUE(telnetpp::bytes_equal("Core.Ping"_tb, msg.package_));
+    ASSERT_TRUE(msg.payload_.empty());
+}
+
+TEST(splitting_a_gmcp_message, gives_nothing_for_empty_content)
+{
+    auto const msg = gmcp::split_message({});
+
+    ASSERT_TRUE(msg.package_.empty());
+    ASSERT_TRUE(msg.payload_.empty());
+}
+
+TEST(encoding_a_gmcp_message, copies_a_large_payload_with_iacs_doubled)
+{
+    telnetpp::byte_storage payload;
+    telnetpp::byte_storage expected = {telnetpp::iac, telnetpp::sb, 201};
+    expected += "Big.Data "_tb;
+
+    for (int index = 0; index < 1000; ++index)
+    {
+        auto const by = static_cast<telnetpp::byte>(index * 7);
+        payload += by;
+        expected += by;
+
+        if (by == telnetpp::iac)
+        {
+            expected += by;
+        }
+    }
+
+    expected += {telnetpp::iac, telnetpp::se};
+
+    auto const size = gmcp::detail::subnegotiation_size("Big.Data", payload);
+    telnetpp::byte_storage buffer(size, 0);
+    auto const encoded =
+        gmcp::detail::encode_subnegotiation("Big.Data", payload, buffer);
+
+    ASSERT_EQ(expected.size(), size);
+    ASSERT_TRUE(telnetpp::bytes_equal(expected, encoded));
+}
+
+TEST(a_gmcp_handler_table, finds_each_of_many_handlers)
+{
+    gmcp::detail::handler_table table;
+    std::vector<std::string> found;
+
+    // Registered out of order, so that the table must sort them.
+    for (int index = 99; index >= 0; --index)
+    {
+        auto const package = "Package" + std::to_string(index);
+        table.set(package, [&found, package](gmcp::message_view const &) {
+            found.push_back(package);
+        });
+    }
+
+    for (int index = 0; index < 100; ++index)
+    {
+        auto const package = "PACKAGE" + std::to_string(index);
+        telnetpp::byte_storage const name{package.begin(), package.end()};
+        auto const *handler = table.find(name);
+
+        ASSERT_NE(nullptr, handler) << package;
+        (*handler)({});
+        ASSERT_EQ("Package" + std::to_string(index), found.back());
+    }
+
+    ASSERT_EQ(nullptr, table.find("Package100"_tb));
+    ASSERT_EQ(nullptr, table.find("Package"_tb));
+    ASSERT_EQ(nullptr, table.find({}));
+}
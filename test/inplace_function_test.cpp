@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <telnetpp/detail/inplace_function.hpp>
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+using function_type = telnetpp::detail::inplace_function<int(int)>;
+
+TEST(inplace_function_test, default_constructed_function_is_empty)
+{
+    function_type const function;
+    ASSERT_FALSE(function);
+}
+
+TEST(inplace_function_test, invokes_held_callable)
+{
+    int const offset = 5;
+    function_type const function = [offset](int value) {
+        return value + offset;
+    };
+
+    ASSERT_TRUE(function);
+    ASSERT_EQ(12, function(7));
+}
+
+TEST(inplace_function_test, invokes_mutable_callable_through_const_function)
+{
+    function_type const function = [count = 0](int value) mutable {
+        return value + ++count;
+    };
+
+    ASSERT_EQ(1, function(0));
+    ASSERT_EQ(2, function(0));
+}
+
+TEST(inplace_function_test, copies_hold_independent_callables)
+{
+    function_type original = [count = 0](int) mutable { return ++count; };
+    original(0);
+
+    function_type const copy = original;
+
+    ASSERT_EQ(2, original(0));
+    ASSERT_EQ(2, copy(0));
+}
+
+TEST(inplace_function_test, moving_leaves_source_empty)
+{
+    auto const state = std::make_shared<int>(3);
+    function_type original = [state](int value) { return value * *state; };
+
+    function_type moved = std::move(original);
+
+    ASSERT_FALSE(original);  // NOLINT
+    ASSERT_EQ(6, moved(2));
+    ASSERT_EQ(2, state.use_count());
+}
+
+TEST(inplace_function_test, destroys_held_callable)
+{
+    auto const state = std::make_shared<int>(0);
+
+    {
+        function_type function = [state](int) { return *state; };
+        ASSERT_EQ(2, state.use_count());
+
+        function = function_type{};
+        ASSERT_EQ(1, state.use_count());
+        ASSERT_FALSE(function);
+
+        function = [state](int) { return *state; };
+        ASSERT_EQ(2, state.use_count());
+    }
+
+    ASSERT_EQ(1, state.use_count());
+}
+
+TEST(inplace_function_test, is_empty_when_made_from_an_empty_callable)
+{
+    int (*const null_pointer)(int) = nullptr;
+    function_type const from_null_pointer = null_pointer;
+    function_type const from_empty_function = std::function<int(int)>{};
+
+    ASSERT_FALSE(from_null_pointer);
+    ASSERT_FALSE(from_empty_function);
+}
@@ -0,0 +1,195 @@
+#include "telnet_option_fixture.hpp"
+
+#include <gtest/gtest.h>
+#include <telnetpp/options/mccp/codec.hpp>
+#include <telnetpp/options/mccp3/client.hpp>
+
+#include <algorithm>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace {
+
+// Reversible "compression" function.
+std::vector<telnetpp::byte> compress_decompress(telnetpp::bytes data)
+{
+    std::vector<telnetpp::byte> converted_data(data.size());
+    std::transform(
+        data.begin(), data.end(), converted_data.begin(), [](auto by) {
+            return static_cast<telnetpp::byte>(by ^ 0x20);
+        });
+    return converted_data;
+}
+
+std::vector<telnetpp::byte> as_vector(telnetpp::bytes data)
+{
+    return {data.begin(), data.end()};
+}
+
+class fake_compressor : public telnetpp::options::mccp::codec
+{
+public:
+    bool finished_ = false;
+
+private:
+    telnetpp::bytes transform_chunk(
+        telnetpp::bytes data, continuation const &cont) override
+    {
+        cont(compress_decompress(data), false);
+        return telnetpp::bytes{};
+    }
+
+    void do_finish(continuation const &cont) override
+    {
+        cont("end"_tb, true);
+        finished_ = true;
+    }
+};
+
+class an_mccp3_client : public a_telnet_option_base
+{
+protected:
+    // Sends data through the compressor, as an application would.
+    void send_data(telnetpp::bytes data)
+    {
+        compressor_(data, [this](telnetpp::bytes compressed, bool ended) {
+            send(compressed, ended);
+        });
+    }
+
+    void send(telnetpp::bytes compressed, bool /*ended*/)
+    {
+        sent_data_.insert(
+            sent_data_.end(), compressed.begin(), compressed.end());
+    }
+
+    fake_compressor compressor_;
+    telnetpp::options::mccp3::client client_{
+        session_, compressor_, [this](telnetpp::bytes data, bool ended) {
+            send(data, ended);
+        }};
+    std::vector<telnetpp::byte> sent_data_;
+};
+
+class an_active_mccp3_client : public an_mccp3_client
+{
+protected:
+    an_active_mccp3_client()
+    {
+        client_.negotiate(telnetpp::will);
+        assert(client_.active());
+        channel_.written_.clear();
+    }
+};
+
+}  // namespace
+
+TEST_F(an_mccp3_client, reports_mccp3_option_code)
+{
+    ASSERT_EQ(87, client_.option_code());
+}
+
+TEST_F(an_mccp3_client, sends_do_when_activated_remotely)
+{
+    client_.negotiate(telnetpp::will);
+
+    telnetpp::byte_storage const expected = {
+        telnetpp::iac, telnetpp::do_, client_.option_code()};
+
+    ASSERT_EQ(expected, channel_.written_);
+}
+
+TEST_F(an_mccp3_client, does_not_begin_compression_when_inactive)
+{
+    client_.start_compression();
+
+    ASSERT_TRUE(channel_.written_.empty());
+
+    send_data("abc"_tb);
+    ASSERT_EQ(as_vector("abc"_tb), sent_data_);
+}
+
+TEST_F(an_active_mccp3_client, sends_data_uncompressed)
+{
+    send_data("abc"_tb);
+
+    ASSERT_EQ(as_vector("abc"_tb), sent_data_);
+}
+
+TEST_F(
+    an_active_mccp3_client,
+    sends_empty_subnegotiation_when_beginning_compression)
+{
+    client_.start_compression();
+
+    telnetpp::byte_storage const expected = {
+        telnetpp::iac,
+        telnetpp::sb,
+        client_.option_code(),
+        telnetpp::iac,
+        telnetpp::se};
+
+    ASSERT_EQ(expected, channel_.written_);
+}
+
+TEST_F(an_active_mccp3_client, sends_nothing_more_when_beginning_twice)
+{
+    client_.start_compression();
+    channel_.written_.clear();
+
+    client_.start_compression();
+
+    ASSERT_TRUE(channel_.written_.empty());
+}
+
+namespace {
+
+class an_mccp3_client_with_compression_started : public an_active_mccp3_client
+{
+protected:
+    an_mccp3_client_with_compression_started()
+    {
+        client_.start_compression();
+        channel_.written_.clear();
+    }
+};
+
+}  // namespace
+
+TEST_F(an_mccp3_client_with_compression_started, sends_compressed_data)
+{
+    send_data("abc"_tb);
+
+    ASSERT_EQ(compress_decompress("abc"_tb), sent_data_);
+}
+
+TEST_F(
+    an_mccp3_client_with_compression_started,
+    ends_the_compressed_stream_when_compression_is_finished)
+{
+    client_.finish_compression();
+
+    ASSERT_EQ(as_vector("end"_tb), sent_data_);
+    ASSERT_TRUE(channel_.written_.empty());
+    ASSERT_TRUE(compressor_.finished_);
+
+    send_data("abc"_tb);
+    ASSERT_EQ(as_vector("endabc"_tb), sent_data_);
+}
+
+TEST_F(
+    an_mccp3_client_with_compression_started,
+    ends_the_compressed_stream_when_deactivated)
+{
+    client_.negotiate(telnetpp::wont);
+
+    ASSERT_EQ(as_vector("end"_tb), sent_data_);
+    ASSERT_TRUE(compressor_.finished_);
+
+    // Compression can be begun again once the option is reactivated.
+    client_.negotiate(telnetpp::will);
+    channel_.written_.clear();
+    client_.start_compression();
+
+    ASSERT_FALSE(channel_.written_.empty());
+}
@@ -0,0 +1,151 @@
+#include "telnet_option_fixture.hpp"
+
+#include <gtest/gtest.h>
+#include <telnetpp/options/mccp/codec.hpp>
+#include <telnetpp/options/mccp3/server.hpp>
+
+#include <algorithm>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace {
+
+// Reversible "compression" function.
+std::vector<telnetpp::byte> compress_decompress(telnetpp::bytes data)
+{
+    std::vector<telnetpp::byte> converted_data(data.size());
+    std::transform(
+        data.begin(), data.end(), converted_data.begin(), [](auto by) {
+            return static_cast<telnetpp::byte>(by ^ 0x20);
+        });
+    return converted_data;
+}
+
+std::vector<telnetpp::byte> as_vector(telnetpp::bytes data)
+{
+    return {data.begin(), data.end()};
+}
+
+class fake_decompressor : public telnetpp::options::mccp::codec
+{
+public:
+    bool end_compression_next_chunk_ = false;
+    bool finished_ = false;
+
+private:
+    telnetpp::bytes transform_chunk(
+        telnetpp::bytes data, continuation const &cont) override
+    {
+        cont(compress_decompress(data), end_compression_next_chunk_);
+        return telnetpp::bytes{};
+    }
+
+    void do_finish(continuation const & /*cont*/) override
+    {
+        finished_ = true;
+    }
+};
+
+class an_mccp3_server : public a_telnet_option_base
+{
+protected:
+    fake_decompressor decompressor_;
+    telnetpp::options::mccp3::server server_{session_, decompressor_};
+};
+
+class an_active_mccp3_server : public an_mccp3_server
+{
+protected:
+    an_active_mccp3_server()
+    {
+        session_.install(server_);
+        server_.negotiate(telnetpp::do_);
+        assert(server_.active());
+        channel_.written_.clear();
+    }
+
+    // Receives data through the decompressor and on into the session, as
+    // an application would.
+    void receive_data(telnetpp::bytes data)
+    {
+        decompressor_(data, [this](telnetpp::bytes content, bool ended) {
+            compression_ended_ = ended;
+            session_.async_read([this](telnetpp::bytes plain) {
+                received_data_.insert(
+                    received_data_.end(), plain.begin(), plain.end());
+            });
+            channel_.receive(content);
+        });
+    }
+
+    std::vector<telnetpp::byte> received_data_;
+    bool compression_ended_ = false;
+};
+
+}  // namespace
+
+TEST_F(an_mccp3_server, reports_mccp3_option_code)
+{
+    ASSERT_EQ(87, server_.option_code());
+}
+
+TEST_F(an_mccp3_server, sends_will_when_activated)
+{
+    server_.activate();
+
+    telnetpp::byte_storage const expected = {
+        telnetpp::iac, telnetpp::will, server_.option_code()};
+
+    ASSERT_EQ(expected, channel_.written_);
+}
+
+TEST_F(an_active_mccp3_server, receives_data_uncompressed)
+{
+    receive_data("test_data"_tb);
+
+    ASSERT_EQ(as_vector("test_data"_tb), received_data_);
+}
+
+TEST_F(
+    an_active_mccp3_server,
+    decompresses_data_after_the_client_begins_compression)
+{
+    auto const start_sequence = "abc\xFF\xFA\x57\xFF\xF0"_tb;
+    auto const compressed_data = compress_decompress("def"_tb);
+
+    std::vector<telnetpp::byte> data{
+        start_sequence.begin(), start_sequence.end()};
+    data.insert(data.end(), compressed_data.begin(), compressed_data.end());
+
+    receive_data(data);
+
+    ASSERT_EQ(as_vector("abcdef"_tb), received_data_);
+    ASSERT_TRUE(channel_.written_.empty());
+}
+
+TEST_F(
+    an_active_mccp3_server,
+    receives_plain_data_after_the_client_ends_compression)
+{
+    receive_data("\xFF\xFA\x57\xFF\xF0"_tb);
+
+    decompressor_.end_compression_next_chunk_ = true;
+    receive_data(compress_decompress("abc"_tb));
+    ASSERT_TRUE(compression_ended_);
+
+    receive_data("def"_tb);
+
+    ASSERT_EQ(as_vector("abcdef"_tb), received_data_);
+}
+
+TEST_F(an_active_mccp3_server, finishes_decompressing_when_deactivated)
+{
+    receive_data("\xFF\xFA\x57\xFF\xF0"_tb);
+    server_.negotiate(telnetpp::dont);
+
+    ASSERT_TRUE(decompressor_.finished_);
+
+    receive_data("abc"_tb);
+
+    ASSERT_EQ(as_vector("abc"_tb), received_data_);
+}
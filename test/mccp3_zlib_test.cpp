@@ -0,0 +1,171 @@
+#include "fakes/fake_channel.hpp"
+
+#include <gtest/gtest.h>
+#include <telnetpp/options/mccp/zlib/compressor.hpp>
+#include <telnetpp/options/mccp/zlib/decompressor.hpp>
+#include <telnetpp/options/mccp3/client.hpp>
+#include <telnetpp/options/mccp3/server.hpp>
+#include <telnetpp/session.hpp>
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace {
+
+namespace zlib = telnetpp::options::mccp::zlib;
+
+// A channel that compresses what is written to it, as a client application
+// using MCCP3 would.
+struct compressing_channel : fake_channel
+{
+    void write(telnetpp::bytes data)
+    {
+        compressor_(data, [this](telnetpp::bytes compressed, bool) {
+            fake_channel::write(compressed);
+        });
+    }
+
+    void flush()
+    {
+        compressor_.flush([this](telnetpp::bytes compressed, bool) {
+            fake_channel::write(compressed);
+        });
+    }
+
+    zlib::compressor compressor_;
+};
+
+// A client session and a server session, where the client compresses what
+// it sends to the server with MCCP3.
+class an_mccp3_connection : public testing::Test
+{
+protected:
+    an_mccp3_connection()
+    {
+        client_session_.install(client_);
+        server_session_.install(server_);
+
+        server_.activate();
+        transfer_to_client();
+        transfer_to_server();
+        assert(client_.active());
+        assert(server_.active());
+
+        received_data_.clear();
+    }
+
+    // Passes everything the server has written on to the client session.
+    void transfer_to_client()
+    {
+        auto const data = std::exchange(server_channel_.written_, {});
+        client_session_.async_read([](telnetpp::bytes) {});
+        client_channel_.receive(data);
+    }
+
+    // Passes everything the client has written through the decompressor
+    // and on to the server session, as a server application would.
+    void transfer_to_server()
+    {
+        auto const data = std::exchange(client_channel_.written_, {});
+        transferred_size_ += data.size();
+
+        decompressor_(data, [this](telnetpp::bytes content, bool) {
+            server_session_.async_read([this](telnetpp::bytes plain) {
+                received_data_.insert(
+                    received_data_.end(), plain.begin(), plain.end());
+            });
+            server_channel_.receive(content);
+        });
+    }
+
+    compressing_channel client_channel_;
+    telnetpp::session client_session_{client_channel_};
+    telnetpp::options::mccp3::client client_{
+        client_session_,
+        client_channel_.compressor_,
+        [this](telnetpp::bytes data, bool) {
+            client_channel_.fake_channel::write(data);
+        }};
+
+    fake_channel server_channel_;
+    telnetpp::session server_session_{server_channel_};
+    zlib::decompressor decompressor_;
+    telnetpp::options::mccp3::server server_{server_session_, decompressor_};
+
+    std::vector<telnetpp::byte> received_data_;
+    std::size_t transferred_size_{0};
+};
+
+std::vector<telnetpp::byte> as_vector(telnetpp::bytes data)
+{
+    return {data.begin(), data.end()};
+}
+
+}  // namespace
+
+TEST_F(an_mccp3_connection, transfers_plain_data_before_compression)
+{
+    client_session_.write("plain \xFF data"_tb);
+    transfer_to_server();
+
+    ASSERT_EQ(as_vector("plain \xFF data"_tb), received_data_);
+}
+
+TEST_F(an_mccp3_connection, transfers_compressed_data)
+{
+    client_session_.write("before"_tb);
+    client_.start_compression();
+    client_session_.write(" and \xFF after"_tb);
+    transfer_to_server();
+
+    ASSERT_EQ(as_vector("before and \xFF after"_tb), received_data_);
+}
+
+TEST_F(an_mccp3_connection, transfers_fewer_bytes_when_compressed)
+{
+    client_channel_.compressor_.set_flush_policy(
+        zlib::flush_policy::explicit_only);
+    client_.start_compression();
+    transferred_size_ = 0;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        client_session_.write("look north\r\n"_tb);
+    }
+
+    client_session_.flush();
+    transfer_to_server();
+
+    ASSERT_EQ(100U * 12U, received_data_.size());
+    ASSERT_LT(transferred_size_, received_data_.size() / 2);
+}
+
+TEST_F(an_mccp3_connection, transfers_plain_data_after_compression_ends)
+{
+    client_.start_compression();
+    client_session_.write("compressed "_tb);
+    client_.finish_compression();
+    client_session_.write("plain"_tb);
+    transfer_to_server();
+
+    ASSERT_EQ(as_vector("compressed plain"_tb), received_data_);
+}
+
+TEST_F(an_mccp3_connection, ends_compression_when_the_server_deactivates)
+{
+    client_.start_compression();
+    client_session_.write("compressed "_tb);
+    transfer_to_server();
+
+    server_.deactivate();
+    transfer_to_client();
+    client_session_.write("plain"_tb);
+    transfer_to_server();
+
+    ASSERT_FALSE(client_.active());
+    ASSERT_FALSE(server_.active());
+    ASSERT_EQ(as_vector("compressed plain"_tb), received_data_);
+}
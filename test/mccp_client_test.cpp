@@ -167,4 +167,93 @@ TEST_F(
     std::vector<telnetpp::byte> const expected_data{
         test_data.begin(), test_data.end()};
     ASSERT_EQ(expected_data, received_data_);
-}
\ No newline at end of file
+}
+
+namespace {
+
+class an_installed_active_mccp_client : public an_active_mccp_client
+{
+protected:
+    an_installed_active_mccp_client()
+    {
+        session_.install(client_);
+    }
+
+    // Receives data through the decompressor and on into the session, as
+    // an application would, recording each piece passed on to the session.
+    void receive_through_session(telnetpp::bytes data)
+    {
+        decompressor_(data, [this](telnetpp::bytes content, bool) {
+            received_chunks_.emplace_back(content.begin(), content.end());
+            session_.async_read([](telnetpp::bytes) {});
+            channel_.receive(content);
+        });
+    }
+
+    std::vector<std::vector<telnetpp::byte>> received_chunks_;
+};
+
+std::vector<telnetpp::byte> compressed(telnetpp::bytes data)
+{
+    std::vector<telnetpp::byte> result;
+    compress_decompress(data, [&result](telnetpp::bytes converted) {
+        result.assign(converted.begin(), converted.end());
+    });
+    return result;
+}
+
+}  // namespace
+
+TEST_F(
+    an_installed_active_mccp_client,
+    when_not_engaged_passes_on_plain_data_in_one_piece)
+{
+    auto const test_data = "some \xFF\xFF plain data"_tb;
+
+    receive_through_session(test_data);
+
+    std::vector<std::vector<telnetpp::byte>> const expected_chunks = {
+        {test_data.begin(), test_data.end()}};
+    ASSERT_EQ(expected_chunks, received_chunks_);
+}
+
+TEST_F(
+    an_installed_active_mccp_client,
+    starts_decompressing_directly_after_the_start_of_compression)
+{
+    auto const plain_data = "abc\xFF\xFF\xF0\xFF\xFA\x56\xFF\xF0"_tb;
+    auto const compressed_data = compressed("def"_tb);
+
+    std::vector<telnetpp::byte> data{plain_data.begin(), plain_data.end()};
+    data.insert(data.end(), compressed_data.begin(), compressed_data.end());
+
+    receive_through_session(data);
+
+    std::vector<std::vector<telnetpp::byte>> const expected_chunks = {
+        {plain_data.begin(), plain_data.end()},
+        {'d', 'e', 'f'},
+    };
+    ASSERT_EQ(expected_chunks, received_chunks_);
+}
+
+TEST_F(
+    an_installed_active_mccp_client,
+    starts_decompressing_after_a_start_of_compression_split_between_reads)
+{
+    auto const first_data = "abc\xFF\xFA\x56\xFF"_tb;
+    auto const compressed_data = compressed("def"_tb);
+
+    std::vector<telnetpp::byte> second_data{telnetpp::se};
+    second_data.insert(
+        second_data.end(), compressed_data.begin(), compressed_data.end());
+
+    receive_through_session(first_data);
+    receive_through_session(second_data);
+
+    std::vector<std::vector<telnetpp::byte>> const expected_chunks = {
+        {first_data.begin(), first_data.end()},
+        {telnetpp::se},
+        {'d', 'e', 'f'},
+    };
+    ASSERT_EQ(expected_chunks, received_chunks_);
+}
@@ -0,0 +1,336 @@
+#pragma once
+
+#include "allocation_counter.hpp"
+
+#include <gtest/gtest.h>
+#include <telnetpp/options/mccp/codec.hpp>
+#include <telnetpp/options/mccp/detail/output_buffer.hpp>
+#include <telnetpp/options/mccp/flush_policy.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace telnetpp::literals;  // NOLINT
+
+// A suite of tests that every compression backend must pass, so that any
+// backend can be used wherever another is.  Each backend instantiates the
+// suite with a type that names its compressor and decompressor, both of
+// which must be default-constructible, e.g.
+//
+//     struct zlib_backend
+//     {
+//         using compressor = telnetpp::options::mccp::zlib::compressor;
+//         using decompressor = telnetpp::options::mccp::zlib::decompressor;
+//     };
+//
+//     INSTANTIATE_TYPED_TEST_SUITE_P(zlib, an_mccp_backend, zlib_backend);
+
+template <typename Backend>
+class an_mccp_backend : public testing::Test
+{
+protected:
+    using compressor_type = typename Backend::compressor;
+    using decompressor_type = typename Backend::decompressor;
+
+    an_mccp_backend()
+    {
+        compressor_.start();
+        decompressor_.start();
+    }
+
+    std::vector<telnetpp::byte> compress(telnetpp::bytes data)
+    {
+        std::vector<telnetpp::byte> result;
+        compressor_(data, append_to(result));
+        return result;
+    }
+
+    std::vector<telnetpp::byte> flush()
+    {
+        std::vector<telnetpp::byte> result;
+        compressor_.flush(append_to(result));
+        return result;
+    }
+
+    std::vector<telnetpp::byte> finish()
+    {
+        std::vector<telnetpp::byte> result;
+        compressor_.finish(append_to(result));
+        return result;
+    }
+
+    std::vector<telnetpp::byte> decompress(telnetpp::bytes data)
+    {
+        std::vector<telnetpp::byte> result;
+        decompressor_(data, [&](telnetpp::bytes output, bool ended) {
+            result.insert(result.end(), output.begin(), output.end());
+            decompression_ended_ = decompression_ended_ || ended;
+        });
+        return result;
+    }
+
+    static std::vector<telnetpp::byte> as_vector(telnetpp::bytes data)
+    {
+        return {data.begin(), data.end()};
+    }
+
+    static std::vector<telnetpp::byte> noise(std::size_t size)
+    {
+        std::vector<telnetpp::byte> result(size);
+        std::generate(result.begin(), result.end(), [n = 1U]() mutable {
+            n = n * 1664525U + 1013904223U;
+            return static_cast<telnetpp::byte>(n >> 24);
+        });
+        return result;
+    }
+
+    compressor_type compressor_;
+    decompressor_type decompressor_;
+    bool decompression_ended_{false};
+
+private:
+    static auto append_to(std::vector<telnetpp::byte> &result)
+    {
+        return [&result](telnetpp::bytes data, bool) {
+            result.insert(result.end(), data.begin(), data.end());
+        };
+    }
+};
+
+TYPED_TEST_SUITE_P(an_mccp_backend);
+
+TYPED_TEST_P(an_mccp_backend, passes_data_through_when_not_started)
+{
+    typename TestFixture::compressor_type compressor;
+    typename TestFixture::decompressor_type decompressor;
+    auto const data = "plain data"_tb;
+
+    std::vector<telnetpp::byte> compressed;
+    compressor(data, [&](telnetpp::bytes output, bool) {
+        compressed.insert(compressed.end(), output.begin(), output.end());
+    });
+
+    std::vector<telnetpp::byte> decompressed;
+    decompressor(compressed, [&](telnetpp::bytes output, bool) {
+        decompressed.insert(decompressed.end(), output.begin(), output.end());
+    });
+
+    ASSERT_EQ(this->as_vector(data), compressed);
+    ASSERT_EQ(this->as_vector(data), decompressed);
+}
+
+TYPED_TEST_P(an_mccp_backend, makes_each_write_available_immediately)
+{
+    auto const data = "look north"_tb;
+
+    ASSERT_EQ(this->as_vector(data), this->decompress(this->compress(data)));
+    ASSERT_FALSE(this->decompression_ended_);
+}
+
+TYPED_TEST_P(an_mccp_backend, compresses_repetitive_data)
+{
+    std::vector<telnetpp::byte> data;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto const line = "You are standing in an open field.\r\n"_tb;
+        data.insert(data.end(), line.begin(), line.end());
+    }
+
+    auto const compressed = this->compress(data);
+
+    ASSERT_LT(compressed.size(), data.size() / 4);
+    ASSERT_EQ(data, this->decompress(compressed));
+}
+
+TYPED_TEST_P(an_mccp_backend, decompresses_data_received_byte_by_byte)
+{
+    auto const compressed = this->compress("byte by byte"_tb);
+    std::vector<telnetpp::byte> decompressed;
+
+    for (auto const by : compressed)
+    {
+        auto const output = this->decompress(telnetpp::bytes{&by, 1});
+        decompressed.insert(decompressed.end(), output.begin(), output.end());
+    }
+
+    ASSERT_EQ(this->as_vector("byte by byte"_tb), decompressed);
+}
+
+TYPED_TEST_P(an_mccp_backend, passes_on_large_output_in_one_piece)
+{
+    auto const data = this->noise(256 * 1024);
+    int compressed_pieces = 0;
+    std::vector<telnetpp::byte> compressed;
+
+    this->compressor_(data, [&](telnetpp::bytes output, bool) {
+        ++compressed_pieces;
+        compressed.insert(compressed.end(), output.begin(), output.end());
+    });
+
+    int decompressed_pieces = 0;
+    std::vector<telnetpp::byte> decompressed;
+
+    this->decompressor_(compressed, [&](telnetpp::bytes output, bool) {
+        ++decompressed_pieces;
+        decompressed.insert(decompressed.end(), output.begin(), output.end());
+    });
+
+    ASSERT_EQ(1, compressed_pieces);
+    ASSERT_EQ(1, decompressed_pieces);
+    ASSERT_EQ(data, decompressed);
+}
+
+TYPED_TEST_P(an_mccp_backend, passes_on_hugely_expanded_output_in_pieces)
+{
+    // A peer can send a little data that expands to a great deal.  That
+    // must not make the decompressor allocate space for all of it at once.
+    constexpr std::size_t expanded_size = 16 * 1024 * 1024;
+    auto const compressed =
+        this->compress(std::vector<telnetpp::byte>(expanded_size, 'x'));
+    ASSERT_LT(compressed.size(), expanded_size / 500);
+
+    std::size_t decompressed_size = 0;
+    bool all_decompressed_data_matches = true;
+
+    allocation_counter::reset_largest_allocation();
+
+    this->decompressor_(compressed, [&](telnetpp::bytes output, bool) {
+        decompressed_size += output.size();
+        all_decompressed_data_matches =
+            all_decompressed_data_matches
+            && std::all_of(output.begin(), output.end(), [](auto by) {
+                   return by == 'x';
+               });
+    });
+
+    ASSERT_EQ(expanded_size, decompressed_size);
+    ASSERT_TRUE(all_decompressed_data_matches);
+    using sizes = telnetpp::options::mccp::detail::output_buffer_sizes;
+    ASSERT_LE(
+        allocation_counter::largest_allocation(), sizes::max_inflated_size);
+}
+
+TYPED_TEST_P(
+    an_mccp_backend, stops_decompressing_when_finished_while_passing_on_a_piece)
+{
+    // A peer can end compression while sending data that expands to more
+    // than one piece.  Once the continuation has finished the stream, the
+    // rest of the data must be passed on as it is.
+    constexpr std::size_t expanded_size = 16 * 1024 * 1024;
+    auto const compressed =
+        this->compress(std::vector<telnetpp::byte>(expanded_size, 'x'));
+
+    std::vector<std::vector<telnetpp::byte>> pieces;
+
+    this->decompressor_(compressed, [&](telnetpp::bytes output, bool) {
+        pieces.emplace_back(output.begin(), output.end());
+
+        if (pieces.size() == 1)
+        {
+            this->decompressor_.finish([](telnetpp::bytes, bool) {});
+        }
+    });
+
+    ASSERT_EQ(2U, pieces.size());
+    ASSERT_TRUE(std::all_of(pieces[0].begin(), pieces[0].end(), [](auto by) {
+        return by == 'x';
+    }));
+    ASSERT_FALSE(pieces[1].empty());
+    ASSERT_LT(pieces[1].size(), compressed.size());
+    ASSERT_TRUE(std::equal(
+        pieces[1].begin(),
+        pieces[1].end(),
+        compressed.end() - pieces[1].size()));
+}
+
+TYPED_TEST_P(an_mccp_backend, holds_back_data_until_flushed)
+{
+    this->compressor_.set_flush_policy(
+        telnetpp::options::mccp::flush_policy::explicit_only);
+
+    auto compressed = this->compress("held "_tb);
+    auto const more = this->compress("back"_tb);
+    compressed.insert(compressed.end(), more.begin(), more.end());
+    ASSERT_TRUE(this->decompress(compressed).empty());
+
+    ASSERT_EQ(this->as_vector("held back"_tb), this->decompress(this->flush()));
+}
+
+TYPED_TEST_P(an_mccp_backend, ends_the_decompression_stream_on_finishing)
+{
+    auto compressed = this->compress("compressed"_tb);
+    auto const end = this->finish();
+    compressed.insert(compressed.end(), end.begin(), end.end());
+
+    ASSERT_EQ(this->as_vector("compressed"_tb), this->decompress(compressed));
+    ASSERT_TRUE(this->decompression_ended_);
+}
+
+TYPED_TEST_P(an_mccp_backend, passes_through_data_after_the_stream_ends)
+{
+    auto compressed = this->compress("compressed "_tb);
+    auto const end = this->finish();
+    compressed.insert(compressed.end(), end.begin(), end.end());
+
+    auto const plain = "plain"_tb;
+    compressed.insert(compressed.end(), plain.begin(), plain.end());
+
+    ASSERT_EQ(
+        this->as_vector("compressed plain"_tb), this->decompress(compressed));
+}
+
+TYPED_TEST_P(an_mccp_backend, can_start_a_new_stream_after_finishing)
+{
+    auto first = this->compress("first"_tb);
+    auto const first_end = this->finish();
+    first.insert(first.end(), first_end.begin(), first_end.end());
+    ASSERT_EQ(this->as_vector("first"_tb), this->decompress(first));
+
+    this->compressor_.start();
+    this->decompressor_.start();
+    this->decompression_ended_ = false;
+
+    auto const second = this->compress("second"_tb);
+    ASSERT_EQ(this->as_vector("second"_tb), this->decompress(second));
+    ASSERT_FALSE(this->decompression_ended_);
+}
+
+TYPED_TEST_P(an_mccp_backend, rejects_corrupted_data)
+{
+    auto const garbage = this->noise(64);
+
+    ASSERT_THROW(
+        this->decompress(garbage),
+        telnetpp::options::mccp::corrupted_stream_error);
+}
+
+TYPED_TEST_P(an_mccp_backend, reports_its_statistics)
+{
+    auto const data = "statistics"_tb;
+    auto const compressed = this->compress(data);
+    this->decompress(compressed);
+
+    ASSERT_EQ(data.size(), this->compressor_.statistics().bytes_in);
+    ASSERT_EQ(compressed.size(), this->compressor_.statistics().bytes_out);
+    ASSERT_EQ(1U, this->compressor_.statistics().flushes);
+    ASSERT_EQ(compressed.size(), this->decompressor_.statistics().bytes_in);
+    ASSERT_EQ(data.size(), this->decompressor_.statistics().bytes_out);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(
+    an_mccp_backend,
+    passes_data_through_when_not_started,
+    makes_each_write_available_immediately,
+    compresses_repetitive_data,
+    decompresses_data_received_byte_by_byte,
+    passes_on_large_output_in_one_piece,
+    passes_on_hugely_expanded_output_in_pieces,
+    stops_decompressing_when_finished_while_passing_on_a_piece,
+    holds_back_data_until_flushed,
+    ends_the_decompression_stream_on_finishing,
+    passes_through_data_after_the_stream_ends,
+    can_start_a_new_stream_after_finishing,
+    rejects_corrupted_data,
+    reports_its_statistics);
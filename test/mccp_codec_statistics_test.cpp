@@ -0,0 +1,286 @@
+#include <gtest/gtest.h>
+#include <telnetpp/options/mccp/codec.hpp>
+#include <telnetpp/options/mccp/statistics.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace {
+
+namespace mccp = telnetpp::options::mccp;
+
+// A codec that "compresses" each byte into two, and which ends its stream
+// inline when it meets an 'x'.  Flushing sends on a single byte.
+class fake_codec : public mccp::codec
+{
+public:
+    bool throw_next_chunk_ = false;
+
+private:
+    void do_finish(continuation const &cont) override
+    {
+        cont("E"_tb, true);
+    }
+
+    void do_flush(continuation const &cont) override
+    {
+        count_flush();
+        cont("F"_tb, false);
+    }
+
+    telnetpp::bytes transform_chunk(
+        telnetpp::bytes data, continuation const &cont) override
+    {
+        if (throw_next_chunk_)
+        {
+            throw mccp::corrupted_stream_error("fake corruption");
+        }
+
+        std::vector<telnetpp::byte> transformed_data;
+        auto position = data.begin();
+
+        for (; position != data.end(); ++position)
+        {
+            transformed_data.push_back(*position);
+            transformed_data.push_back(*position);
+
+            if (*position == 'x')
+            {
+                ++position;
+                cont(transformed_data, true);
+                return {position, data.end()};
+            }
+        }
+
+        cont(transformed_data, false);
+        return {};
+    }
+};
+
+constexpr auto ignore = [](telnetpp::bytes, bool) {};
+
+class a_codec : public testing::Test
+{
+protected:
+    fake_codec codec_;
+};
+
+}  // namespace
+
+TEST_F(a_codec, has_no_statistics_initially)
+{
+    ASSERT_EQ(mccp::codec_statistics{}, codec_.statistics());
+}
+
+TEST_F(a_codec, does_not_count_untransformed_data)
+{
+    codec_("data"_tb, ignore);
+
+    ASSERT_EQ(mccp::codec_statistics{}, codec_.statistics());
+}
+
+TEST_F(a_codec, counts_the_bytes_that_it_transforms)
+{
+    codec_.start();
+    codec_("data"_tb, ignore);
+    codec_("more"_tb, ignore);
+
+    ASSERT_EQ(8U, codec_.statistics().bytes_in);
+    ASSERT_EQ(16U, codec_.statistics().bytes_out);
+}
+
+TEST_F(a_codec, counts_started_and_finished_streams)
+{
+    codec_.start();
+    ASSERT_EQ(1U, codec_.statistics().streams_started);
+    ASSERT_EQ(0U, codec_.statistics().streams_finished);
+
+    codec_.finish(ignore);
+    ASSERT_EQ(1U, codec_.statistics().streams_started);
+    ASSERT_EQ(1U, codec_.statistics().streams_finished);
+
+    // The output of the finish is part of the stream.
+    ASSERT_EQ(1U, codec_.statistics().bytes_out);
+}
+
+TEST_F(a_codec, does_not_count_finishing_an_unstarted_stream)
+{
+    codec_.finish(ignore);
+
+    ASSERT_EQ(mccp::codec_statistics{}, codec_.statistics());
+}
+
+TEST_F(a_codec, counts_a_stream_that_ends_inline)
+{
+    codec_.start();
+    codec_("abxcd"_tb, ignore);
+
+    ASSERT_EQ(1U, codec_.statistics().streams_finished);
+    ASSERT_EQ(3U, codec_.statistics().bytes_in);
+    ASSERT_EQ(6U, codec_.statistics().bytes_out);
+}
+
+TEST_F(a_codec, counts_flushes_of_a_started_stream)
+{
+    codec_.flush(ignore);
+    ASSERT_EQ(0U, codec_.statistics().flushes);
+
+    codec_.start();
+    codec_.flush(ignore);
+    codec_.flush(ignore);
+
+    ASSERT_EQ(2U, codec_.statistics().flushes);
+    ASSERT_EQ(2U, codec_.statistics().bytes_out);
+}
+
+TEST_F(a_codec, does_not_count_time_spent_in_the_continuation_as_transforming)
+{
+    constexpr auto delay = std::chrono::milliseconds(20);
+
+    codec_.set_timing_enabled(true);
+    codec_.start();
+    codec_("data"_tb, [delay](telnetpp::bytes, bool) {
+        std::this_thread::sleep_for(delay);
+    });
+
+    ASSERT_GE(codec_.statistics().transform_time.count(), 0);
+    ASSERT_LT(codec_.statistics().transform_time, delay);
+}
+
+TEST_F(a_codec, does_not_measure_time_by_default)
+{
+    codec_.start();
+    codec_("data"_tb, ignore);
+
+    ASSERT_EQ(0, codec_.statistics().transform_time.count());
+}
+
+TEST_F(a_codec, counts_the_work_done_before_a_transformation_throws)
+{
+    codec_.start();
+    codec_("data"_tb, ignore);
+    codec_.throw_next_chunk_ = true;
+
+    EXPECT_THROW(codec_("more"_tb, ignore), mccp::corrupted_stream_error);
+    ASSERT_EQ(4U, codec_.statistics().bytes_in);
+}
+
+TEST_F(a_codec, can_have_its_statistics_reset)
+{
+    codec_.start();
+    codec_("data"_tb, ignore);
+    codec_.reset_statistics();
+
+    ASSERT_EQ(mccp::codec_statistics{}, codec_.statistics());
+
+    codec_("more"_tb, ignore);
+    ASSERT_EQ(4U, codec_.statistics().bytes_in);
+}
+
+TEST(a_statistics_collector, has_no_statistics_initially)
+{
+    mccp::statistics_collector const collector;
+
+    ASSERT_EQ(mccp::codec_statistics{}, collector.snapshot());
+}
+
+TEST(a_statistics_collector, accumulates_the_statistics_of_many_codecs)
+{
+    mccp::statistics_collector collector;
+    fake_codec codec0;
+    fake_codec codec1;
+    codec0.set_statistics_collector(&collector);
+    codec1.set_statistics_collector(&collector);
+
+    codec0.start();
+    codec0("data"_tb, ignore);
+    codec0.finish(ignore);
+
+    codec1.start();
+    codec1("ab"_tb, ignore);
+    codec1.flush(ignore);
+
+    auto expected = codec0.statistics();
+    expected += codec1.statistics();
+
+    ASSERT_EQ(expected, collector.snapshot());
+    ASSERT_EQ(6U, collector.snapshot().bytes_in);
+    ASSERT_EQ(2U, collector.snapshot().streams_started);
+    ASSERT_EQ(1U, collector.snapshot().streams_finished);
+    ASSERT_EQ(1U, collector.snapshot().flushes);
+}
+
+TEST(a_statistics_collector, is_unaffected_by_resetting_a_codec)
+{
+    mccp::statistics_collector collector;
+    fake_codec codec;
+    codec.set_statistics_collector(&collector);
+
+    codec.start();
+    codec("data"_tb, ignore);
+    codec.reset_statistics();
+
+    ASSERT_EQ(4U, collector.snapshot().bytes_in);
+}
+
+TEST(a_statistics_collector, collects_nothing_from_a_detached_codec)
+{
+    mccp::statistics_collector collector;
+    fake_codec codec;
+    codec.set_statistics_collector(&collector);
+    codec.start();
+    codec.set_statistics_collector(nullptr);
+
+    codec("data"_tb, ignore);
+
+    ASSERT_EQ(1U, collector.snapshot().streams_started);
+    ASSERT_EQ(0U, collector.snapshot().bytes_in);
+}
+
+TEST(a_statistics_collector, can_be_reset)
+{
+    mccp::statistics_collector collector;
+    fake_codec codec;
+    codec.set_statistics_collector(&collector);
+    codec.start();
+    codec("data"_tb, ignore);
+
+    collector.reset();
+
+    ASSERT_EQ(mccp::codec_statistics{}, collector.snapshot());
+}
+
+TEST(a_statistics_collector, can_be_shared_between_threads)
+{
+    constexpr auto thread_count = 4;
+    constexpr auto writes_per_thread = 1000;
+
+    mccp::statistics_collector collector;
+    std::vector<std::thread> threads;
+
+    for (auto i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([&collector] {
+            fake_codec codec;
+            codec.set_statistics_collector(&collector);
+            codec.start();
+
+            for (auto j = 0; j < writes_per_thread; ++j)
+            {
+                codec("data"_tb, ignore);
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(
+        std::uint64_t{thread_count} * writes_per_thread * 4,
+        collector.snapshot().bytes_in);
+}
@@ -4,6 +4,7 @@
 #include <zlib.h>
 
 #include <random>
+#include <stdexcept>
 #include <vector>
 
 using namespace telnetpp::literals;  // NOLINT
@@ -192,3 +193,312 @@ TEST_F(a_started_zlib_compressor, can_compress_large_amounts_of_data)
     ASSERT_EQ(large_data.size(), decompressed_data.size());
     ASSERT_EQ(large_data, decompressed_data);
 }
+
+TEST_F(a_zlib_compressor, uses_default_compression_parameters)
+{
+    auto const &parameters = zlib_compressor_.parameters();
+
+    ASSERT_EQ(Z_DEFAULT_COMPRESSION, parameters.level);
+    ASSERT_EQ(MAX_WBITS, parameters.window_bits);
+    ASSERT_EQ(8, parameters.memory_level);
+}
+
+TEST_F(an_unstarted_zlib_compressor, uses_no_memory_for_compression)
+{
+    compress_data("test_data"_tb);
+
+    ASSERT_EQ(0U, zlib_compressor_.memory_usage());
+}
+
+TEST_F(a_started_zlib_compressor, reports_the_memory_used_by_its_stream)
+{
+    compress_data("test_data"_tb);
+
+    // zlib documents deflate's memory use as at least this much.
+    constexpr std::size_t minimum_memory_usage =
+        (1U << (MAX_WBITS + 2)) + (1U << (8 + 9));
+    ASSERT_GE(zlib_compressor_.memory_usage(), minimum_memory_usage);
+
+    finish_compression();
+    ASSERT_EQ(0U, zlib_compressor_.memory_usage());
+}
+
+namespace {
+
+std::size_t memory_usage_with(
+    telnetpp::options::mccp::zlib::compression_parameters const &parameters)
+{
+    telnetpp::options::mccp::zlib::compressor compressor{parameters};
+    compressor.start();
+    compressor("test_data"_tb, [](telnetpp::bytes, bool) {});
+    return compressor.memory_usage();
+}
+
+}  // namespace
+
+TEST(
+    a_zlib_compressor_with_parameters,
+    uses_memory_according_to_its_parameters)
+{
+    namespace zlib = telnetpp::options::mccp::zlib;
+
+    auto const low_memory_usage =
+        memory_usage_with(zlib::low_memory_compression);
+    auto const default_memory_usage =
+        memory_usage_with(zlib::default_compression);
+    auto const high_ratio_memory_usage =
+        memory_usage_with(zlib::high_ratio_compression);
+
+    ASSERT_LT(low_memory_usage, 32U * 1024U);
+    ASSERT_LT(low_memory_usage, default_memory_usage);
+    ASSERT_LT(default_memory_usage, high_ratio_memory_usage);
+}
+
+TEST(a_zlib_compressor_with_parameters, compresses_data_that_zlib_inflates)
+{
+    telnetpp::options::mccp::zlib::compressor compressor{
+        telnetpp::options::mccp::zlib::low_memory_compression};
+
+    auto const test_data = "datadatadatadatadatadata"_tb;
+    std::vector<telnetpp::byte> compressed_data;
+
+    compressor.start();
+    compressor(test_data, [&](telnetpp::bytes data, bool) {
+        compressed_data.insert(compressed_data.end(), data.begin(), data.end());
+    });
+
+    z_stream stream = {};
+    auto response = inflateInit(&stream);
+    assert(response == Z_OK);
+
+    telnetpp::byte output_buffer[1024];
+    stream.avail_in = static_cast<uInt>(compressed_data.size());
+    stream.next_in = compressed_data.data();
+    stream.avail_out = sizeof(output_buffer);
+    stream.next_out = output_buffer;
+
+    response = inflate(&stream, Z_SYNC_FLUSH);
+    EXPECT_EQ(response, Z_OK);
+    inflateEnd(&stream);
+
+    auto const output_data = telnetpp::bytes{output_buffer, stream.next_out};
+    ASSERT_TRUE(telnetpp::bytes_equal(test_data, output_data));
+}
+
+TEST(a_zlib_compressor_with_parameters, rejects_parameters_out_of_range)
+{
+    using telnetpp::options::mccp::zlib::compressor;
+
+    EXPECT_THROW(compressor({.level = 10}), std::invalid_argument);
+    EXPECT_THROW(compressor({.level = -2}), std::invalid_argument);
+    EXPECT_THROW(compressor({.window_bits = 8}), std::invalid_argument);
+    EXPECT_THROW(compressor({.window_bits = 16}), std::invalid_argument);
+    EXPECT_THROW(compressor({.memory_level = 0}), std::invalid_argument);
+    EXPECT_THROW(compressor({.memory_level = 10}), std::invalid_argument);
+}
+
+namespace {
+
+// Decompresses as much of the data as can be, ignoring whether the stream
+// has ended.
+std::vector<telnetpp::byte> inflate_available(
+    std::vector<telnetpp::byte> const &compressed_data)
+{
+    z_stream stream = {};
+    [[maybe_unused]] auto response = inflateInit(&stream);
+    assert(response == Z_OK);
+
+    telnetpp::byte output_buffer[1024];
+    stream.avail_in = static_cast<uInt>(compressed_data.size());
+    stream.next_in = const_cast<telnetpp::byte *>(compressed_data.data());
+    stream.avail_out = sizeof(output_buffer);
+    stream.next_out = output_buffer;
+
+    inflate(&stream, Z_SYNC_FLUSH);
+    inflateEnd(&stream);
+
+    return {output_buffer, stream.next_out};
+}
+
+class a_started_zlib_compressor_with_a_flush_policy
+  : public a_started_zlib_compressor
+{
+protected:
+    void flush_compression()
+    {
+        zlib_compressor_.flush([&](telnetpp::bytes data, bool) {
+            ++flushed_writes_;
+            received_data_.insert(
+                received_data_.end(), data.begin(), data.end());
+        });
+    }
+
+    int flushed_writes_ = 0;
+};
+
+}  // namespace
+
+TEST_F(
+    a_started_zlib_compressor_with_a_flush_policy,
+    flushes_every_write_by_default)
+{
+    compress_data("abc"_tb);
+
+    ASSERT_TRUE(telnetpp::bytes_equal(
+        "abc"_tb, inflate_available(received_data_)));
+
+    flush_compression();
+    ASSERT_EQ(0, flushed_writes_);
+}
+
+TEST_F(
+    a_started_zlib_compressor_with_a_flush_policy,
+    holds_back_writes_until_explicitly_flushed)
+{
+    zlib_compressor_.set_flush_policy(
+        telnetpp::options::mccp::zlib::flush_policy::explicit_only);
+
+    compress_data("abc"_tb);
+    compress_data("def"_tb);
+    ASSERT_TRUE(inflate_available(received_data_).empty());
+
+    flush_compression();
+    ASSERT_TRUE(telnetpp::bytes_equal(
+        "abcdef"_tb, inflate_available(received_data_)));
+
+    // With nothing written since, a further flush adds nothing.
+    auto const flushed_writes = flushed_writes_;
+    flush_compression();
+    ASSERT_EQ(flushed_writes, flushed_writes_);
+}
+
+TEST_F(
+    a_started_zlib_compressor_with_a_flush_policy,
+    flushes_writes_once_they_reach_the_threshold)
+{
+    zlib_compressor_.set_flush_policy(
+        telnetpp::options::mccp::zlib::flush_policy::threshold, 6);
+
+    compress_data("abc"_tb);
+    ASSERT_TRUE(inflate_available(received_data_).empty());
+
+    compress_data("def"_tb);
+    ASSERT_TRUE(telnetpp::bytes_equal(
+        "abcdef"_tb, inflate_available(received_data_)));
+
+    compress_data("g"_tb);
+    ASSERT_TRUE(telnetpp::bytes_equal(
+        "abcdef"_tb, inflate_available(received_data_)));
+
+    flush_compression();
+    ASSERT_TRUE(telnetpp::bytes_equal(
+        "abcdefg"_tb, inflate_available(received_data_)));
+}
+
+TEST_F(
+    a_started_zlib_compressor_with_a_flush_policy,
+    compresses_small_writes_better_when_not_flushing_each_one)
+{
+    auto const compressed_size = [](auto policy) {
+        telnetpp::options::mccp::zlib::compressor compressor;
+        compressor.set_flush_policy(policy);
+        compressor.start();
+
+        std::size_t size = 0;
+        auto const count = [&size](telnetpp::bytes data, bool) {
+            size += data.size();
+        };
+
+        for (int i = 0; i < 100; ++i)
+        {
+            compressor("You hit the goblin.\r\n"_tb, count);
+        }
+
+        compressor.flush(count);
+        return size;
+    };
+
+    using telnetpp::options::mccp::zlib::flush_policy;
+    ASSERT_LT(
+        compressed_size(flush_policy::explicit_only) * 4,
+        compressed_size(flush_policy::every_write));
+}
+
+TEST_F(a_started_zlib_compressor_with_a_flush_policy, ends_with_all_data)
+{
+    zlib_compressor_.set_flush_policy(
+        telnetpp::options::mccp::zlib::flush_policy::explicit_only);
+
+    compress_data("abc"_tb);
+    finish_compression();
+
+    ASSERT_TRUE(telnetpp::bytes_equal(
+        "abc"_tb, inflate_available(received_data_)));
+    ASSERT_TRUE(compression_ended_);
+}
+
+TEST_F(an_unstarted_zlib_compressor, does_nothing_when_flushed)
+{
+    bool called = false;
+    zlib_compressor_.flush([&called](telnetpp::bytes, bool) {
+        called = true;
+    });
+
+    ASSERT_FALSE(called);
+}
+
+TEST_F(
+    a_started_zlib_compressor,
+    passes_on_a_large_compressed_result_in_one_piece)
+{
+    // Random data does not compress, so this yields many kilobytes of
+    // output.
+    std::mt19937 gen(0);
+    std::vector<telnetpp::byte> large_data(64 * 1024);
+    boost::generate(large_data, gen);
+
+    int calls = 0;
+    zlib_compressor_(large_data, [&](telnetpp::bytes data, bool) {
+        ++calls;
+        received_data_.insert(received_data_.end(), data.begin(), data.end());
+    });
+
+    ASSERT_EQ(1, calls);
+    ASSERT_GT(received_data_.size(), large_data.size());
+
+    calls = 0;
+    zlib_compressor_.finish([&](telnetpp::bytes, bool) { ++calls; });
+    ASSERT_EQ(1, calls);
+}
+
+TEST_F(
+    a_started_zlib_compressor_with_a_flush_policy,
+    counts_each_flush_in_its_statistics)
+{
+    compress_data("abc"_tb);
+    compress_data("def"_tb);
+    ASSERT_EQ(2U, zlib_compressor_.statistics().flushes);
+
+    zlib_compressor_.set_flush_policy(
+        telnetpp::options::mccp::zlib::flush_policy::explicit_only);
+    compress_data("ghi"_tb);
+    ASSERT_EQ(2U, zlib_compressor_.statistics().flushes);
+
+    flush_compression();
+    ASSERT_EQ(3U, zlib_compressor_.statistics().flushes);
+}
+
+TEST_F(a_started_zlib_compressor, reports_how_well_it_compresses)
+{
+    zlib_compressor_.set_timing_enabled(true);
+    compress_data("datadatadatadatadatadatadatadatadatadata"_tb);
+    finish_compression();
+
+    auto const &statistics = zlib_compressor_.statistics();
+    ASSERT_EQ(40U, statistics.bytes_in);
+    ASSERT_EQ(received_data_.size(), statistics.bytes_out);
+    ASSERT_LT(statistics.bytes_out, statistics.bytes_in);
+    ASSERT_EQ(1U, statistics.streams_started);
+    ASSERT_EQ(1U, statistics.streams_finished);
+    ASSERT_GT(statistics.transform_time.count(), 0);
+}
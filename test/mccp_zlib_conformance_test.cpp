@@ -0,0 +1,16 @@
+#include "mccp_codec_conformance.hpp"
+
+#include <telnetpp/options/mccp/zlib/compressor.hpp>
+#include <telnetpp/options/mccp/zlib/decompressor.hpp>
+
+namespace {
+
+struct zlib_backend
+{
+    using compressor = telnetpp::options::mccp::zlib::compressor;
+    using decompressor = telnetpp::options::mccp::zlib::decompressor;
+};
+
+}  // namespace
+
+INSTANTIATE_TYPED_TEST_SUITE_P(zlib, an_mccp_backend, zlib_backend);
@@ -1,8 +1,12 @@
+#include "allocation_counter.hpp"
+
 #include <boost/range/algorithm/generate.hpp>
 #include <gtest/gtest.h>
 #include <telnetpp/options/mccp/zlib/decompressor.hpp>
+#include <telnetpp/options/mccp/zlib/detail/output_buffer.hpp>
 #include <zlib.h>
 
+#include <algorithm>
 #include <random>
 
 using namespace telnetpp::literals;  // NOLINT
@@ -328,3 +332,145 @@ TEST_F(
 
     deflateEnd(&stream);
 }
+
+namespace {
+
+std::vector<telnetpp::byte> compress_data(telnetpp::bytes data)
+{
+    z_stream stream = {};
+    auto response = deflateInit(&stream, Z_DEFAULT_COMPRESSION);
+    assert(response == Z_OK);
+
+    std::vector<telnetpp::byte> compressed_data(
+        deflateBound(&stream, static_cast<uLong>(data.size())) + 16);
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_in = const_cast<telnetpp::byte *>(data.data());
+    stream.avail_out = static_cast<uInt>(compressed_data.size());
+    stream.next_out = compressed_data.data();
+
+    response = deflate(&stream, Z_SYNC_FLUSH);
+    assert(response == Z_OK);
+    compressed_data.resize(compressed_data.size() - stream.avail_out);
+    deflateEnd(&stream);
+
+    return compressed_data;
+}
+
+}  // namespace
+
+TEST_F(
+    a_started_zlib_decompressor,
+    passes_on_a_large_decompressed_result_in_one_piece)
+{
+    // A large, highly compressible block, such as a map, expands to far more
+    // than the size of the compressed data.
+    std::vector<telnetpp::byte> const large_data(
+        telnetpp::options::mccp::zlib::detail::output_buffer::
+                max_inflated_size
+            / 2,
+        'x');
+    auto const compressed_data = compress_data(large_data);
+
+    int calls = 0;
+    zlib_decompressor_(compressed_data, [&](telnetpp::bytes data, bool) {
+        ++calls;
+        received_data_.insert(received_data_.end(), data.begin(), data.end());
+    });
+
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ(large_data, received_data_);
+}
+
+TEST_F(
+    a_started_zlib_decompressor,
+    passes_on_a_hugely_expanded_result_in_pieces_of_bounded_size)
+{
+    // A peer can send a little data that expands to a great deal.  That
+    // must not make the decompressor allocate space for all of it at once.
+    constexpr std::size_t expanded_size = 16 * 1024 * 1024;
+    std::vector<telnetpp::byte> const huge_data(expanded_size, 'x');
+    auto const compressed_data = compress_data(huge_data);
+    ASSERT_LT(compressed_data.size(), expanded_size / 500);
+
+    std::size_t received_size = 0;
+    bool all_received_data_matches = true;
+
+    allocation_counter::reset_largest_allocation();
+
+    zlib_decompressor_(compressed_data, [&](telnetpp::bytes data, bool) {
+        received_size += data.size();
+        all_received_data_matches =
+            all_received_data_matches
+            && std::all_of(data.begin(), data.end(), [](auto by) {
+                   return by == 'x';
+               });
+    });
+
+    ASSERT_EQ(expanded_size, received_size);
+    ASSERT_TRUE(all_received_data_matches);
+    ASSERT_LE(
+        allocation_counter::largest_allocation(),
+        telnetpp::options::mccp::zlib::detail::output_buffer::
+            max_inflated_size);
+}
+
+TEST_F(
+    a_started_zlib_decompressor,
+    stops_decompressing_when_finished_while_passing_on_a_piece)
+{
+    // A peer can end compression while sending data that expands to more
+    // than one piece.  Once the continuation has finished the stream, the
+    // rest of the data must be passed on as it is.
+    constexpr std::size_t expanded_size = 16 * 1024 * 1024;
+    std::vector<telnetpp::byte> const huge_data(expanded_size, 'x');
+    auto const compressed_data = compress_data(huge_data);
+
+    std::vector<std::vector<telnetpp::byte>> pieces;
+
+    zlib_decompressor_(compressed_data, [&](telnetpp::bytes data, bool) {
+        pieces.emplace_back(data.begin(), data.end());
+
+        if (pieces.size() == 1)
+        {
+            zlib_decompressor_.finish([](telnetpp::bytes, bool) {});
+        }
+    });
+
+    ASSERT_EQ(2U, pieces.size());
+    ASSERT_GT(
+        pieces[0].size(),
+        telnetpp::options::mccp::zlib::detail::output_buffer::
+                max_inflated_size
+            / 2);
+    ASSERT_FALSE(pieces[1].empty());
+    ASSERT_LT(pieces[1].size(), compressed_data.size());
+    ASSERT_TRUE(std::equal(
+        pieces[1].begin(),
+        pieces[1].end(),
+        compressed_data.end() - pieces[1].size()));
+}
+
+TEST_F(a_started_zlib_decompressor, reports_how_much_it_decompresses)
+{
+    auto const test_data = "datadatadatadatadatadatadatadatadatadata"_tb;
+    std::vector<telnetpp::byte> compressed_stream(
+        compressBound(static_cast<uLong>(test_data.size())));
+    auto compressed_size = static_cast<uLongf>(compressed_stream.size());
+    [[maybe_unused]] auto const response = compress(
+        compressed_stream.data(),
+        &compressed_size,
+        test_data.data(),
+        static_cast<uLong>(test_data.size()));
+    assert(response == Z_OK);
+    compressed_stream.resize(compressed_size);
+
+    decompress_data(compressed_stream);
+    decompress_data("plain"_tb);
+
+    auto const &statistics = zlib_decompressor_.statistics();
+    ASSERT_EQ(compressed_stream.size(), statistics.bytes_in);
+    ASSERT_EQ(test_data.size(), statistics.bytes_out);
+    ASSERT_EQ(1U, statistics.streams_started);
+    ASSERT_EQ(1U, statistics.streams_finished);
+    ASSERT_EQ(0U, statistics.flushes);
+}
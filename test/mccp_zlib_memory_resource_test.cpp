@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+#include <telnetpp/options/mccp/zlib/compressor.hpp>
+#include <telnetpp/options/mccp/zlib/decompressor.hpp>
+#include <telnetpp/options/mccp/zlib/stream_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace zlib = telnetpp::options::mccp::zlib;
+
+namespace {
+
+// A memory resource that counts what is allocated from it.
+class counting_resource final : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations{0};
+    std::size_t deallocations{0};
+    std::size_t bytes_outstanding{0};
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        auto *block = upstream_->allocate(bytes, alignment);
+        ++allocations;
+        bytes_outstanding += bytes;
+        return block;
+    }
+
+    void do_deallocate(
+        void *block, std::size_t bytes, std::size_t alignment) override
+    {
+        upstream_->deallocate(block, bytes, alignment);
+        ++deallocations;
+        bytes_outstanding -= bytes;
+    }
+
+    [[nodiscard]] bool do_is_equal(
+        std::pmr::memory_resource const &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource *upstream_{std::pmr::new_delete_resource()};
+};
+
+std::vector<telnetpp::byte> compress_stream(
+    zlib::compressor &compressor, telnetpp::bytes data)
+{
+    std::vector<telnetpp::byte> result;
+    auto const append = [&result](telnetpp::bytes compressed, bool) {
+        result.insert(result.end(), compressed.begin(), compressed.end());
+    };
+
+    compressor.start();
+    compressor(data, append);
+    compressor.finish(append);
+
+    return result;
+}
+
+std::vector<telnetpp::byte> decompress_stream(
+    zlib::decompressor &decompressor, telnetpp::bytes data)
+{
+    std::vector<telnetpp::byte> result;
+
+    decompressor.start();
+    decompressor(data, [&result](telnetpp::bytes decompressed, bool) {
+        result.insert(result.end(), decompressed.begin(), decompressed.end());
+    });
+
+    return result;
+}
+
+}  // namespace
+
+TEST(a_zlib_compressor_with_a_memory_resource, allocates_its_stream_from_it)
+{
+    counting_resource resource;
+
+    {
+        zlib::compressor compressor{zlib::default_compression, &resource};
+
+        ASSERT_EQ(0U, resource.allocations);
+
+        compressor.start();
+        compressor("data"_tb, [](telnetpp::bytes, bool) {});
+
+        // The resource provides zlib's state, the stream that holds it, and
+        // the buffer for the compressed output.
+        ASSERT_NE(0U, resource.allocations);
+        ASSERT_GT(resource.bytes_outstanding, compressor.memory_usage());
+
+        compressor.finish([](telnetpp::bytes, bool) {});
+    }
+
+    ASSERT_EQ(resource.allocations, resource.deallocations);
+    ASSERT_EQ(0U, resource.bytes_outstanding);
+}
+
+TEST(a_zlib_decompressor_with_a_memory_resource, allocates_its_stream_from_it)
+{
+    zlib::compressor compressor;
+    auto const data = "datadatadatadatadata"_tb;
+    auto const expected = std::vector<telnetpp::byte>{data.begin(), data.end()};
+    auto const compressed = compress_stream(compressor, data);
+
+    counting_resource resource;
+
+    {
+        zlib::decompressor decompressor{&resource};
+        ASSERT_EQ(expected, decompress_stream(decompressor, compressed));
+        ASSERT_NE(0U, resource.allocations);
+    }
+
+    ASSERT_EQ(resource.allocations, resource.deallocations);
+    ASSERT_EQ(0U, resource.bytes_outstanding);
+}
+
+TEST(a_zlib_compressor_with_a_memory_resource, can_be_confined_to_a_slab)
+{
+    // With no upstream resource, any allocation that does not fit within
+    // the slab would throw.
+    alignas(std::max_align_t) std::array<std::byte, 64 * 1024> slab{};
+    std::pmr::monotonic_buffer_resource resource{
+        slab.data(), slab.size(), std::pmr::null_memory_resource()};
+
+    zlib::compressor compressor{zlib::low_memory_compression, &resource};
+    zlib::decompressor decompressor;
+
+    auto const data = "datadatadatadatadata"_tb;
+    auto const expected = std::vector<telnetpp::byte>{data.begin(), data.end()};
+
+    ASSERT_EQ(
+        expected,
+        decompress_stream(decompressor, compress_stream(compressor, data)));
+}
+
+TEST(a_zlib_compressor_with_a_memory_resource, throws_when_it_is_exhausted)
+{
+    // This is large enough for the stream, but not for zlib's state.
+    alignas(std::max_align_t) std::array<std::byte, 1024> slab{};
+    std::pmr::monotonic_buffer_resource resource{
+        slab.data(), slab.size(), std::pmr::null_memory_resource()};
+
+    zlib::compressor compressor{zlib::default_compression, &resource};
+    compressor.start();
+
+    EXPECT_THROW(
+        compressor("data"_tb, [](telnetpp::bytes, bool) {}), std::bad_alloc);
+}
+
+TEST(a_stream_pool_with_a_memory_resource, allocates_its_streams_from_it)
+{
+    zlib::compressor unpooled_compressor;
+    auto const compressed = compress_stream(unpooled_compressor, "data"_tb);
+
+    counting_resource resource;
+
+    {
+        zlib::compression_stream_pool pool{
+            1, zlib::default_compression, &resource};
+        ASSERT_EQ(&resource, pool.resource());
+
+        zlib::compressor compressor{pool};
+        compress_stream(compressor, "data"_tb);
+
+        // The stream is kept in the pool, and so is still allocated.
+        ASSERT_EQ(1U, pool.size());
+        ASSERT_NE(0U, resource.bytes_outstanding);
+    }
+
+    ASSERT_EQ(0U, resource.bytes_outstanding);
+
+    {
+        zlib::decompression_stream_pool pool{1, &resource};
+        zlib::decompressor decompressor{pool};
+        decompress_stream(decompressor, compressed);
+
+        ASSERT_NE(0U, resource.bytes_outstanding);
+    }
+
+    ASSERT_EQ(resource.allocations, resource.deallocations);
+    ASSERT_EQ(0U, resource.bytes_outstanding);
+}
+
+TEST(
+    a_zlib_compressor_with_a_memory_resource,
+    does_not_keep_a_large_output_buffer)
+{
+    counting_resource resource;
+    zlib::compressor compressor{zlib::default_compression, &resource};
+
+    // Random data does not compress, so the output is as large as the
+    // input.
+    std::vector<telnetpp::byte> large_data(256 * 1024);
+    std::generate(large_data.begin(), large_data.end(), [n = 0U]() mutable {
+        n = n * 1664525U + 1013904223U;
+        return static_cast<telnetpp::byte>(n >> 24);
+    });
+
+    std::size_t output_size = 0;
+    auto const count = [&output_size](telnetpp::bytes data, bool) {
+        output_size += data.size();
+    };
+
+    compressor.start();
+    compressor(large_data, count);
+    ASSERT_GT(output_size, large_data.size());
+
+    // The large buffer is kept only while the output remains large.
+    compressor("abc"_tb, count);
+
+    // Other than zlib's own state, only a small output buffer remains.
+    ASSERT_LT(
+        resource.bytes_outstanding - compressor.memory_usage(), 80U * 1024U);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <telnetpp/options/mccp/zlib/compressor.hpp>
+#include <telnetpp/options/mccp/zlib/decompressor.hpp>
+#include <telnetpp/options/mccp/zlib/stream_pool.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace zlib = telnetpp::options::mccp::zlib;
+
+namespace {
+
+// Compresses the data as a complete stream.
+std::vector<telnetpp::byte> compress_stream(
+    zlib::compressor &compressor, telnetpp::bytes data)
+{
+    std::vector<telnetpp::byte> result;
+    auto const append = [&result](telnetpp::bytes compressed, bool) {
+        result.insert(result.end(), compressed.begin(), compressed.end());
+    };
+
+    compressor.start();
+    compressor(data, append);
+    compressor.finish(append);
+
+    return result;
+}
+
+// Decompresses a complete stream.
+std::vector<telnetpp::byte> decompress_stream(
+    zlib::decompressor &decompressor, telnetpp::bytes data)
+{
+    std::vector<telnetpp::byte> result;
+
+    decompressor.start();
+    decompressor(data, [&result](telnetpp::bytes decompressed, bool) {
+        result.insert(result.end(), decompressed.begin(), decompressed.end());
+    });
+
+    return result;
+}
+
+}  // namespace
+
+TEST(a_compression_stream_pool, is_initially_empty)
+{
+    zlib::compression_stream_pool const pool{2, zlib::low_memory_compression};
+
+    ASSERT_EQ(2U, pool.capacity());
+    ASSERT_EQ(0U, pool.size());
+    ASSERT_EQ(0U, pool.hits());
+    ASSERT_EQ(0U, pool.misses());
+
+    auto const &parameters = pool.parameters();
+    ASSERT_EQ(zlib::low_memory_compression.window_bits, parameters.window_bits);
+    ASSERT_EQ(
+        zlib::low_memory_compression.memory_level, parameters.memory_level);
+}
+
+TEST(a_compression_stream_pool, rejects_parameters_out_of_range)
+{
+    EXPECT_THROW(
+        zlib::compression_stream_pool(1, {.window_bits = 16}),
+        std::invalid_argument);
+}
+
+TEST(a_compression_stream_pool, gives_its_parameters_to_compressors)
+{
+    zlib::compression_stream_pool pool{1, zlib::high_ratio_compression};
+    zlib::compressor compressor{pool};
+
+    ASSERT_EQ(
+        zlib::high_ratio_compression.level, compressor.parameters().level);
+}
+
+TEST(a_compression_stream_pool, reuses_streams_returned_by_compressors)
+{
+    zlib::compression_stream_pool pool{1};
+    zlib::compressor compressor{pool};
+    zlib::decompressor decompressor;
+
+    auto const data = "datadatadatadatadata"_tb;
+
+    auto const first_stream = compress_stream(compressor, data);
+    ASSERT_EQ(0U, pool.hits());
+    ASSERT_EQ(1U, pool.misses());
+    ASSERT_EQ(1U, pool.size());
+    ASSERT_EQ(0U, compressor.memory_usage());
+
+    auto const second_stream = compress_stream(compressor, data);
+    ASSERT_EQ(1U, pool.hits());
+    ASSERT_EQ(1U, pool.misses());
+    ASSERT_EQ(1U, pool.size());
+
+    // A reused stream must behave exactly as a new one would.
+    ASSERT_EQ(first_stream, second_stream);
+
+    auto const expected = std::vector<telnetpp::byte>{data.begin(), data.end()};
+    ASSERT_EQ(expected, decompress_stream(decompressor, second_stream));
+}
+
+TEST(a_compression_stream_pool, holds_no_more_than_its_capacity)
+{
+    zlib::compression_stream_pool pool{1};
+
+    {
+        zlib::compressor first{pool};
+        zlib::compressor second{pool};
+
+        first.start();
+        first("data"_tb, [](telnetpp::bytes, bool) {});
+        second.start();
+        second("data"_tb, [](telnetpp::bytes, bool) {});
+
+        ASSERT_EQ(2U, pool.misses());
+        ASSERT_EQ(0U, pool.size());
+    }
+
+    ASSERT_EQ(1U, pool.size());
+}
+
+TEST(a_decompression_stream_pool, reuses_streams_returned_by_decompressors)
+{
+    zlib::decompression_stream_pool pool{4};
+    zlib::decompressor decompressor{pool};
+    zlib::compressor compressor;
+
+    auto const data = "datadatadatadatadata"_tb;
+    auto const expected = std::vector<telnetpp::byte>{data.begin(), data.end()};
+    auto const compressed = compress_stream(compressor, data);
+
+    ASSERT_EQ(expected, decompress_stream(decompressor, compressed));
+    ASSERT_EQ(0U, pool.hits());
+    ASSERT_EQ(1U, pool.misses());
+    ASSERT_EQ(1U, pool.size());
+
+    ASSERT_EQ(expected, decompress_stream(decompressor, compressed));
+    ASSERT_EQ(1U, pool.hits());
+    ASSERT_EQ(1U, pool.misses());
+    ASSERT_EQ(1U, pool.size());
+}
+
+TEST(
+    a_decompression_stream_pool,
+    reuses_streams_that_were_returned_part_way_through)
+{
+    zlib::decompression_stream_pool pool{1};
+    zlib::compressor compressor;
+
+    auto const data = "datadatadatadatadata"_tb;
+    auto const expected = std::vector<telnetpp::byte>{data.begin(), data.end()};
+    auto const compressed = compress_stream(compressor, data);
+
+    {
+        // Only the start of the stream is received before the decompressor
+        // is destroyed.
+        zlib::decompressor decompressor{pool};
+        decompress_stream(
+            decompressor, telnetpp::bytes{compressed}.first(4));
+    }
+
+    ASSERT_EQ(1U, pool.size());
+
+    zlib::decompressor decompressor{pool};
+    ASSERT_EQ(expected, decompress_stream(decompressor, compressed));
+    ASSERT_EQ(1U, pool.hits());
+}
@@ -0,0 +1,16 @@
+#include "mccp_codec_conformance.hpp"
+
+#include <telnetpp/options/mccp/zstd/compressor.hpp>
+#include <telnetpp/options/mccp/zstd/decompressor.hpp>
+
+namespace {
+
+struct zstd_backend
+{
+    using compressor = telnetpp::options::mccp::zstd::compressor;
+    using decompressor = telnetpp::options::mccp::zstd::decompressor;
+};
+
+}  // namespace
+
+INSTANTIATE_TYPED_TEST_SUITE_P(zstd, an_mccp_backend, zstd_backend);
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <telnetpp/options/mccp/zstd/compressor.hpp>
+#include <telnetpp/options/mccp/zstd/decompressor.hpp>
+#include <zstd.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace zstd = telnetpp::options::mccp::zstd;
+
+TEST(a_zstd_compressor, uses_the_default_level)
+{
+    zstd::compressor const compressor;
+
+    ASSERT_EQ(ZSTD_CLEVEL_DEFAULT, compressor.level());
+}
+
+TEST(a_zstd_compressor, rejects_levels_out_of_range)
+{
+    ASSERT_THROW(zstd::compressor{ZSTD_maxCLevel() + 1}, std::invalid_argument);
+    ASSERT_THROW(zstd::compressor{ZSTD_minCLevel() - 1}, std::invalid_argument);
+}
+
+TEST(a_zstd_compressor, produces_a_frame_that_zstd_decompresses)
+{
+    zstd::compressor compressor{1};
+    std::vector<telnetpp::byte> compressed;
+    auto const append = [&compressed](telnetpp::bytes data, bool) {
+        compressed.insert(compressed.end(), data.begin(), data.end());
+    };
+
+    compressor.start();
+    compressor("framed data"_tb, append);
+    compressor.finish(append);
+
+    std::vector<telnetpp::byte> decompressed(64);
+    auto const size = ZSTD_decompress(
+        decompressed.data(),
+        decompressed.size(),
+        compressed.data(),
+        compressed.size());
+    ASSERT_FALSE(ZSTD_isError(size));
+    decompressed.resize(size);
+
+    auto const expected = "framed data"_tb;
+    ASSERT_EQ(
+        (std::vector<telnetpp::byte>{expected.begin(), expected.end()}),
+        decompressed);
+}
+
+TEST(a_zstd_decompressor, decompresses_a_frame_from_zstd)
+{
+    auto const data = "compressed elsewhere"_tb;
+    std::vector<telnetpp::byte> compressed(ZSTD_compressBound(data.size()));
+    auto const size = ZSTD_compress(
+        compressed.data(), compressed.size(), data.data(), data.size(), 1);
+    ASSERT_FALSE(ZSTD_isError(size));
+    compressed.resize(size);
+
+    zstd::decompressor decompressor;
+    std::vector<telnetpp::byte> decompressed;
+    bool ended = false;
+
+    decompressor.start();
+    decompressor(compressed, [&](telnetpp::bytes output, bool stream_ended) {
+        decompressed.insert(decompressed.end(), output.begin(), output.end());
+        ended = stream_ended;
+    });
+
+    ASSERT_EQ(
+        (std::vector<telnetpp::byte>{data.begin(), data.end()}), decompressed);
+    ASSERT_TRUE(ended);
+}
+
+namespace {
+
+// A memory resource that counts the allocations made from it.
+class counting_resource final : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations{0};
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(
+        void *block, std::size_t bytes, std::size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(block, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(
+        std::pmr::memory_resource const &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+}  // namespace
+
+TEST(a_zstd_codec, allocates_its_output_buffer_from_the_given_resource)
+{
+    counting_resource compressor_resource;
+    counting_resource decompressor_resource;
+    zstd::compressor compressor{zstd::compressor::default_level,
+                                &compressor_resource};
+    zstd::decompressor decompressor{&decompressor_resource};
+
+    auto const data = "resourceful"_tb;
+    std::vector<telnetpp::byte> compressed;
+    compressor.start();
+    compressor(data, [&](telnetpp::bytes output, bool) {
+        compressed.insert(compressed.end(), output.begin(), output.end());
+    });
+
+    std::vector<telnetpp::byte> decompressed;
+    decompressor.start();
+    decompressor(compressed, [&](telnetpp::bytes output, bool) {
+        decompressed.insert(decompressed.end(), output.begin(), output.end());
+    });
+
+    ASSERT_EQ(
+        (std::vector<telnetpp::byte>{data.begin(), data.end()}), decompressed);
+    ASSERT_NE(0U, compressor_resource.allocations);
+    ASSERT_NE(0U, decompressor_resource.allocations);
+}
@@ -424,3 +424,62 @@ TEST_F(
     ASSERT_EQ(size_t{1}, received_variables_.size());
     ASSERT_EQ(expected, received_variables_[0]);
 }
+
+TEST_F(an_activated_msdp_client, receiving_a_variable_reports_a_view_of_it)
+{
+    auto const subnegotiation_content =
+        "\x01"
+        "var"
+        "\x02"
+        "val"_tb;
+
+    std::vector<telnetpp::options::msdp::variable> viewed_variables;
+    option_.on_receive_view.connect(
+        [&](telnetpp::options::msdp::variable_view const &view) {
+            viewed_variables.push_back(
+                telnetpp::options::msdp::to_variable(view));
+        });
+
+    option_.subnegotiate(subnegotiation_content);
+
+    auto const expected = telnetpp::options::msdp::variable{"var"_tb, "val"_tb};
+
+    ASSERT_EQ(std::vector{expected}, viewed_variables);
+    ASSERT_EQ(std::vector{expected}, received_variables_);
+}
+
+TEST_F(an_activated_msdp_client, send_doubles_iac_bytes_in_the_variable)
+{
+    option_.send(telnetpp::options::msdp::variable{"v\xFF"_tb, "\xFF"_tb});
+
+    auto const expected =
+        "\xFF\xFA\x45"
+        "\x01"
+        "v\xFF\xFF"
+        "\x02"
+        "\xFF\xFF"
+        "\xFF\xF0"_tb;
+
+    ASSERT_EQ(expected, channel_.written_);
+}
+
+TEST_F(an_activated_msdp_client, reports_a_message_larger_than_the_limit_once)
+{
+    int oversized_messages = 0;
+    option_.on_oversized_message.connect([&] { ++oversized_messages; });
+
+    session_.install(option_);
+    session_.set_subnegotiation_limit(
+        4, telnetpp::subnegotiation_overflow_policy::error);
+
+    static auto const content =
+        "\xFF\xFA\x45"
+        "\x01var\x02val"
+        "\xFF\xF0"_tb;
+
+    session_.async_read([](telnetpp::bytes) {});
+    channel_.receive(content);
+
+    ASSERT_EQ(1, oversized_messages);
+    ASSERT_TRUE(received_variables_.empty());
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <telnetpp/options/msdp/detail/decoder.hpp>
+#include <telnetpp/options/msdp/detail/encoder.hpp>
+#include <telnetpp/options/msdp/detail/protocol.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace msdp = telnetpp::options::msdp;
+
+namespace {
+
+// Records each event as a line of text, so that a test can compare the
+// whole sequence at once.
+class event_recorder : public msdp::detail::decode_handler
+{
+public:
+    void on_var_name(telnetpp::bytes name) override
+    {
+        events_.push_back("name " + to_string(name));
+    }
+
+    void on_string_value(telnetpp::bytes value) override
+    {
+        events_.push_back("string " + to_string(value));
+    }
+
+    void on_array_begin() override
+    {
+        events_.emplace_back("array begin");
+    }
+
+    void on_array_element(telnetpp::bytes element) override
+    {
+        events_.push_back("element " + to_string(element));
+    }
+
+    void on_array_end() override
+    {
+        events_.emplace_back("array end");
+    }
+
+    void on_table_begin() override
+    {
+        events_.emplace_back("table begin");
+    }
+
+    void on_table_end() override
+    {
+        events_.emplace_back("table end");
+    }
+
+    void on_var_end() override
+    {
+        events_.emplace_back("end");
+    }
+
+    std::vector<std::string> events_;
+
+private:
+    static std::string to_string(telnetpp::bytes data)
+    {
+        return {data.begin(), data.end()};
+    }
+};
+
+telnetpp::byte_storage encode(msdp::variable const &var)
+{
+    telnetpp::byte_storage result;
+    msdp::detail::encode_variable(var, result);
+    return result;
+}
+
+std::vector<std::string> events_of(telnetpp::bytes data)
+{
+    event_recorder recorder;
+    msdp::detail::decode(data, recorder);
+    return recorder.events_;
+}
+
+}  // namespace
+
+TEST(an_msdp_event_decoder, passes_on_a_string_variable)
+{
+    std::vector<std::string> const expected = {
+        "name HEALTH", "string 100", "end"};
+
+    ASSERT_EQ(expected, events_of(encode({"HEALTH"_tb, "100"_tb})));
+}
+
+TEST(an_msdp_event_decoder, passes_on_an_array_variable)
+{
+    msdp::variable const var{"LIST"_tb, msdp::array_value{"a"_tb, "bc"_tb}};
+
+    std::vector<std::string> const expected = {
+        "name LIST",
+        "array begin",
+        "element a",
+        "element bc",
+        "array end",
+        "end"};
+
+    ASSERT_EQ(expected, events_of(encode(var)));
+}
+
+TEST(an_msdp_event_decoder, passes_on_a_nested_table_variable)
+{
+    msdp::variable const var{
+        "ROOM"_tb,
+        msdp::table_value{
+            {"EXITS"_tb,
+             msdp::table_value{{"n"_tb, "1"_tb}, {"s"_tb, "2"_tb}}}}};
+
+    // As with the tree decoder, a table close that follows a string ends
+    // only that string's variable.  So the inner table is ended by the
+    // second close, and the outer one by the end of the data.
+    std::vector<std::string> const expected = {
+        "name ROOM",
+        "table begin",
+        "name EXITS",
+        "table begin",
+        "name n",
+        "string 1",
+        "end",
+        "name s",
+        "string 2",
+        "end",
+        "table end",
+        "end",
+        "table end",
+        "end"};
+
+    ASSERT_EQ(expected, events_of(encode(var)));
+}
+
+TEST(an_msdp_event_decoder, passes_on_several_variables)
+{
+    auto data = encode({"a"_tb, "1"_tb});
+    data += encode({"b"_tb, msdp::array_value{"2"_tb}});
+
+    std::vector<std::string> const expected = {
+        "name a",
+        "string 1",
+        "end",
+        "name b",
+        "array begin",
+        "element 2",
+        "array end",
+        "end"};
+
+    ASSERT_EQ(expected, events_of(data));
+}
+
+TEST(an_msdp_event_decoder, ends_everything_that_is_open_when_the_data_ends)
+{
+    auto const data =
+        "\x01ROOM\x02\x03\x01LIST\x02\x05\x02"
+        "a"_tb;
+
+    std::vector<std::string> const expected = {
+        "name ROOM",
+        "table begin",
+        "name LIST",
+        "array begin",
+        "element a",
+        "array end",
+        "end",
+        "table end",
+        "end"};
+
+    ASSERT_EQ(expected, events_of(data));
+}
+
+TEST(an_msdp_event_decoder, ends_a_variable_whose_value_never_arrived)
+{
+    std::vector<std::string> const expected = {"name HEALTH", "end"};
+
+    ASSERT_EQ(expected, events_of("\x01HEALTH"_tb));
+}
+
+TEST(an_msdp_event_decoder, ignores_a_stray_table_close)
+{
+    auto data = telnetpp::byte_storage{msdp::detail::table_close};
+    data += encode({"a"_tb, "1"_tb});
+
+    std::vector<std::string> const expected = {"name a", "string 1", "end"};
+
+    ASSERT_EQ(expected, events_of(data));
+}
+
+TEST(an_msdp_event_decoder, passes_on_views_of_the_data)
+{
+    struct value_finder : msdp::detail::decode_handler
+    {
+        void on_string_value(telnetpp::bytes value) override
+        {
+            value_ = value;
+        }
+
+        telnetpp::bytes value_;
+    };
+
+    auto const data = encode({"HEALTH"_tb, "100"_tb});
+    value_finder finder;
+    msdp::detail::decode(data, finder);
+
+    ASSERT_EQ(data.data() + data.size() - 3, finder.value_.data());
+    ASSERT_EQ(3U, finder.value_.size());
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <telnetpp/generator.hpp>
+#include <telnetpp/options/msdp/detail/encoder.hpp>
+#include <telnetpp/options/msdp/detail/protocol.hpp>
+
+#include <vector>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace msdp = telnetpp::options::msdp;
+
+namespace {
+
+// Encodes a variable as a subnegotiation in the way that the session would
+// if it were written as a telnetpp::subnegotiation.
+telnetpp::byte_storage generate_subnegotiation(msdp::variable const &var)
+{
+    telnetpp::byte_storage content;
+    msdp::detail::encode_variable(var, content);
+
+    telnetpp::byte_storage result;
+    telnetpp::generate(
+        telnetpp::subnegotiation{msdp::detail::option, content},
+        [&result](telnetpp::bytes data) {
+            result.append(data.begin(), data.end());
+        });
+    return result;
+}
+
+telnetpp::byte_storage encode_subnegotiation(msdp::variable const &var)
+{
+    telnetpp::byte_storage result(msdp::detail::subnegotiation_size(var), 0);
+    auto const written = msdp::detail::encode_subnegotiation(var, result);
+
+    EXPECT_EQ(result.data(), written.data());
+    EXPECT_EQ(result.size(), written.size());
+    return result;
+}
+
+std::vector<msdp::variable> const variables = {
+    msdp::variable{},
+    msdp::variable{"name"_tb, "value"_tb},
+    msdp::variable{"\xFF"_tb, "\xFF\xFF"_tb},
+    msdp::variable{"hp"_tb, "\x01\xFF\x02\xFF"_tb},
+    msdp::variable{"list"_tb, msdp::array_value{}},
+    msdp::variable{"list"_tb, msdp::array_value{"a"_tb, "\xFF"_tb, ""_tb}},
+    msdp::variable{"tbl"_tb, msdp::table_value{}},
+    msdp::variable{
+        "room"_tb,
+        msdp::table_value{
+            {"name"_tb, "The \xFF Square"_tb},
+            {"tags"_tb, msdp::array_value{"outdoor"_tb, "\xFF"_tb}},
+            {"exits"_tb,
+             msdp::table_value{{"n"_tb, "1"_tb}, {"\xFF"_tb, "2"_tb}}}}},
+};
+
+}  // namespace
+
+TEST(an_msdp_encoder, knows_the_size_of_an_encoded_variable)
+{
+    for (auto const &var : variables)
+    {
+        telnetpp::byte_storage storage;
+        msdp::detail::encode_variable(var, storage);
+
+        ASSERT_EQ(storage.size(), msdp::detail::encoded_size(var)) << var;
+    }
+}
+
+TEST(an_msdp_encoder, appends_to_existing_storage)
+{
+    telnetpp::byte_storage storage = "prefix"_tb;
+    msdp::detail::encode_variable({"a"_tb, "b"_tb}, storage);
+
+    auto const expected =
+        "prefix"
+        "\x01"
+        "a"
+        "\x02"
+        "b"_tb;
+
+    ASSERT_EQ(expected, storage);
+}
+
+TEST(an_msdp_encoder, encodes_subnegotiations_as_the_generator_does)
+{
+    for (auto const &var : variables)
+    {
+        ASSERT_EQ(generate_subnegotiation(var), encode_subnegotiation(var))
+            << var;
+    }
+}
+
+TEST(an_msdp_encoder, doubles_iac_bytes_in_an_encoded_subnegotiation)
+{
+    auto const expected =
+        "\xFF\xFA\x45"
+        "\x01"
+        "a\xFF\xFF"
+        "\x02"
+        "\xFF\xFF\xFF\xFF"
+        "\xFF\xF0"_tb;
+
+    ASSERT_EQ(
+        expected,
+        encode_subnegotiation(msdp::variable{"a\xFF"_tb, "\xFF\xFF"_tb}));
+}
+
+TEST(an_msdp_encoder, writes_only_the_subnegotiation_into_a_larger_buffer)
+{
+    msdp::variable const var{"a"_tb, "b"_tb};
+    std::vector<telnetpp::byte> buffer(64, 0);
+
+    auto const written = msdp::detail::encode_subnegotiation(var, buffer);
+
+    ASSERT_EQ(msdp::detail::subnegotiation_size(var), written.size());
+    ASSERT_EQ(buffer.data(), written.data());
+}
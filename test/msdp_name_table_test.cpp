@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <telnetpp/options/msdp/detail/encoder.hpp>
+#include <telnetpp/options/msdp/detail/view_decoder.hpp>
+#include <telnetpp/options/msdp/name_table.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace msdp = telnetpp::options::msdp;
+
+namespace {
+
+// The variables of the MSDP specification, and a few more.
+constexpr auto names = msdp::make_name_table(
+    "ACCOUNT_NAME",
+    "CHARACTER_NAME",
+    "SERVER_ID",
+    "SERVER_TIME",
+    "SNIPPET_VERSION",
+    "AFFECTS",
+    "ALIGNMENT",
+    "EXPERIENCE",
+    "EXPERIENCE_MAX",
+    "EXPERIENCE_TNL",
+    "HEALTH",
+    "HEALTH_MAX",
+    "LEVEL",
+    "RACE",
+    "CLASS",
+    "MANA",
+    "MANA_MAX",
+    "WIMPY",
+    "PRACTICE",
+    "MONEY",
+    "MOVEMENT",
+    "MOVEMENT_MAX",
+    "HITROLL",
+    "DAMROLL",
+    "AC",
+    "STR",
+    "INT",
+    "WIS",
+    "DEX",
+    "CON",
+    "STR_PERM",
+    "INT_PERM",
+    "WIS_PERM",
+    "DEX_PERM",
+    "CON_PERM",
+    "OPPONENT_HEALTH",
+    "OPPONENT_HEALTH_MAX",
+    "OPPONENT_LEVEL",
+    "OPPONENT_NAME",
+    "AREA_NAME",
+    "ROOM_EXITS",
+    "ROOM_NAME",
+    "ROOM_VNUM",
+    "WORLD_TIME",
+    "ROOM");
+
+// Names can be used as case labels.
+static_assert(names.id_of("ACCOUNT_NAME") == 0);
+static_assert(names.id_of("HEALTH") == 10);
+static_assert(names.id_of("ROOM") == 44);
+
+constexpr auto no_names = msdp::make_name_table();
+
+telnetpp::byte_storage to_bytes(std::string_view text)
+{
+    return {text.begin(), text.end()};
+}
+
+}  // namespace
+
+TEST(a_name_table, finds_each_of_its_names_by_position)
+{
+    msdp::name_table const table = names;
+    auto const all_names = table.names();
+
+    ASSERT_EQ(std::size_t{45}, all_names.size());
+
+    for (std::size_t index = 0; index < all_names.size(); ++index)
+    {
+        ASSERT_EQ(index, table.find(to_bytes(all_names[index])))
+            << all_names[index];
+    }
+}
+
+TEST(a_name_table, does_not_find_other_names)
+{
+    msdp::name_table const table = names;
+
+    ASSERT_EQ(msdp::unknown_name, table.find(""_tb));
+    ASSERT_EQ(msdp::unknown_name, table.find("HEALTH_MIN"_tb));
+    ASSERT_EQ(msdp::unknown_name, table.find("health"_tb));
+    ASSERT_EQ(msdp::unknown_name, table.find("HEALT"_tb));
+
+    for (int index = 0; index < 1000; ++index)
+    {
+        ASSERT_EQ(
+            msdp::unknown_name,
+            table.find(to_bytes("VAR" + std::to_string(index))));
+    }
+}
+
+TEST(a_name_table, rejects_a_name_that_is_not_in_it)
+{
+    ASSERT_THROW((void)names.id_of("GOLD"), std::invalid_argument);
+}
+
+TEST(a_name_table, rejects_a_name_that_appears_twice)
+{
+    ASSERT_THROW(
+        msdp::make_name_table("HEALTH", "MANA", "HEALTH"),
+        std::invalid_argument);
+}
+
+TEST(an_empty_name_table, finds_nothing)
+{
+    ASSERT_EQ(msdp::unknown_name, msdp::name_table{}.find("HEALTH"_tb));
+    ASSERT_EQ(
+        msdp::unknown_name, msdp::name_table{no_names}.find("HEALTH"_tb));
+}
+
+TEST(a_name_table, can_be_made_at_run_time)
+{
+    std::vector<std::string> const strings = {"b", "a", "c"};
+    auto const table =
+        msdp::make_name_table(strings[0], strings[1], strings[2]);
+
+    ASSERT_EQ(1, table.id_of("a"));
+    ASSERT_EQ(2, table.table().find("c"_tb));
+}
+
+TEST(an_msdp_view_decoder_with_a_name_table, identifies_the_names_it_decodes)
+{
+    msdp::variable const var{
+        "ROOM"_tb,
+        msdp::table_value{
+            {"ROOM_NAME"_tb, "The Square"_tb},
+            {"UNKNOWN"_tb, "1"_tb},
+            {"ROOM_EXITS"_tb, msdp::table_value{{"n"_tb, "1"_tb}}}}};
+
+    telnetpp::byte_storage data;
+    msdp::detail::encode_variable(var, data);
+
+    msdp::detail::view_decoder decoder;
+    decoder.set_name_table(names);
+
+    std::vector<msdp::name_id> ids;
+
+    decoder(data, [&ids](msdp::variable_view const &view) {
+        ids.push_back(view.id_);
+
+        auto const table = std::get<msdp::table_value_view>(view.value_);
+
+        for (auto const &child : table)
+        {
+            ids.push_back(child.id_);
+        }
+    });
+
+    std::vector<msdp::name_id> const expected = {
+        names.id_of("ROOM"),
+        names.id_of("ROOM_NAME"),
+        msdp::unknown_name,
+        names.id_of("ROOM_EXITS")};
+
+    ASSERT_EQ(expected, ids);
+}
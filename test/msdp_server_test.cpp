@@ -1,6 +1,8 @@
 #include "telnet_option_fixture.hpp"
 
 #include <gtest/gtest.h>
+#include <telnetpp/options/msdp/detail/decoder.hpp>
+#include <telnetpp/options/msdp/detail/encoder.hpp>
 #include <telnetpp/options/msdp/server.hpp>
 
 #include <vector>
@@ -427,3 +429,370 @@ TEST_F(
     ASSERT_EQ(size_t{1}, received_variables_.size());
     ASSERT_EQ(expected, received_variables_[0]);
 }
+
+TEST_F(an_activated_msdp_server, receiving_a_variable_reports_a_view_of_it)
+{
+    auto const subnegotiation_content =
+        "\x01"
+        "var"
+        "\x02"
+        "val"_tb;
+
+    std::vector<telnetpp::options::msdp::variable> viewed_variables;
+    option_.on_receive_view.connect(
+        [&](telnetpp::options::msdp::variable_view const &view) {
+            viewed_variables.push_back(
+                telnetpp::options::msdp::to_variable(view));
+        });
+
+    option_.subnegotiate(subnegotiation_content);
+
+    auto const expected = telnetpp::options::msdp::variable{"var"_tb, "val"_tb};
+
+    ASSERT_EQ(std::vector{expected}, viewed_variables);
+    ASSERT_EQ(std::vector{expected}, received_variables_);
+}
+
+TEST_F(an_activated_msdp_server, send_doubles_iac_bytes_in_the_variable)
+{
+    option_.send(telnetpp::options::msdp::variable{"v\xFF"_tb, "\xFF"_tb});
+
+    auto const expected =
+        "\xFF\xFA\x45"
+        "\x01"
+        "v\xFF\xFF"
+        "\x02"
+        "\xFF\xFF"
+        "\xFF\xF0"_tb;
+
+    ASSERT_EQ(expected, channel_.written_);
+}
+
+TEST_F(an_activated_msdp_server, identifies_received_names_from_its_table)
+{
+    static constexpr auto names =
+        telnetpp::options::msdp::make_name_table("HEALTH", "MANA");
+    option_.set_name_table(names);
+
+    std::vector<telnetpp::options::msdp::name_id> ids;
+    option_.on_receive_view.connect(
+        [&ids](telnetpp::options::msdp::variable_view const &view) {
+            ids.push_back(view.id_);
+        });
+
+    option_.subnegotiate(
+        "\x01"
+        "MANA"
+        "\x02"
+        "10"
+        "\x01"
+        "GOLD"
+        "\x02"
+        "20"_tb);
+
+    std::vector<telnetpp::options::msdp::name_id> const expected = {
+        names.id_of("MANA"), telnetpp::options::msdp::unknown_name};
+
+    ASSERT_EQ(expected, ids);
+}
+
+namespace {
+
+namespace msdp = telnetpp::options::msdp;
+
+class an_msdp_server_with_variables : public an_activated_msdp_server
+{
+protected:
+    using subnegotiations = std::vector<std::vector<msdp::variable>>;
+
+    an_msdp_server_with_variables()
+    {
+        option_.set_variable({"HEALTH"_tb, "100"_tb});
+        option_.set_variable({"MANA"_tb, "50"_tb});
+        option_.set_variable({"ROOM"_tb, "The Square"_tb});
+    }
+
+    void receive(msdp::variable const &var)
+    {
+        telnetpp::byte_storage content;
+        msdp::detail::encode_variable(var, content);
+        option_.subnegotiate(content);
+    }
+
+    // Returns the variables in each subnegotiation that has been written,
+    // and clears the written data.
+    subnegotiations take_subnegotiations()
+    {
+        subnegotiations result;
+        telnetpp::bytes written = channel_.written_;
+
+        while (written.size() >= 5)
+        {
+            // IAC SB MSDP <content> IAC SE.  None of the variables used
+            // here contain an IAC, so the content ends at the first one.
+            auto const end = std::ranges::find(
+                written.subspan(3), telnetpp::iac);
+            auto const content = telnetpp::bytes{written.begin() + 3, end};
+
+            auto &vars = result.emplace_back();
+            msdp::detail::decode(content, [&vars](msdp::variable const &var) {
+                vars.push_back(var);
+            });
+
+            written = telnetpp::bytes{end + 2, written.end()};
+        }
+
+        channel_.written_.clear();
+        return result;
+    }
+};
+
+}  // namespace
+
+TEST_F(an_activated_msdp_server, does_not_answer_commands_without_variables)
+{
+    option_.subnegotiate(
+        "\x01"
+        "REPORT"
+        "\x02"
+        "HEALTH"_tb);
+
+    ASSERT_TRUE(channel_.written_.empty());
+    ASSERT_EQ(size_t{1}, received_variables_.size());
+}
+
+TEST_F(an_msdp_server_with_variables, still_reports_commands_as_received)
+{
+    receive({"REPORT"_tb, "HEALTH"_tb});
+
+    auto const expected = msdp::variable{"REPORT"_tb, "HEALTH"_tb};
+
+    ASSERT_EQ(std::vector{expected}, received_variables_);
+}
+
+TEST_F(an_msdp_server_with_variables, lists_its_commands)
+{
+    receive({"LIST"_tb, "COMMANDS"_tb});
+
+    auto const expected = msdp::variable{
+        "COMMANDS"_tb,
+        msdp::array_value{
+            "LIST"_tb, "REPORT"_tb, "RESET"_tb, "SEND"_tb, "UNREPORT"_tb}};
+
+    ASSERT_EQ(subnegotiations{{expected}}, take_subnegotiations());
+}
+
+TEST_F(an_msdp_server_with_variables, lists_its_lists)
+{
+    receive({"LIST"_tb, "LISTS"_tb});
+
+    auto const expected = msdp::variable{
+        "LISTS"_tb,
+        msdp::array_value{
+            "COMMANDS"_tb,
+            "LISTS"_tb,
+            "REPORTABLE_VARIABLES"_tb,
+            "REPORTED_VARIABLES"_tb,
+            "SENDABLE_VARIABLES"_tb}};
+
+    ASSERT_EQ(subnegotiations{{expected}}, take_subnegotiations());
+}
+
+TEST_F(an_msdp_server_with_variables, lists_its_reportable_variables)
+{
+    receive({"LIST"_tb, "REPORTABLE_VARIABLES"_tb});
+
+    auto const expected = msdp::variable{
+        "REPORTABLE_VARIABLES"_tb,
+        msdp::array_value{"HEALTH"_tb, "MANA"_tb, "ROOM"_tb}};
+
+    ASSERT_EQ(subnegotiations{{expected}}, take_subnegotiations());
+}
+
+TEST_F(an_msdp_server_with_variables, lists_its_reported_variables)
+{
+    receive({"REPORT"_tb, "MANA"_tb});
+    take_subnegotiations();
+
+    receive({"LIST"_tb, "REPORTED_VARIABLES"_tb});
+
+    auto const expected = msdp::variable{
+        "REPORTED_VARIABLES"_tb, msdp::array_value{"MANA"_tb}};
+
+    ASSERT_EQ(subnegotiations{{expected}}, take_subnegotiations());
+}
+
+TEST_F(an_msdp_server_with_variables, ignores_a_request_for_an_unknown_list)
+{
+    receive({"LIST"_tb, "CONFIGURABLE_VARIABLES"_tb});
+
+    ASSERT_TRUE(channel_.written_.empty());
+}
+
+TEST_F(an_msdp_server_with_variables, sends_a_variable_when_it_is_reported)
+{
+    receive({"REPORT"_tb, "HEALTH"_tb});
+
+    ASSERT_TRUE(option_.is_reported("HEALTH"_tb));
+    ASSERT_FALSE(option_.is_reported("MANA"_tb));
+
+    auto const expected = subnegotiations{{{"HEALTH"_tb, "100"_tb}}};
+
+    ASSERT_EQ(expected, take_subnegotiations());
+}
+
+TEST_F(an_msdp_server_with_variables, sends_reported_variables_together)
+{
+    receive({"REPORT"_tb, msdp::array_value{"HEALTH"_tb, "MANA"_tb}});
+
+    auto const expected = subnegotiations{
+        {{"HEALTH"_tb, "100"_tb}, {"MANA"_tb, "50"_tb}}};
+
+    ASSERT_EQ(expected, take_subnegotiations());
+}
+
+TEST_F(an_msdp_server_with_variables, ignores_a_report_of_an_unknown_variable)
+{
+    receive({"REPORT"_tb, "GOLD"_tb});
+
+    ASSERT_FALSE(option_.is_reported("GOLD"_tb));
+    ASSERT_TRUE(channel_.written_.empty());
+}
+
+TEST_F(an_msdp_server_with_variables, sends_nothing_when_nothing_has_changed)
+{
+    receive({"REPORT"_tb, "HEALTH"_tb});
+    take_subnegotiations();
+
+    option_.set_variable({"HEALTH"_tb, "100"_tb});
+    option_.flush_updates();
+
+    ASSERT_TRUE(channel_.written_.empty());
+}
+
+TEST_F(
+    an_msdp_server_with_variables,
+    sends_only_changed_reported_variables_in_one_subnegotiation)
+{
+    receive({"REPORT"_tb, msdp::array_value{"HEALTH"_tb, "MANA"_tb}});
+    take_subnegotiations();
+
+    option_.set_variable({"HEALTH"_tb, "90"_tb});
+    option_.set_variable({"HEALTH"_tb, "80"_tb});
+    option_.set_variable({"ROOM"_tb, "The Forest"_tb});
+    option_.set_variable(
+        {"MANA"_tb, msdp::array_value{"40"_tb, "100"_tb}});
+
+    ASSERT_TRUE(channel_.written_.empty());
+
+    option_.flush_updates();
+
+    auto const expected = subnegotiations{
+        {{"HEALTH"_tb, "80"_tb},
+         {"MANA"_tb, msdp::array_value{"40"_tb, "100"_tb}}}};
+
+    ASSERT_EQ(expected, take_subnegotiations());
+
+    option_.flush_updates();
+    ASSERT_TRUE(channel_.written_.empty());
+}
+
+TEST_F(an_msdp_server_with_variables, sends_a_variable_once_on_request)
+{
+    receive({"SEND"_tb, "ROOM"_tb});
+
+    ASSERT_FALSE(option_.is_reported("ROOM"_tb));
+
+    auto const expected = subnegotiations{{{"ROOM"_tb, "The Square"_tb}}};
+
+    ASSERT_EQ(expected, take_subnegotiations());
+
+    option_.set_variable({"ROOM"_tb, "The Forest"_tb});
+    option_.flush_updates();
+
+    ASSERT_TRUE(channel_.written_.empty());
+}
+
+TEST_F(an_msdp_server_with_variables, stops_reporting_an_unreported_variable)
+{
+    receive({"REPORT"_tb, msdp::array_value{"HEALTH"_tb, "MANA"_tb}});
+    option_.set_variable({"HEALTH"_tb, "90"_tb});
+    receive({"UNREPORT"_tb, "HEALTH"_tb});
+    take_subnegotiations();
+
+    option_.set_variable({"MANA"_tb, "40"_tb});
+    option_.flush_updates();
+
+    ASSERT_FALSE(option_.is_reported("HEALTH"_tb));
+
+    auto const expected = subnegotiations{{{"MANA"_tb, "40"_tb}}};
+
+    ASSERT_EQ(expected, take_subnegotiations());
+}
+
+TEST_F(an_msdp_server_with_variables, stops_reporting_everything_on_reset)
+{
+    receive({"REPORT"_tb, msdp::array_value{"HEALTH"_tb, "MANA"_tb}});
+    receive({"RESET"_tb, "REPORTED_VARIABLES"_tb});
+    take_subnegotiations();
+
+    option_.set_variable({"HEALTH"_tb, "90"_tb});
+    option_.flush_updates();
+
+    ASSERT_FALSE(option_.is_reported("HEALTH"_tb));
+    ASSERT_FALSE(option_.is_reported("MANA"_tb));
+    ASSERT_TRUE(channel_.written_.empty());
+}
+
+TEST_F(an_msdp_server_with_variables, stops_reporting_when_deactivated)
+{
+    receive({"REPORT"_tb, "HEALTH"_tb});
+    option_.set_variable({"HEALTH"_tb, "90"_tb});
+    option_.negotiate(telnetpp::dont);
+    channel_.written_.clear();
+
+    option_.flush_updates();
+
+    ASSERT_FALSE(option_.is_reported("HEALTH"_tb));
+    ASSERT_TRUE(channel_.written_.empty());
+}
+
+TEST_F(an_msdp_server_with_variables, does_not_report_a_deleted_variable)
+{
+    receive({"REPORT"_tb, msdp::array_value{"HEALTH"_tb, "MANA"_tb}});
+    take_subnegotiations();
+
+    option_.set_variable({"HEALTH"_tb, "90"_tb});
+    option_.set_variable({"MANA"_tb, "40"_tb});
+    option_.delete_variable("HEALTH"_tb);
+    option_.flush_updates();
+
+    ASSERT_FALSE(option_.is_reported("HEALTH"_tb));
+
+    auto const expected = subnegotiations{{{"MANA"_tb, "40"_tb}}};
+
+    ASSERT_EQ(expected, take_subnegotiations());
+}
+
+TEST_F(
+    an_activated_msdp_server,
+    reports_a_streamed_message_larger_than_the_limit_once)
+{
+    int oversized_messages = 0;
+    option_.on_oversized_message.connect([&] { ++oversized_messages; });
+
+    session_.install(option_);
+    session_.set_subnegotiation_limit(
+        4, telnetpp::subnegotiation_overflow_policy::stream);
+
+    static auto const content =
+        "\xFF\xFA\x45"
+        "\x01var\x02val"
+        "\xFF\xF0"_tb;
+
+    session_.async_read([](telnetpp::bytes) {});
+    channel_.receive(content);
+
+    ASSERT_EQ(1, oversized_messages);
+    ASSERT_TRUE(received_variables_.empty());
+}
@@ -0,0 +1,203 @@
+#include "allocation_counter.hpp"
+
+#include <gtest/gtest.h>
+#include <telnetpp/options/msdp/detail/decoder.hpp>
+#include <telnetpp/options/msdp/detail/encoder.hpp>
+#include <telnetpp/options/msdp/detail/protocol.hpp>
+#include <telnetpp/options/msdp/detail/view_decoder.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace telnetpp::literals;  // NOLINT
+
+namespace msdp = telnetpp::options::msdp;
+
+namespace {
+
+telnetpp::byte_storage encode(msdp::variable const &var)
+{
+    telnetpp::byte_storage result;
+    msdp::detail::encode_variable(var, result);
+    return result;
+}
+
+std::vector<msdp::variable> decode_with_views(
+    msdp::detail::view_decoder &decoder, telnetpp::bytes data)
+{
+    std::vector<msdp::variable> result;
+    decoder(data, [&result](msdp::variable_view const &view) {
+        result.push_back(msdp::to_variable(view));
+    });
+    return result;
+}
+
+std::vector<msdp::variable> decode_with_variables(telnetpp::bytes data)
+{
+    std::vector<msdp::variable> result;
+    msdp::detail::decode(data, [&result](msdp::variable const &var) {
+        result.push_back(var);
+    });
+    return result;
+}
+
+bool is_within(telnetpp::bytes view, telnetpp::bytes data)
+{
+    return view.data() >= data.data()
+        && view.data() + view.size() <= data.data() + data.size();
+}
+
+class an_msdp_view_decoder : public testing::Test
+{
+protected:
+    msdp::detail::view_decoder decoder_;
+};
+
+}  // namespace
+
+TEST_F(an_msdp_view_decoder, decodes_a_string_variable_as_views_of_the_data)
+{
+    auto const data = encode({"name"_tb, "value"_tb});
+    int calls = 0;
+
+    decoder_(data, [&](msdp::variable_view const &view) {
+        ++calls;
+        auto const value = std::get<msdp::string_value_view>(view.value_);
+
+        ASSERT_TRUE(telnetpp::bytes_equal("name"_tb, view.name_));
+        ASSERT_TRUE(telnetpp::bytes_equal("value"_tb, value));
+        ASSERT_TRUE(is_within(view.name_, data));
+        ASSERT_TRUE(is_within(value, data));
+    });
+
+    ASSERT_EQ(1, calls);
+}
+
+TEST_F(an_msdp_view_decoder, decodes_an_array_variable)
+{
+    msdp::variable const var{"list"_tb, msdp::array_value{"a"_tb, "bc"_tb}};
+    auto const data = encode(var);
+    int calls = 0;
+
+    decoder_(data, [&](msdp::variable_view const &view) {
+        ++calls;
+        auto const values = std::get<msdp::array_value_view>(view.value_);
+
+        ASSERT_EQ(2U, values.size());
+        ASSERT_TRUE(telnetpp::bytes_equal("a"_tb, values[0]));
+        ASSERT_TRUE(telnetpp::bytes_equal("bc"_tb, values[1]));
+    });
+
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ(std::vector{var}, decode_with_views(decoder_, data));
+}
+
+TEST_F(an_msdp_view_decoder, decodes_a_nested_table_variable)
+{
+    msdp::variable const var{
+        "room"_tb,
+        msdp::table_value{
+            {"name"_tb, "The Square"_tb},
+            {"exits"_tb,
+             msdp::table_value{{"n"_tb, "1"_tb}, {"s"_tb, "2"_tb}}}}};
+
+    ASSERT_EQ(std::vector{var}, decode_with_views(decoder_, encode(var)));
+}
+
+TEST_F(an_msdp_view_decoder, decodes_several_variables)
+{
+    auto data = encode({"a"_tb, "1"_tb});
+    data += encode({"b"_tb, msdp::array_value{"2"_tb}});
+    data += encode({"c"_tb, "3"_tb});
+
+    ASSERT_EQ(decode_with_variables(data), decode_with_views(decoder_, data));
+    ASSERT_EQ(3U, decode_with_views(decoder_, data).size());
+}
+
+TEST_F(an_msdp_view_decoder, decodes_as_the_owning_decoder_does)
+{
+    // Any sequence of these bytes, well-formed or not, must be decoded in
+    // the same way by both decoders.
+    static constexpr telnetpp::byte alphabet[] = {
+        msdp::detail::var,
+        msdp::detail::val,
+        msdp::detail::table_open,
+        msdp::detail::table_close,
+        msdp::detail::array_open,
+        msdp::detail::array_close,
+        'x',
+        'y',
+    };
+
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<std::size_t> length(0, 48);
+    std::uniform_int_distribution<std::size_t> symbol(0, 7);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        telnetpp::byte_storage data(length(gen), 0);
+
+        for (auto &by : data)
+        {
+            by = alphabet[symbol(gen)];
+        }
+
+        ASSERT_EQ(
+            decode_with_variables(data), decode_with_views(decoder_, data));
+    }
+}
+
+TEST_F(an_msdp_view_decoder, allocates_nothing_once_its_storage_has_grown)
+{
+    msdp::variable const var{
+        "room"_tb,
+        msdp::table_value{
+            {"name"_tb, "The Square"_tb},
+            {"exits"_tb,
+             msdp::table_value{{"n"_tb, "1"_tb}, {"s"_tb, "2"_tb}}}}};
+    auto const data = encode(var);
+
+    std::size_t variables = 0;
+    msdp::detail::view_decoder::continuation const count =
+        [&variables](msdp::variable_view const &) { ++variables; };
+
+    decoder_(data, count);
+
+    auto const allocations_before = allocation_counter::allocations();
+    decoder_(data, count);
+
+    ASSERT_EQ(allocations_before, allocation_counter::allocations());
+    ASSERT_EQ(2U, variables);
+}
+
+TEST_F(an_msdp_view_decoder, can_be_used_again_from_its_continuation)
+{
+    msdp::variable const outer_var{
+        "outer"_tb, msdp::table_value{{"a"_tb, "1"_tb}}};
+    msdp::variable const inner_var{
+        "inner"_tb, msdp::table_value{{"b"_tb, "2"_tb}, {"c"_tb, "3"_tb}}};
+    auto const outer_data = encode(outer_var);
+    auto const inner_data = encode(inner_var);
+
+    std::vector<msdp::variable> inner_result;
+    std::vector<msdp::variable> outer_result;
+
+    decoder_(outer_data, [&](msdp::variable_view const &view) {
+        inner_result = decode_with_views(decoder_, inner_data);
+        outer_result.push_back(msdp::to_variable(view));
+    });
+
+    ASSERT_EQ(std::vector{inner_var}, inner_result);
+    ASSERT_EQ(std::vector{outer_var}, outer_result);
+}
+
+TEST_F(an_msdp_view_decoder, identifies_no_names_by_default)
+{
+    msdp::name_id id = 0;
+
+    decoder_(encode({"HEALTH"_tb, "100"_tb}), [&id](auto const &view) {
+        id = view.id_;
+    });
+
+    ASSERT_EQ(msdp::unknown_name, id);
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <telnetpp/detail/negotiation_router.hpp>
 
+#include <vector>
+
 TEST(
     negotiation_router_test,
     message_with_registered_key_goes_to_registered_function)
@@ -51,3 +53,116 @@ TEST(
     ASSERT_FALSE(registered_route_called);
     ASSERT_EQ(expected, neg);
 }
+
+TEST(negotiation_router_test, requests_for_the_same_option_are_routed_apart)
+{
+    telnetpp::detail::negotiation_router router;
+
+    int will_calls = 0;
+    int do_calls = 0;
+
+    router.register_route(
+        telnetpp::negotiation{telnetpp::will, 0x18},
+        [&will_calls](telnetpp::negotiation) { ++will_calls; });
+    router.register_route(
+        telnetpp::negotiation{telnetpp::do_, 0x18},
+        [&do_calls](telnetpp::negotiation) { ++do_calls; });
+
+    router(telnetpp::negotiation{telnetpp::will, 0x18});
+    router(telnetpp::negotiation{telnetpp::do_, 0x18});
+    router(telnetpp::negotiation{telnetpp::do_, 0x18});
+    router(telnetpp::negotiation{telnetpp::dont, 0x18});
+
+    ASSERT_EQ(1, will_calls);
+    ASSERT_EQ(2, do_calls);
+}
+
+TEST(
+    negotiation_router_test,
+    message_with_unregistered_route_goes_to_unregistered_function)
+{
+    telnetpp::detail::negotiation_router router;
+
+    telnetpp::negotiation const key(telnetpp::wont, 0x1F);
+    bool registered_route_called = false;
+    bool unregistered_route_called = false;
+
+    router.register_route(
+        key, [&registered_route_called](telnetpp::negotiation) {
+            registered_route_called = true;
+        });
+    router.set_unregistered_route(
+        [&unregistered_route_called](telnetpp::negotiation) {
+            unregistered_route_called = true;
+        });
+
+    router.unregister_route(key);
+    router(key);
+
+    ASSERT_FALSE(registered_route_called);
+    ASSERT_TRUE(unregistered_route_called);
+}
+
+TEST(negotiation_router_test, reregistered_routes_replace_previous_routes)
+{
+    telnetpp::detail::negotiation_router router;
+
+    telnetpp::negotiation const first(telnetpp::will, 0x01);
+    telnetpp::negotiation const second(telnetpp::will, 0x03);
+    std::vector<int> calls;
+
+    router.register_route(
+        first, [&calls](telnetpp::negotiation) { calls.push_back(1); });
+    router.register_route(
+        second, [&calls](telnetpp::negotiation) { calls.push_back(2); });
+    router.unregister_route(first);
+    router.register_route(
+        second, [&calls](telnetpp::negotiation) { calls.push_back(3); });
+    router.register_route(
+        first, [&calls](telnetpp::negotiation) { calls.push_back(4); });
+
+    router(first);
+    router(second);
+
+    std::vector<int> const expected = {4, 3};
+    ASSERT_EQ(expected, calls);
+}
+
+TEST(negotiation_router_test, message_with_no_route_is_ignored)
+{
+    telnetpp::detail::negotiation_router router;
+
+    router(telnetpp::negotiation{telnetpp::dont, 0xFF});
+}
+
+TEST(negotiation_router_test, routes_may_be_registered_by_a_routed_handler)
+{
+    telnetpp::detail::negotiation_router router;
+
+    int calls = 0;
+    int registered_calls = 0;
+    router.register_route(
+        telnetpp::negotiation{telnetpp::will, 0x00},
+        [&router, &calls, &registered_calls](telnetpp::negotiation) {
+            // Registering many routes at once must not move this handler
+            // while it is still running.
+            for (int option = 1; option < 256; ++option)
+            {
+                router.register_route(
+                    telnetpp::negotiation{
+                        telnetpp::do_,
+                        static_cast<telnetpp::option_type>(option)},
+                    [&registered_calls](telnetpp::negotiation) {
+                        ++registered_calls;
+                    });
+            }
+
+            ++calls;
+        });
+
+    router(telnetpp::negotiation{telnetpp::will, 0x00});
+    router(telnetpp::negotiation{telnetpp::do_, 0xFF});
+
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ(1, registered_calls);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <telnetpp/output_segments.hpp>
+
+using namespace telnetpp::literals;  // NOLINT
+
+TEST(output_segments_test, is_initially_empty)
+{
+    telnetpp::output_segments segments;
+
+    ASSERT_TRUE(segments.empty());
+    ASSERT_EQ(0U, segments.size());
+    ASSERT_EQ(0U, segments.total_size());
+    ASSERT_TRUE(segments.segments().empty());
+}
+
+TEST(output_segments_test, ignores_empty_segments)
+{
+    telnetpp::output_segments segments;
+    segments.push_back({});
+
+    ASSERT_TRUE(segments.empty());
+}
+
+TEST(output_segments_test, merges_contiguous_segments)
+{
+    auto const data = "abcdef"_tb;
+    telnetpp::bytes const content{data};
+
+    telnetpp::output_segments segments;
+    segments.push_back(content.first(2));
+    segments.push_back(content.subspan(2));
+
+    ASSERT_EQ(1U, segments.size());
+    ASSERT_EQ(content.data(), segments.segments()[0].data());
+    ASSERT_EQ(content.size(), segments.segments()[0].size());
+}
+
+TEST(output_segments_test, does_not_merge_overlapping_segments)
+{
+    auto const data = "abcdef"_tb;
+    telnetpp::bytes const content{data};
+
+    telnetpp::output_segments segments;
+    segments.push_back(content.first(3));
+    segments.push_back(content.subspan(2));
+
+    ASSERT_EQ(2U, segments.size());
+    ASSERT_EQ(7U, segments.total_size());
+}
+
+TEST(output_segments_test, holds_more_segments_than_its_inline_capacity)
+{
+    constexpr auto segment_count =
+        telnetpp::output_segments::inline_capacity * 2 + 1;
+
+    std::vector<telnetpp::byte_storage> data(segment_count);
+    telnetpp::output_segments segments;
+
+    for (std::size_t index = 0; index < segment_count; ++index)
+    {
+        data[index] = telnetpp::byte_storage(
+            index + 1, static_cast<telnetpp::byte>(index));
+        segments.push_back(data[index]);
+    }
+
+    ASSERT_EQ(segment_count, segments.size());
+
+    for (std::size_t index = 0; index < segment_count; ++index)
+    {
+        ASSERT_EQ(data[index].data(), segments.segments()[index].data());
+        ASSERT_EQ(data[index].size(), segments.segments()[index].size());
+    }
+
+    segments.clear();
+
+    ASSERT_TRUE(segments.empty());
+    ASSERT_TRUE(segments.segments().empty());
+}
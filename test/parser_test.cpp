@@ -1,10 +1,13 @@
 ﻿#include <gtest/gtest.h>
+#include <telnetpp/detail/overloaded.hpp>
 #include <telnetpp/element.hpp>
 #include <telnetpp/parser.hpp>
 
+#include <string>
 #include <tuple>
 #include <vector>
 
+using namespace telnetpp::literals;  // NOLINT
 using testing::ValuesIn;
 
 namespace {
@@ -403,3 +406,382 @@ TEST_F(parser_test, many_elements_parses_to_many_elements)
 
     ASSERT_EQ(size_t{11}, result_.size());
 }
+
+namespace {
+
+// Every kind of sequence, including escaped IACs in both plain data and
+// subnegotiation content, so that each can be split at any of its bytes.
+constexpr telnetpp::byte const mixed_stream[] = {
+    'a', 0xFF, 0xFF, 'b',                    // text: a\xFFb
+    0xFF, 0xF1,                              // command: NOP
+    0xFF, 0xFB, 0x18,                        // negotiation: WILL 0x18
+    0xFF, 0xFA, 0x45, 'c', 0xFF, 0xFF, 'd',  //
+    0xFF, 0xF0,                              // subnegotiation: 0x45[c\xFFd]
+    0xFF, 0xF0,                              // command: SE
+    0xFF, 0xFA, 0x46, 0xFF, 0xF0,            // subnegotiation: 0x46[]
+    0xFF, 0xFE, 0x01,                        // negotiation: DONT 1
+    'e'                                      // text: e
+};
+
+// Describes the elements that are parsed from the data, which is passed to
+// the parser in two reads split at the given position.  Adjacent plain data
+// is joined, since a split necessarily divides it into separate elements.
+std::vector<std::string> describe_parse(
+    telnetpp::bytes data, std::size_t split)
+{
+    std::vector<std::string> result;
+    std::string text;
+
+    auto const flush_text = [&] {
+        if (!text.empty())
+        {
+            result.push_back("text:" + text);
+            text.clear();
+        }
+    };
+
+    auto const describe = telnetpp::detail::overloaded{
+        [&](telnetpp::bytes const &content) {
+            text.append(content.begin(), content.end());
+        },
+        [&](telnetpp::command const &cmd) {
+            flush_text();
+            result.push_back("command:" + std::to_string(cmd.value()));
+        },
+        [&](telnetpp::negotiation const &neg) {
+            flush_text();
+            result.push_back(
+                "negotiation:" + std::to_string(neg.request()) + ":"
+                + std::to_string(neg.option_code()));
+        },
+        [&](telnetpp::subnegotiation const &sub) {
+            flush_text();
+            result.push_back(
+                "subnegotiation:" + std::to_string(sub.option()) + ":"
+                + std::string(sub.content().begin(), sub.content().end()));
+        }};
+
+    telnetpp::parser parse;
+    auto const cont = [&](telnetpp::element const &elem) {
+        std::visit(describe, elem);
+    };
+
+    parse(data.first(split), cont);
+    parse(data.subspan(split), cont);
+    flush_text();
+
+    return result;
+}
+
+class parsing_split_sequences : public testing::TestWithParam<std::size_t>
+{
+};
+
+}  // namespace
+
+TEST_P(parsing_split_sequences, parses_to_the_same_elements_as_one_read)
+{
+    std::vector<std::string> const expected = {
+        "text:a\xFF" "b",
+        "command:241",
+        "negotiation:251:24",
+        "subnegotiation:69:c\xFF" "d",
+        "command:240",
+        "subnegotiation:70:",
+        "negotiation:254:1",
+        "text:e"};
+
+    ASSERT_EQ(expected, describe_parse(mixed_stream, std::size(mixed_stream)));
+    ASSERT_EQ(expected, describe_parse(mixed_stream, GetParam()));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    sequences_are_split_at_every_position,
+    parsing_split_sequences,
+    testing::Range(std::size_t{0}, std::size(mixed_stream) + 1));
+
+namespace {
+
+// Long runs are used so that any block-wise scanning of the input is
+// exercised, with the IAC byte appearing at every offset within a block,
+// as well as in the unaligned tail.
+constexpr std::size_t long_run_size = 100;
+
+class parsing_long_runs
+  : public parser_test_base,
+    public testing::TestWithParam<std::size_t>
+{
+};
+
+}  // namespace
+
+TEST_P(parsing_long_runs, splits_plain_data_at_commands)
+{
+    auto const position = GetParam();
+
+    telnetpp::byte_storage data(long_run_size, 'x');
+    data[position] = telnetpp::iac;
+    data.insert(data.begin() + position + 1, telnetpp::nop);
+
+    std::vector<telnetpp::element> expected;
+
+    if (position != 0)
+    {
+        expected.emplace_back(telnetpp::bytes{data}.first(position));
+    }
+
+    expected.emplace_back(telnetpp::command{telnetpp::nop});
+
+    if (position + 2 != data.size())
+    {
+        expected.emplace_back(telnetpp::bytes{data}.subspan(position + 2));
+    }
+
+    parse_with_check(
+        data,
+        [&expected, iteration = size_t{0}](
+            telnetpp::element const &elem) mutable {
+            ASSERT_LT(iteration, expected.size());
+            ASSERT_EQ(expected[iteration], elem);
+            ++iteration;
+        });
+
+    ASSERT_EQ(expected.size(), result_.size());
+}
+
+TEST_P(parsing_long_runs, unescapes_double_iac_in_plain_data)
+{
+    auto const position = GetParam();
+
+    telnetpp::byte_storage data(long_run_size, 'x');
+    data[position] = telnetpp::iac;
+    data.insert(data.begin() + position + 1, telnetpp::iac);
+
+    telnetpp::byte_storage expected(long_run_size, 'x');
+    expected[position] = telnetpp::iac;
+
+    parse_with_check(data, [&expected](telnetpp::element const &elem) {
+        auto const actual = std::get<telnetpp::bytes>(elem);
+        ASSERT_TRUE(telnetpp::bytes_equal(expected, actual));
+    });
+
+    ASSERT_EQ(size_t{1}, result_.size());
+}
+
+TEST_P(parsing_long_runs, unescapes_double_iac_in_subnegotiation_content)
+{
+    auto const position = GetParam();
+
+    telnetpp::byte_storage content(long_run_size, 'x');
+    content[position] = telnetpp::iac;
+
+    telnetpp::byte_storage data = {telnetpp::iac, telnetpp::sb, 0xAB};
+    data.append(content.begin(), content.begin() + position + 1);
+    data.push_back(telnetpp::iac);
+    data.append(content.begin() + position + 1, content.end());
+    data.append({telnetpp::iac, telnetpp::se});
+
+    parse_with_check(data, [&content](telnetpp::element const &elem) {
+        telnetpp::subnegotiation const expected{0xAB, content};
+
+        auto const actual = std::get<telnetpp::subnegotiation>(elem);
+        ASSERT_EQ(expected, actual);
+    });
+
+    ASSERT_EQ(size_t{1}, result_.size());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    iac_is_found_at_every_position,
+    parsing_long_runs,
+    testing::Range(std::size_t{0}, long_run_size));
+
+TEST_F(parser_test, plain_data_split_across_reads_is_emitted_per_read)
+{
+    telnetpp::byte_storage const data(long_run_size, 'x');
+    auto const first_half = telnetpp::bytes{data}.first(long_run_size / 2);
+    auto const second_half = telnetpp::bytes{data}.subspan(long_run_size / 2);
+
+    parse_with_check(first_half, [&](telnetpp::element const &elem) {
+        ASSERT_EQ(telnetpp::element{first_half}, elem);
+    });
+
+    parse_with_check(second_half, [&](telnetpp::element const &elem) {
+        ASSERT_EQ(telnetpp::element{second_half}, elem);
+    });
+
+    ASSERT_EQ(size_t{2}, result_.size());
+}
+
+TEST_F(parser_test, contiguous_plain_data_refers_to_the_input)
+{
+    static constexpr telnetpp::byte const data[] = {
+        'a', 'b', 0xFF, 0xF1, 'c', 'd', 'e'};
+
+    parse(data);
+
+    ASSERT_EQ(size_t{3}, result_.size());
+
+    auto const first = std::get<telnetpp::bytes>(result_[0]);
+    ASSERT_EQ(&data[0], first.data());
+    ASSERT_EQ(size_t{2}, first.size());
+
+    auto const last = std::get<telnetpp::bytes>(result_[2]);
+    ASSERT_EQ(&data[4], last.data());
+    ASSERT_EQ(size_t{3}, last.size());
+}
+
+TEST_F(parser_test, plain_data_with_escaped_iac_is_joined_into_one_element)
+{
+    static constexpr telnetpp::byte const data[] = {
+        'a', 'b', 0xFF, 0xFF, 'c', 'd'};
+
+    parse_with_check(data, [](telnetpp::element const &elem) {
+        static constexpr telnetpp::byte const expected_values[] = {
+            'a', 'b', 0xFF, 'c', 'd'};
+        static constexpr telnetpp::bytes const expected{expected_values};
+
+        auto const actual = std::get<telnetpp::bytes>(elem);
+        ASSERT_TRUE(telnetpp::bytes_equal(expected, actual));
+    });
+
+    ASSERT_EQ(size_t{1}, result_.size());
+}
+
+namespace {
+
+class a_limited_parser : public testing::Test
+{
+protected:
+    void parse(telnetpp::bytes data)
+    {
+        parser_(
+            data,
+            telnetpp::detail::overloaded{
+                [this](telnetpp::element const &elem) {
+                    std::visit(
+                        telnetpp::detail::overloaded{
+                            [this](telnetpp::subnegotiation const &sub) {
+                                subnegotiations_.emplace_back(
+                                    sub.content().begin(),
+                                    sub.content().end());
+                            },
+                            [](auto const &) {}},
+                        elem);
+                },
+                [this](telnetpp::subnegotiation_event const &event) {
+                    event_kinds_.push_back(event.kind());
+                    event_content_.append(
+                        event.content().begin(), event.content().end());
+                }});
+    }
+
+    telnetpp::parser parser_;
+    std::vector<telnetpp::byte_storage> subnegotiations_;
+    std::vector<telnetpp::subnegotiation_event::event_kind> event_kinds_;
+    telnetpp::byte_storage event_content_;
+};
+
+using event_kind = telnetpp::subnegotiation_event::event_kind;
+
+constexpr telnetpp::byte const small_and_large_subnegotiations[] = {
+    0xFF, 0xFA, 0xAB, 'a', 'b', 'c', 0xFF, 0xF0,
+    0xFF, 0xFA, 0xAB, 'd', 'e', 0xFF, 0xFF, 'f', 'g', 0xFF, 0xF0,
+    0xFF, 0xFA, 0xAB, 'h', 0xFF, 0xF0,
+};
+
+}  // namespace
+
+TEST_F(a_limited_parser, delivers_subnegotiations_up_to_the_limit)
+{
+    parser_.set_subnegotiation_limit(
+        3, telnetpp::subnegotiation_overflow_policy::discard);
+
+    parse(small_and_large_subnegotiations);
+
+    std::vector<telnetpp::byte_storage> const expected = {
+        {'a', 'b', 'c'},
+        {'h'}
+    };
+
+    ASSERT_EQ(expected, subnegotiations_);
+    ASSERT_TRUE(event_kinds_.empty());
+}
+
+TEST_F(a_limited_parser, with_error_policy_reports_overflowing_subnegotiations)
+{
+    parser_.set_subnegotiation_limit(
+        3, telnetpp::subnegotiation_overflow_policy::error);
+
+    parse(small_and_large_subnegotiations);
+
+    std::vector<telnetpp::byte_storage> const expected = {
+        {'a', 'b', 'c'},
+        {'h'}
+    };
+
+    std::vector<event_kind> const expected_kinds = {event_kind::overflow};
+
+    ASSERT_EQ(expected, subnegotiations_);
+    ASSERT_EQ(expected_kinds, event_kinds_);
+    ASSERT_TRUE(event_content_.empty());
+}
+
+TEST_F(a_limited_parser, with_stream_policy_streams_overflowing_subnegotiations)
+{
+    parser_.set_subnegotiation_limit(
+        3, telnetpp::subnegotiation_overflow_policy::stream);
+
+    parse(small_and_large_subnegotiations);
+
+    std::vector<telnetpp::byte_storage> const expected = {
+        {'a', 'b', 'c'},
+        {'h'}
+    };
+
+    std::vector<event_kind> const expected_kinds = {
+        event_kind::begin,
+        event_kind::content,
+        event_kind::content,
+        event_kind::end};
+
+    telnetpp::byte_storage const expected_content = {'d', 'e', 0xFF, 'f', 'g'};
+
+    ASSERT_EQ(expected, subnegotiations_);
+    ASSERT_EQ(expected_kinds, event_kinds_);
+    ASSERT_EQ(expected_content, event_content_);
+}
+
+TEST_F(a_limited_parser, streams_subnegotiations_split_across_reads)
+{
+    parser_.set_subnegotiation_limit(
+        2, telnetpp::subnegotiation_overflow_policy::stream);
+
+    static constexpr telnetpp::byte const data0[] = {
+        0xFF, 0xFA, 0xAB, 'a', 'b', 'c'};
+    static constexpr telnetpp::byte const data1[] = {'d', 'e', 0xFF, 0xF0};
+
+    parse(data0);
+    parse(data1);
+
+    std::vector<event_kind> const expected_kinds = {
+        event_kind::begin,
+        event_kind::content,
+        event_kind::content,
+        event_kind::content,
+        event_kind::end};
+
+    ASSERT_TRUE(subnegotiations_.empty());
+    ASSERT_EQ(expected_kinds, event_kinds_);
+    ASSERT_EQ("abcde"_tb, event_content_);
+}
+
+TEST_F(parser_test, without_event_handling_discards_overflowing_subnegotiations)
+{
+    parser_.set_subnegotiation_limit(
+        3, telnetpp::subnegotiation_overflow_policy::stream);
+
+    parse(small_and_large_subnegotiations);
+
+    ASSERT_EQ(size_t{2}, result_.size());
+}
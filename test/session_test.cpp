@@ -269,6 +269,18 @@ TEST_F(a_session, can_send_plain_text)
     ASSERT_EQ(expected_result, channel_.written_);
 }
 
+TEST_F(a_session, sends_encoded_data_as_it_is)
+{
+    auto const content =
+        "\xFF\xFA\x42"
+        "a\xFF\xFF"
+        "b\xFF\xF0"_tb;
+
+    session_.write_encoded(content);
+
+    ASSERT_EQ(content, channel_.written_);
+}
+
 TEST_F(a_session, can_receive_data_piecemeal)
 {
     static telnetpp::option_type const client_option = 0xD0;
@@ -343,3 +355,332 @@ TEST_F(a_session, closes_the_channel_when_closed)
     session_.close();
     ASSERT_FALSE(session_.is_alive());
 }
+
+TEST_F(a_session, discards_subnegotiations_larger_than_the_limit)
+{
+    constexpr telnetpp::option_type option = 0xA5;
+    fake_client_option client{session_, option};
+
+    client.negotiate(telnetpp::will);
+    assert(client.active());
+
+    session_.install(client);
+    session_.set_subnegotiation_limit(4);
+
+    int subnegotiation_count = 0;
+    client.on_subnegotiation.connect(
+        [&](telnetpp::bytes) { ++subnegotiation_count; });
+
+    int event_count = 0;
+    client.on_subnegotiation_event.connect(
+        [&](telnetpp::subnegotiation_event const &) { ++event_count; });
+
+    static auto const content =
+        "\xFF\xFA\xA5"
+        "TESTS"
+        "\xFF\xF0"
+        "TEXT"_tb;
+
+    async_read();
+    channel_.receive(content);
+
+    ASSERT_EQ(0, subnegotiation_count);
+    ASSERT_EQ(0, event_count);
+    ASSERT_EQ("TEXT"_tb, received_content_);
+    ASSERT_TRUE(complete_);
+}
+
+TEST_F(a_session, streams_subnegotiations_larger_than_the_limit_to_options)
+{
+    constexpr telnetpp::option_type option = 0xA5;
+    fake_client_option client{session_, option};
+
+    client.negotiate(telnetpp::will);
+    assert(client.active());
+
+    session_.install(client);
+    session_.set_subnegotiation_limit(
+        4, telnetpp::subnegotiation_overflow_policy::stream);
+
+    std::vector<telnetpp::subnegotiation_event::event_kind> kinds;
+    telnetpp::byte_storage streamed_content;
+    client.on_subnegotiation_event.connect(
+        [&](telnetpp::subnegotiation_event const &event) {
+            kinds.push_back(event.kind());
+            streamed_content.append(
+                event.content().begin(), event.content().end());
+        });
+
+    static auto const content =
+        "\xFF\xFA\xA5"
+        "STREAMED"
+        "\xFF\xF0"_tb;
+
+    async_read();
+    channel_.receive(content);
+
+    using event_kind = telnetpp::subnegotiation_event::event_kind;
+    std::vector<event_kind> const expected_kinds = {
+        event_kind::begin,
+        event_kind::content,
+        event_kind::content,
+        event_kind::end};
+
+    ASSERT_EQ(expected_kinds, kinds);
+    ASSERT_EQ("STREAMED"_tb, streamed_content);
+    ASSERT_TRUE(complete_);
+}
+
+namespace {
+
+struct fake_scatter_gather_channel : fake_channel
+{
+    //* =================================================================
+    /// \brief Write the given segments of data to the channel.
+    //* =================================================================
+    void write_segments(std::span<telnetpp::bytes const> segments)
+    {
+        ++write_segments_calls_;
+
+        for (auto const &segment : segments)
+        {
+            written_.append(segment.begin(), segment.end());
+        }
+    }
+
+    int write_segments_calls_{0};
+};
+
+}  // namespace
+
+TEST(a_session_with_a_scatter_gather_channel, writes_each_element_at_once)
+{
+    fake_scatter_gather_channel channel;
+    telnetpp::session session{channel};
+
+    static constexpr telnetpp::byte const content[] = {'a', 0xFF, 'b'};
+    session.write(telnetpp::subnegotiation{0x42, content});
+
+    ASSERT_EQ(1, channel.write_segments_calls_);
+    ASSERT_EQ(
+        "\xFF\xFA\x42"
+        "a\xFF\xFF"
+        "b\xFF\xF0"_tb,
+        channel.written_);
+}
+
+TEST(
+    a_session_with_a_scatter_gather_channel,
+    writes_a_batch_of_elements_at_once)
+{
+    fake_scatter_gather_channel channel;
+    telnetpp::session session{channel};
+
+    std::vector<telnetpp::element> const elements = {
+        telnetpp::negotiation{telnetpp::will, 0x01},
+        telnetpp::negotiation{telnetpp::do_, 0x1F},
+        telnetpp::command{telnetpp::ga}};
+
+    session.write(elements);
+
+    ASSERT_EQ(1, channel.write_segments_calls_);
+    ASSERT_EQ("\xFF\xFB\x01\xFF\xFD\x1F\xFF\xF9"_tb, channel.written_);
+}
+
+namespace {
+
+struct fake_counting_channel : fake_channel
+{
+    //* =================================================================
+    /// \brief Write the given data to the channel.
+    //* =================================================================
+    void write(telnetpp::bytes data)
+    {
+        ++write_calls_;
+        fake_channel::write(data);
+    }
+
+    int write_calls_{0};
+};
+
+class a_corked_session : public testing::Test
+{
+protected:
+    a_corked_session()
+    {
+        session_.cork();
+    }
+
+    fake_counting_channel channel_;
+    telnetpp::session session_{channel_};
+};
+
+}  // namespace
+
+TEST_F(a_corked_session, does_not_write_to_the_channel)
+{
+    session_.write(telnetpp::negotiation{telnetpp::will, 0x01});
+    session_.write("abc"_tb);
+
+    ASSERT_EQ(0, channel_.write_calls_);
+    ASSERT_TRUE(channel_.written_.empty());
+}
+
+TEST_F(a_corked_session, writes_all_output_at_once_when_uncorked)
+{
+    session_.write(telnetpp::negotiation{telnetpp::will, 0x01});
+    session_.write(telnetpp::subnegotiation{0x1F, "\x00\x50"_tb});
+    session_.write("a\xFF"_tb);
+    session_.uncork();
+
+    ASSERT_EQ(1, channel_.write_calls_);
+    ASSERT_EQ(
+        "\xFF\xFB\x01"
+        "\xFF\xFA\x1F\x00\x50\xFF\xF0"
+        "a\xFF\xFF"_tb,
+        channel_.written_);
+}
+
+TEST_F(a_corked_session, writes_output_when_flushed_and_remains_corked)
+{
+    session_.write("abc"_tb);
+    session_.flush();
+
+    ASSERT_EQ(1, channel_.write_calls_);
+    ASSERT_EQ("abc"_tb, channel_.written_);
+
+    session_.write("def"_tb);
+
+    ASSERT_EQ(1, channel_.write_calls_);
+}
+
+TEST_F(a_corked_session, writes_nothing_when_flushed_with_no_output)
+{
+    session_.flush();
+    session_.uncork();
+
+    ASSERT_EQ(0, channel_.write_calls_);
+}
+
+TEST_F(a_corked_session, remains_corked_until_the_outermost_cork_is_removed)
+{
+    session_.cork();
+    session_.write("abc"_tb);
+    session_.uncork();
+
+    ASSERT_EQ(0, channel_.write_calls_);
+
+    session_.uncork();
+
+    ASSERT_EQ(1, channel_.write_calls_);
+    ASSERT_EQ("abc"_tb, channel_.written_);
+}
+
+TEST_F(a_corked_session, writes_output_when_reaching_the_high_water_mark)
+{
+    session_.set_output_high_water_mark(4);
+
+    session_.write("abc"_tb);
+    ASSERT_EQ(0, channel_.write_calls_);
+
+    session_.write("de"_tb);
+    ASSERT_EQ(1, channel_.write_calls_);
+    ASSERT_EQ("abcde"_tb, channel_.written_);
+}
+
+TEST_F(a_corked_session, collects_encoded_output_with_other_output)
+{
+    session_.write("a\xFF"_tb);
+    session_.write_encoded("\xFF\xFA\x1F\x00\x50\xFF\xF0"_tb);
+    session_.uncork();
+
+    ASSERT_EQ(1, channel_.write_calls_);
+    ASSERT_EQ(
+        "a\xFF\xFF"
+        "\xFF\xFA\x1F\x00\x50\xFF\xF0"_tb,
+        channel_.written_);
+}
+
+TEST_F(a_corked_session, writes_output_before_closing)
+{
+    session_.write("abc"_tb);
+    session_.close();
+
+    ASSERT_EQ("abc"_tb, channel_.written_);
+    ASSERT_FALSE(channel_.alive_);
+}
+
+TEST_F(a_corked_session, writes_immediately_once_uncorked)
+{
+    session_.uncork();
+    session_.write("abc"_tb);
+    session_.write("def"_tb);
+
+    ASSERT_EQ(2, channel_.write_calls_);
+}
+
+namespace {
+
+struct fake_flushing_channel : fake_channel
+{
+    //* =================================================================
+    /// \brief Sends on any output that the channel is holding back.
+    //* =================================================================
+    void flush()
+    {
+        flushed_size_ = written_.size();
+        ++flush_calls_;
+    }
+
+    std::size_t flushed_size_{0};
+    int flush_calls_{0};
+};
+
+class a_session_with_a_flushing_channel : public testing::Test
+{
+protected:
+    fake_flushing_channel channel_;
+    telnetpp::session session_{channel_};
+};
+
+}  // namespace
+
+TEST_F(a_session_with_a_flushing_channel, flushes_the_channel_when_flushed)
+{
+    session_.write("abc"_tb);
+    ASSERT_EQ(0, channel_.flush_calls_);
+
+    session_.flush();
+    ASSERT_EQ(1, channel_.flush_calls_);
+    ASSERT_EQ(3U, channel_.flushed_size_);
+}
+
+TEST_F(
+    a_session_with_a_flushing_channel,
+    flushes_the_channel_after_writing_corked_output)
+{
+    session_.cork();
+    session_.write("abc"_tb);
+    session_.flush();
+
+    ASSERT_EQ(1, channel_.flush_calls_);
+    ASSERT_EQ(3U, channel_.flushed_size_);
+
+    session_.write("def"_tb);
+    session_.uncork();
+
+    ASSERT_EQ(2, channel_.flush_calls_);
+    ASSERT_EQ(6U, channel_.flushed_size_);
+}
+
+TEST_F(
+    a_session_with_a_flushing_channel,
+    does_not_flush_the_channel_at_the_high_water_mark)
+{
+    session_.cork();
+    session_.set_output_high_water_mark(4);
+    session_.write("abcde"_tb);
+
+    ASSERT_EQ("abcde"_tb, channel_.written_);
+    ASSERT_EQ(0, channel_.flush_calls_);
+}
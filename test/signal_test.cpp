@@ -0,0 +1,150 @@
+#include "allocation_counter.hpp"
+
+#include <gtest/gtest.h>
+#include <telnetpp/signal.hpp>
+
+#include <vector>
+
+using signal_type = telnetpp::single_threaded_signal<void(int)>;
+
+TEST(single_threaded_signal_test, new_signal_has_no_slots)
+{
+    signal_type signal;
+
+    ASSERT_TRUE(signal.empty());
+    ASSERT_EQ(0U, signal.num_slots());
+
+    signal(0);
+}
+
+TEST(single_threaded_signal_test, emission_calls_slots_in_connection_order)
+{
+    signal_type signal;
+    std::vector<int> calls;
+
+    signal.connect([&calls](int value) { calls.push_back(value); });
+    signal.connect([&calls](int value) { calls.push_back(value * 10); });
+
+    signal(3);
+
+    std::vector<int> const expected = {3, 30};
+    ASSERT_EQ(expected, calls);
+    ASSERT_EQ(2U, signal.num_slots());
+}
+
+TEST(single_threaded_signal_test, disconnected_slots_are_not_called)
+{
+    signal_type signal;
+    std::vector<int> calls;
+
+    auto const connection =
+        signal.connect([&calls](int value) { calls.push_back(value); });
+    signal.connect([&calls](int value) { calls.push_back(value * 10); });
+
+    ASSERT_TRUE(connection.connected());
+    connection.disconnect();
+    ASSERT_FALSE(connection.connected());
+
+    signal(2);
+
+    std::vector<int> const expected = {20};
+    ASSERT_EQ(expected, calls);
+    ASSERT_EQ(1U, signal.num_slots());
+}
+
+TEST(single_threaded_signal_test, slot_can_disconnect_itself_during_emission)
+{
+    signal_type signal;
+    signal_type::connection connection;
+    int calls = 0;
+
+    connection = signal.connect([&](int) {
+        ++calls;
+        connection.disconnect();
+    });
+
+    signal(0);
+    signal(0);
+
+    ASSERT_EQ(1, calls);
+    ASSERT_TRUE(signal.empty());
+}
+
+TEST(
+    single_threaded_signal_test,
+    slots_connected_during_emission_are_called_from_the_next_emission)
+{
+    signal_type signal;
+    std::vector<int> calls;
+
+    signal.connect([&](int value) {
+        calls.push_back(value);
+        signal.connect([&calls](int value) { calls.push_back(value * 10); });
+    });
+
+    signal(1);
+    signal(2);
+
+    std::vector<int> const expected = {1, 2, 20};
+    ASSERT_EQ(expected, calls);
+}
+
+TEST(
+    single_threaded_signal_test,
+    slots_that_cannot_be_connected_after_a_throwing_slot_stay_pending)
+{
+    signal_type signal;
+    std::vector<int> calls;
+
+    signal.connect([&](int value) {
+        calls.push_back(value);
+
+        if (value == 1)
+        {
+            signal.connect(
+                [&calls](int value) { calls.push_back(value * 10); });
+
+            // The pending slot cannot now be connected when the emission
+            // ends, which happens as this exception is unwound.
+            allocation_counter::fail_allocations(true);
+            throw value;
+        }
+    });
+
+    bool thrown = false;
+
+    try
+    {
+        signal(1);
+    }
+    catch (int)
+    {
+        thrown = true;
+    }
+
+    allocation_counter::fail_allocations(false);
+
+    ASSERT_TRUE(thrown);
+    ASSERT_EQ(std::size_t{2}, signal.num_slots());
+
+    signal(2);
+
+    std::vector<int> const expected = {1, 2, 20};
+    ASSERT_EQ(expected, calls);
+}
+
+TEST(single_threaded_signal_test, disconnect_all_slots_removes_every_slot)
+{
+    signal_type signal;
+    int calls = 0;
+
+    auto const connection = signal.connect([&calls](int) { ++calls; });
+    signal.connect([&calls](int) { ++calls; });
+
+    signal.disconnect_all_slots();
+    signal(0);
+
+    ASSERT_EQ(0, calls);
+    ASSERT_TRUE(signal.empty());
+    ASSERT_FALSE(connection.connected());
+}